@@ -99,6 +99,28 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
 
+/**
+ * @brief Send a number of messages to a thread in one go.
+ *
+ * The messages in @p m are delivered in order under a single critical
+ * section: the first one directly, if the target thread is waiting for a
+ * message, the rest to the target's message queue. At most one context switch
+ * happens afterwards. If not a single message can be delivered this function
+ * blocks on the first message like msg_send() does (unless called from an
+ * interrupt or with @p target_pid being the current thread).
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  Number of messages delivered, starting with m[0]. Call again with
+ *          the rest, if this is less than @p num.
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned int num, kernel_pid_t target_pid);
+
+
 /**
  * @brief Send a message to the current thread.
  * @details Will work only if the thread has a message queue.
@@ -176,6 +198,22 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a number of messages in one go.
+ *
+ * Takes up to @p num messages from the thread's message queue and from
+ * blocked senders under a single critical section. Unblocked senders are
+ * scheduled with at most one context switch. This function blocks until at
+ * least one message was received.
+ *
+ * @param[out] m    Array of @p num preallocated ``msg_t`` structures, must not
+ *                  be NULL.
+ * @param[in] num   Maximum number of messages to receive.
+ *
+ * @return  Number of messages received (at least 1 if @p num > 0).
+ */
+int msg_receive_bulk(msg_t *m, unsigned int num);
+
 /**
  * @brief Send a message, block until reply received.
  *
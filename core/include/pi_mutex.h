@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_sync
+ * @{
+ *
+ * @file
+ * @brief       Mutex with priority inheritance
+ *
+ * @details     A thread holding a pi_mutex_t runs with the priority of the
+ *              highest priority thread waiting for it, so it can not be
+ *              preempted by threads of medium priority (priority inversion).
+ *              On unlock the mutex is handed directly to the highest priority
+ *              waiter, which does not have to contend for it again.
+ *              Waiters are kept in one list per priority with a bitcache
+ *              of non-empty lists like the scheduler's runqueues, so locking
+ *              and unlocking are O(1) in the number of waiters.
+ *
+ * @note        Threads must unlock pi_mutex_t's in the reverse order of
+ *              locking them.
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef PI_MUTEX_H_
+#define PI_MUTEX_H_
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "sched.h"
+#include "tcb.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief Mutex structure with priority inheritance. Must never be modified by
+ *        the user.
+ */
+typedef struct pi_mutex_t {
+    /**
+     * @brief   The thread holding the mutex, NULL if unlocked.
+     * @internal
+     */
+    tcb_t *owner;
+    /**
+     * @brief   Next mutex held by pi_mutex_t::owner.
+     * @internal
+     */
+    struct pi_mutex_t *next_held;
+    /**
+     * @brief   Priority of pi_mutex_t::owner without inheritance.
+     * @internal
+     */
+    uint16_t base_priority;
+    /**
+     * @brief   Bit n is set if pi_mutex_t::waiters[n] is not empty.
+     * @internal
+     */
+    uint32_t waiters_bitcache;
+    /**
+     * @brief   Waiting threads (by tcb_t::rq_entry) per priority.
+     * @internal
+     */
+    clist_node_t *waiters[SCHED_PRIO_LEVELS];
+} pi_mutex_t;
+
+/**
+ * @brief Static initializer for pi_mutex_t.
+ */
+#define PI_MUTEX_INIT { NULL, NULL, 0, 0, { NULL } }
+
+/**
+ * @brief Initializes a mutex object.
+ * @details For initialization of variables use PI_MUTEX_INIT instead.
+ * @param[out] mutex    pre-allocated mutex structure, must not be NULL.
+ */
+static inline void pi_mutex_init(pi_mutex_t *mutex)
+{
+    pi_mutex_t empty_mutex = PI_MUTEX_INIT;
+    *mutex = empty_mutex;
+}
+
+/**
+ * @brief Tries to get a mutex, non-blocking.
+ * @param[in] mutex Mutex object to lock. Has to be initialized first. Must not
+ *                  be NULL.
+ * @return 1 if mutex was unlocked, now it is locked.
+ * @return 0 if the mutex was locked.
+ */
+int pi_mutex_trylock(pi_mutex_t *mutex);
+
+/**
+ * @brief Locks a mutex, blocking.
+ * @details If the mutex is locked, its owner (and the owner of a mutex the
+ *          owner is waiting for, etc.) inherits the current thread's priority
+ *          until it unlocks the mutex.
+ * @param[in] mutex Mutex object to lock. Has to be initialized first. Must not
+ *                  be NULL.
+ */
+void pi_mutex_lock(pi_mutex_t *mutex);
+
+/**
+ * @brief Unlocks the mutex.
+ * @details Ownership is handed to the highest priority waiter, if there is
+ *          one. The current thread drops inherited priority.
+ * @param[in] mutex Mutex object to unlock, must not be NULL. Must be locked by
+ *                  the current thread.
+ */
+void pi_mutex_unlock(pi_mutex_t *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PI_MUTEX_H_ */
+/** @} */
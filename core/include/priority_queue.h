@@ -13,6 +13,11 @@
  * @file
  * @brief       A simple priority queue
  *
+ * @details     The queue is a pairing heap of intrusive nodes: adding a node
+ *              is O(1), removing the head or any other node is amortized
+ *              O(log n). Nodes of equal priority are removed in the order
+ *              they were added.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
 
@@ -30,22 +35,32 @@
  * @brief data type for priority queue nodes
  */
 typedef struct priority_queue_node_t {
-    struct priority_queue_node_t *next; /**< next queue node */
+    struct priority_queue_node_t *next; /**< next sibling in the heap */
     uint32_t priority;                  /**< queue node priority */
     unsigned int data;                  /**< queue node data */
+    struct priority_queue_node_t *child; /**< first child in the heap */
+    struct priority_queue_node_t *prev; /**< previous sibling, or parent of
+                                             the first child. NULL if the
+                                             node is the head or in no
+                                             queue */
+    uint32_t seq;                       /**< insertion order, to keep nodes
+                                             of equal priority in FIFO
+                                             order */
 } priority_queue_node_t;
 
 /**
  * @brief data type for priority queues
  */
 typedef struct queue {
-    priority_queue_node_t *first;        /**< first queue node */
+    priority_queue_node_t *first;        /**< first queue node, i.e. the
+                                              node with the lowest priority
+                                              value */
 } priority_queue_t;
 
 /**
  * @brief Static initializer for priority_queue_node_t.
  */
-#define PRIORITY_QUEUE_NODE_INIT { NULL, 0, 0 }
+#define PRIORITY_QUEUE_NODE_INIT { NULL, 0, 0, NULL, NULL, 0 }
 
 /**
  * @brief   Initialize a priority queue node object.
@@ -104,6 +119,10 @@ void priority_queue_add(priority_queue_t *root, priority_queue_node_t *new_obj);
 /**
  * @brief remove `node` from `root`
  *
+ * @details
+ * Nothing happens if `node` is in no queue. `node` must either be in `root`
+ * or in no queue, and must have been initialized or added to a queue before.
+ *
  * @param[in,out]   root    the priority queue's root
  * @param[in]       node    the node to remove
  */
@@ -122,7 +141,7 @@ void priority_queue_print(priority_queue_t *root);
  *
  * @note requires ::ENABLE_DEBUG to be set to 1 for this file
  */
-void priority_queue_print_node(priority_queue_t *root);
+void priority_queue_print_node(priority_queue_node_t *node);
 #endif
 
 #ifdef __cplusplus
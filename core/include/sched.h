@@ -114,6 +114,19 @@ int sched_run(void);
  */
 void sched_set_status(tcb_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of the specified process
+ *
+ * @details Moves the process to the runqueue of @p priority if it is on a
+ *          runqueue. Does not yield, call sched_switch() if needed. Must be
+ *          called with interrupts disabled.
+ *
+ * @param[in]   process     Pointer to the thread control block of the
+ *                          targeted process
+ * @param[in]   priority    The new priority of this thread
+ */
+void sched_change_priority(tcb_t *process, uint16_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -40,6 +40,17 @@
 #include <auto_init.h>
 #endif
 
+/**
+ * @brief   Deepest power mode the idle thread enters when nothing sets
+ *          `lpm_prevent_sleep`
+ *
+ * Platforms can override this in cpu_conf.h with a mode that keeps all their
+ * wakeup sources running.
+ */
+#ifndef LPM_IDLE_DEEPEST
+#define LPM_IDLE_DEEPEST    (LPM_IDLE)
+#endif
+
 volatile int lpm_prevent_sleep = 0;
 
 extern int main(void);
@@ -64,9 +75,7 @@ static void *idle_thread(void *arg)
             lpm_set(LPM_IDLE);
         }
         else {
-            lpm_set(LPM_IDLE);
-            /* lpm_set(LPM_SLEEP); */
-            /* lpm_set(LPM_POWERDOWN); */
+            lpm_set(LPM_IDLE_DEEPEST);
         }
     }
 
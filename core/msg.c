@@ -166,6 +166,72 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
     return 1;
 }
 
+int msg_send_bulk(msg_t *m, unsigned int num, kernel_pid_t target_pid)
+{
+    if (num == 0) {
+        return 0;
+    }
+
+#if DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = disableIRQ();
+    tcb_t *target = (tcb_t *) sched_threads[target_pid];
+    kernel_pid_t sender_pid = inISR() ? KERNEL_PID_ISR : sched_active_pid;
+    bool to_self = (target == sched_active_thread);
+    bool woken = false;
+    unsigned int n = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        restoreIRQ(state);
+        return -1;
+    }
+
+    if (target->status == STATUS_RECEIVE_BLOCKED) {
+        DEBUG("msg_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        msg_t *target_message = (msg_t*) target->wait_data;
+        m[0].sender_pid = sender_pid;
+        *target_message = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        woken = true;
+        n++;
+    }
+
+    for (; n < num; n++) {
+        m[n].sender_pid = sender_pid;
+
+        if (!queue_msg(target, &m[n])) {
+            break;
+        }
+    }
+
+    DEBUG("msg_send_bulk: delivered %u of %u messages to %" PRIkernel_pid "\n",
+          n, num, target_pid);
+
+    if ((n == 0) && !inISR() && !to_self) {
+        /* neither waiting nor room in queue: block like msg_send() */
+        return _msg_send(m, target_pid, true, state);
+    }
+
+    restoreIRQ(state);
+
+    if (woken) {
+        if (inISR()) {
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+
+    return n;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = disableIRQ();
@@ -368,6 +434,63 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_bulk(msg_t *m, unsigned int num)
+{
+    if (num == 0) {
+        return 0;
+    }
+
+    unsigned state = disableIRQ();
+    tcb_t *me = (tcb_t*) sched_threads[sched_active_pid];
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned int n = 0;
+
+    if (me->msg_array) {
+        int queue_index;
+
+        while ((n < num) && ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+            m[n++] = me->msg_array[queue_index];
+        }
+    }
+
+    while (n < num) {
+        priority_queue_node_t *node = priority_queue_remove_head(&(me->msg_waiters));
+
+        if (node == NULL) {
+            break;
+        }
+
+        tcb_t *sender = (tcb_t*) node->data;
+        m[n++] = *((msg_t*) sender->wait_data);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    restoreIRQ(state);
+
+    if (n == 0) {
+        DEBUG("msg_receive_bulk: %" PRIkernel_pid ": nothing queued, blocking\n",
+              sched_active_thread->pid);
+        return _msg_receive(m, 1);
+    }
+
+    DEBUG("msg_receive_bulk: %" PRIkernel_pid ": received %u messages\n",
+          sched_active_thread->pid, n);
+
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+
+    return n;
+}
+
 int msg_init_queue(msg_t *array, int num)
 {
     /* check if num is a power of two by comparing to its complement */
@@ -64,6 +64,8 @@ static void mutex_wait(struct mutex_t *mutex)
         return;
     }
 
+    /* not waiting for a pi_mutex_t (see pi_mutex.c) */
+    sched_active_thread->wait_data = NULL;
     sched_set_status((tcb_t*) sched_active_thread, STATUS_MUTEX_BLOCKED);
 
     priority_queue_node_t n;
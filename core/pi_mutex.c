@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_sync
+ * @{
+ *
+ * @file
+ * @brief       Kernel mutex implementation with priority inheritance
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <inttypes.h>
+
+#include "pi_mutex.h"
+#include "bitarithm.h"
+#include "clist.h"
+#include "irq.h"
+#include "kernel.h"
+#include "sched.h"
+#include "tcb.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* mutexes held by each thread, most recently locked first */
+static pi_mutex_t *_held[KERNEL_PID_LAST + 1];
+
+static void _waiter_add(pi_mutex_t *mutex, tcb_t *thread)
+{
+    /* thread is not on a runqueue, so tcb_t::rq_entry is free to use */
+    clist_add(&mutex->waiters[thread->priority], &thread->rq_entry);
+    mutex->waiters_bitcache |= 1 << thread->priority;
+}
+
+static void _waiter_remove(pi_mutex_t *mutex, tcb_t *thread)
+{
+    clist_remove(&mutex->waiters[thread->priority], &thread->rq_entry);
+
+    if (mutex->waiters[thread->priority] == NULL) {
+        mutex->waiters_bitcache &= ~(1 << thread->priority);
+    }
+}
+
+static inline uint16_t _top_priority(const pi_mutex_t *mutex)
+{
+    return (mutex->waiters_bitcache) ? bitarithm_lsb(mutex->waiters_bitcache)
+                                     : THREAD_PRIORITY_IDLE;
+}
+
+static void _take(pi_mutex_t *mutex, tcb_t *thread)
+{
+    pi_mutex_t *held = _held[thread->pid];
+
+    mutex->owner = thread;
+    mutex->base_priority = (held) ? held->base_priority : thread->priority;
+    mutex->next_held = held;
+    _held[thread->pid] = mutex;
+}
+
+/* raises priority of thread and, if it is waiting for a mutex itself, of all
+ * further owners down the chain */
+static void _inherit(tcb_t *thread, uint16_t priority)
+{
+    while (thread->priority > priority) {
+        pi_mutex_t *waiting_for = NULL;
+
+        if (thread->status == STATUS_MUTEX_BLOCKED) {
+            waiting_for = (pi_mutex_t *) thread->wait_data;
+        }
+
+        DEBUG("pi_mutex: %" PRIkernel_pid " inherits priority %" PRIu16 "\n",
+              thread->pid, priority);
+
+        if (waiting_for == NULL) {
+            sched_change_priority(thread, priority);
+            return;
+        }
+
+        _waiter_remove(waiting_for, thread);
+        thread->priority = priority;
+        _waiter_add(waiting_for, thread);
+        thread = waiting_for->owner;
+    }
+}
+
+int pi_mutex_trylock(pi_mutex_t *mutex)
+{
+    unsigned irqstate = disableIRQ();
+    int res = 0;
+
+    if (mutex->owner == NULL) {
+        _take(mutex, (tcb_t *) sched_active_thread);
+        res = 1;
+    }
+
+    restoreIRQ(irqstate);
+
+    return res;
+}
+
+void pi_mutex_lock(pi_mutex_t *mutex)
+{
+    unsigned irqstate = disableIRQ();
+    tcb_t *me = (tcb_t *) sched_active_thread;
+
+    if (mutex->owner == NULL) {
+        _take(mutex, me);
+        restoreIRQ(irqstate);
+        return;
+    }
+
+    DEBUG("pi_mutex: %" PRIkernel_pid " waits for %" PRIkernel_pid "\n",
+          me->pid, mutex->owner->pid);
+
+    me->wait_data = mutex;
+    sched_set_status(me, STATUS_MUTEX_BLOCKED);
+    _waiter_add(mutex, me);
+    _inherit(mutex->owner, me->priority);
+
+    restoreIRQ(irqstate);
+    thread_yield_higher();
+
+    /* the unlocking thread handed the mutex over to us */
+}
+
+void pi_mutex_unlock(pi_mutex_t *mutex)
+{
+    unsigned irqstate = disableIRQ();
+    tcb_t *me = (tcb_t *) sched_active_thread;
+    uint16_t priority = mutex->base_priority;
+    uint16_t next_priority = THREAD_PRIORITY_IDLE;
+    pi_mutex_t **link;
+
+    if (mutex->owner != me) {
+        DEBUG("pi_mutex: %" PRIkernel_pid " does not hold mutex\n", me->pid);
+        restoreIRQ(irqstate);
+        return;
+    }
+
+    /* mutexes may be unlocked in any order */
+    link = &_held[me->pid];
+
+    while (*link != mutex) {
+        link = &(*link)->next_held;
+    }
+
+    *link = mutex->next_held;
+
+    if (mutex->waiters_bitcache) {
+        tcb_t *next = clist_get_container(mutex->waiters[_top_priority(mutex)],
+                                          tcb_t, rq_entry);
+
+        DEBUG("pi_mutex: hand over to %" PRIkernel_pid "\n", next->pid);
+        _waiter_remove(mutex, next);
+        next->wait_data = NULL;
+        _take(mutex, next);
+
+        /* next inherits from the remaining waiters */
+        if (_top_priority(mutex) < next->priority) {
+            next->priority = _top_priority(mutex);
+        }
+
+        sched_set_status(next, STATUS_PENDING);
+        next_priority = next->priority;
+    }
+    else {
+        mutex->owner = NULL;
+    }
+
+    /* drop priority inherited by this mutex, but keep what other mutexes
+     * still held give us */
+    for (pi_mutex_t *held = _held[me->pid]; held != NULL; held = held->next_held) {
+        if (_top_priority(held) < priority) {
+            priority = _top_priority(held);
+        }
+    }
+
+    if (priority != me->priority) {
+        sched_change_priority(me, priority);
+    }
+
+    restoreIRQ(irqstate);
+
+    if (next_priority < THREAD_PRIORITY_IDLE) {
+        sched_switch(next_priority);
+    }
+}
@@ -24,62 +24,169 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-void priority_queue_remove(priority_queue_t *root_, priority_queue_node_t *node)
+/* insertion counter, wraps around */
+static uint32_t _seq = 0;
+
+static inline int _before(const priority_queue_node_t *a,
+                          const priority_queue_node_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/**
+ * @brief   link two heaps, the one with the larger head becomes the first
+ *          child of the other
+ *
+ * @return  the head of the linked heap
+ */
+static priority_queue_node_t *_link(priority_queue_node_t *a,
+                                    priority_queue_node_t *b)
+{
+    if (_before(b, a)) {
+        priority_queue_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+
+    return a;
+}
+
+/**
+ * @brief   link the sibling list starting at `first` to one heap, pairing
+ *          the siblings from left to right and linking the pairs from right
+ *          to left
+ *
+ * @return  the head of the new heap
+ */
+static priority_queue_node_t *_merge_pairs(priority_queue_node_t *first)
 {
-    /* The strict aliasing rules allow this assignment. */
-    priority_queue_node_t *root = (priority_queue_node_t *) root_;
-
-    while (root->next != NULL) {
-        if (root->next == node) {
-            root->next = node->next;
-            node->next = NULL;
-            return;
+    priority_queue_node_t *pairs = NULL;
+    priority_queue_node_t *head = NULL;
+
+    while (first) {
+        priority_queue_node_t *a = first;
+        priority_queue_node_t *b = a->next;
+
+        if (b) {
+            first = b->next;
+            b->next = NULL;
+            b->prev = NULL;
         }
+        else {
+            first = NULL;
+        }
+        a->next = NULL;
+        a->prev = NULL;
+
+        if (b) {
+            a = _link(a, b);
+        }
+
+        /* stack pairs, so they are popped right to left */
+        a->next = pairs;
+        pairs = a;
+    }
+
+    while (pairs) {
+        priority_queue_node_t *pair = pairs;
+
+        pairs = pair->next;
+        pair->next = NULL;
+        head = (head) ? _link(head, pair) : pair;
+    }
+
+    return head;
+}
+
+static inline void _reset(priority_queue_node_t *node)
+{
+    node->next = NULL;
+    node->child = NULL;
+    node->prev = NULL;
+}
+
+void priority_queue_remove(priority_queue_t *root, priority_queue_node_t *node)
+{
+    priority_queue_node_t *sub;
+
+    if (root->first == node) {
+        priority_queue_remove_head(root);
+        return;
+    }
+
+    if (node->prev == NULL) {
+        /* not in a queue */
+        return;
+    }
+
+    /* cut the node's subtree out of the heap */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+    else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
 
-        root = root->next;
+    /* and link its children back in */
+    sub = _merge_pairs(node->child);
+    if (sub) {
+        root->first = _link(root->first, sub);
     }
+
+    _reset(node);
 }
 
 priority_queue_node_t *priority_queue_remove_head(priority_queue_t *root)
 {
     priority_queue_node_t *head = root->first;
     if (head) {
-        root->first = head->next;
+        root->first = _merge_pairs(head->child);
+        _reset(head);
     }
     return head;
 }
 
 void priority_queue_add(priority_queue_t *root, priority_queue_node_t *new_obj)
 {
-    /* The strict aliasing rules allow this assignment. */
-    priority_queue_node_t *node = (priority_queue_node_t *) root;
-
-    while (node->next != NULL) {
-        if (node->next->priority > new_obj->priority) {
-            new_obj->next = node->next;
-            node->next = new_obj;
-            return;
-        }
-
-        node = node->next;
-    }
+    _reset(new_obj);
+    new_obj->seq = _seq++;
 
-    node->next = new_obj;
-    new_obj->next = NULL;
+    root->first = (root->first) ? _link(root->first, new_obj) : new_obj;
 }
 
 #if ENABLE_DEBUG
+static void _print(priority_queue_node_t *node)
+{
+    for (; node; node = node->next) {
+        printf("Data: %u Priority: %lu\n", node->data, (unsigned long) node->priority);
+        _print(node->child);
+    }
+}
+
 void priority_queue_print(priority_queue_t *root)
 {
     printf("queue:\n");
 
-    for (priority_queue_node_t *node = root->first; node; node = node->next) {
-        printf("Data: %u Priority: %lu\n", node->data, (unsigned long) node->priority);
-    }
+    _print(root->first);
 }
 
 void priority_queue_print_node(priority_queue_node_t *node)
 {
-    printf("Data: %u Priority: %lu Next: %u\n", (unsigned int) node->data, (unsigned long) node->priority, (unsigned int)node->next);
+    printf("Data: %u Priority: %lu Next: %p Child: %p\n", (unsigned int) node->data,
+           (unsigned long) node->priority, (void *)node->next, (void *)node->child);
 }
 #endif
@@ -154,6 +154,24 @@ void sched_set_status(tcb_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_change_priority(tcb_t *process, uint16_t priority)
+{
+    if (process->status >= STATUS_ON_RUNQUEUE) {
+        DEBUG("sched_change_priority: moving thread %" PRIkernel_pid " from runqueue %"
+              PRIu16 " to %" PRIu16 ".\n", process->pid, process->priority, priority);
+        clist_remove(&sched_runqueues[process->priority], &(process->rq_entry));
+
+        if (!sched_runqueues[process->priority]) {
+            runqueue_bitcache &= ~(1 << process->priority);
+        }
+
+        clist_add(&sched_runqueues[priority], &(process->rq_entry));
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    process->priority = priority;
+}
+
 void sched_switch(uint16_t other_prio)
 {
     tcb_t *active_thread = (tcb_t *) sched_active_thread;
@@ -84,6 +84,12 @@ extern "C" {
 #define CPUID_ID_LEN                    (4)
 #endif
 
+/**
+ * @brief   Let the idle thread use LPM_SLEEP, which blocks the process just
+ *          like LPM_IDLE
+ */
+#define LPM_IDLE_DEEPEST                (LPM_SLEEP)
+
 #ifdef __cplusplus
 }
 #endif
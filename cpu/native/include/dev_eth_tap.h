@@ -29,6 +29,14 @@ extern "C" {
 
 #include "net/if.h"
 
+/**
+ * @brief Maximum number of frames read per wakeup before the remaining ones
+ *        are deferred to another wakeup, so other threads are not starved
+ */
+#ifndef DEV_ETH_TAP_RX_BATCH
+#define DEV_ETH_TAP_RX_BATCH    (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -38,6 +46,7 @@ typedef struct dev_eth_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[NG_ETHERNET_ADDR_LEN]; /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint8_t rx_more;                    /**< Frames may be left to read */
 } dev_eth_tap_t;
 
 /**
@@ -47,6 +47,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 #include "kernel_types.h"
 
@@ -78,6 +79,7 @@ void _native_init_syscalls(void);
  */
 extern ssize_t (*real_read)(int fd, void *buf, size_t count);
 extern ssize_t (*real_write)(int fd, const void *buf, size_t count);
+extern ssize_t (*real_writev)(int fd, const struct iovec *iov, int iovcnt);
 extern size_t (*real_fread)(void *ptr, size_t size, size_t nmemb, FILE *stream);
 extern void (*real_clearerr)(FILE *stream);
 extern __attribute__((noreturn)) void (*real_exit)(int status);
@@ -160,6 +162,7 @@ extern fd_set _native_rfds;
 
 ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
+ssize_t _native_writev(int fd, const struct iovec *iov, int iovcnt);
 
 /**
  * register interrupt handler handler for interrupt sig
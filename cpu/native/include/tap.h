@@ -25,6 +25,14 @@
 extern "C" {
 #endif
 
+/**
+ * maximum number of frames handled per SIGIO, the remaining ones are
+ * deferred to another signal so other threads are not starved
+ */
+#ifndef NATIVE_TAP_RX_BATCH
+#define NATIVE_TAP_RX_BATCH (16U)
+#endif
+
 /**
  * create and/or open tap device "name"
  *
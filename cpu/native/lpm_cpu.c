@@ -93,7 +93,7 @@ void _native_lpm_sleep(void)
 }
 
 /**
- * LPM_IDLE uses sleep() to wait for interrupts
+ * LPM_IDLE and LPM_SLEEP use sleep() to wait for interrupts
  * LPM_OFF exits process
  * other modes not supported at the moment
  */
@@ -117,12 +117,12 @@ enum lpm_mode lpm_set(enum lpm_mode target)
             _native_lpm_sleep();
             break;
 
-        /* XXX: unfinished modes: */
+        /* the process cannot sleep any deeper than it does in LPM_IDLE */
         case LPM_SLEEP:
-            /*TODO: implement*/
-            printf("XXX: lpm_set(): LPM_SLEEP not implemented\n");
-            //sigsuspend();
+            _native_lpm_sleep();
+            break;
 
+        /* XXX: unfinished modes: */
         case LPM_POWERDOWN:
             /*TODO: implement*/
             printf("XXX: lpm_set(): LPM_POWERDOWN not implemented\n");
@@ -67,17 +67,13 @@ unsigned char _native_tap_mac[ETHER_ADDR_LEN];
 pid_t sigio_child_pid;
 #endif
 
-void _native_handle_tap_input(void)
+/* read and handle one frame, returns <= 0 if there was none */
+static int _native_tap_read(void)
 {
     int nread;
     union eth_frame frame;
     radio_packet_t p;
 
-    DEBUG("_native_handle_tap_input\n");
-
-    /* TODO: check whether this is an input or an output event
-       TODO: refactor this into general io-signal multiplexer */
-
     nread = real_read(_native_tap_fd, &frame, sizeof(union eth_frame));
     DEBUG("_native_handle_tap_input - read %d bytes\n", nread);
 
@@ -115,31 +111,7 @@ void _native_handle_tap_input(void)
             DEBUG("ignoring non-native frame\n");
         }
 
-        /* work around lost signals */
-        fd_set rfds;
-        struct timeval t;
-        memset(&t, 0, sizeof(t));
-        FD_ZERO(&rfds);
-        FD_SET(_native_tap_fd, &rfds);
-
-        _native_in_syscall++; // no switching here
-
-        if (real_select(_native_tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-            int sig = SIGIO;
-            extern int _sig_pipefd[2];
-            extern ssize_t (*real_write)(int fd, const void *buf, size_t count);
-            real_write(_sig_pipefd[1], &sig, sizeof(int));
-            _native_sigpend++;
-            DEBUG("_native_handle_tap_input: sigpend++\n");
-        }
-        else {
-            DEBUG("_native_handle_tap_input: no more pending tap data\n");
-#ifdef __MACH__
-            kill(sigio_child_pid, SIGCONT);
-#endif
-        }
-
-        _native_in_syscall--;
+        return 1;
     }
     else if (nread == -1) {
         if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
@@ -155,6 +127,43 @@ void _native_handle_tap_input(void)
     else {
         errx(EXIT_FAILURE, "internal error _native_handle_tap_input");
     }
+
+    return 0;
+}
+
+void _native_handle_tap_input(void)
+{
+    unsigned frames = 0;
+    int more = 1;
+
+    DEBUG("_native_handle_tap_input\n");
+
+    /* TODO: check whether this is an input or an output event
+       TODO: refactor this into general io-signal multiplexer */
+
+    /* drain all pending frames, so one SIGIO serves a whole burst */
+    while (more && (frames++ < NATIVE_TAP_RX_BATCH)) {
+        more = _native_tap_read();
+    }
+
+    if (more) {
+        /* come back for the rest after other threads had their turn */
+        int sig = SIGIO;
+        extern int _sig_pipefd[2];
+        extern ssize_t (*real_write)(int fd, const void *buf, size_t count);
+
+        _native_in_syscall++; // no switching here
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+        DEBUG("_native_handle_tap_input: sigpend++\n");
+        _native_in_syscall--;
+    }
+    else {
+        DEBUG("_native_handle_tap_input: no more pending tap data\n");
+#ifdef __MACH__
+        kill(sigio_child_pid, SIGCONT);
+#endif
+    }
 }
 
 #ifdef __MACH__
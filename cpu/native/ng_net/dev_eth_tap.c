@@ -58,6 +58,8 @@ dev_eth_tap_t dev_eth_tap;
 /* dev_eth interface */
 static int _init(dev_eth_t *ethdev);
 static int _send(dev_eth_t *ethdev, char* buf, int n);
+static int _send_vec(dev_eth_t *ethdev, const ng_netdev_iovec_t *vector,
+                     int count);
 static int _recv(dev_eth_t *ethdev, char* buf, int n);
 
 static inline void _get_mac_addr(dev_eth_t *ethdev, uint8_t *dst) {
@@ -76,8 +78,39 @@ static inline int _set_promiscous(dev_eth_t *ethdev, int value) {
     return value;
 }
 
-static inline void _isr(dev_eth_t *ethdev) {
-    dev_eth_rx_handler(ethdev);
+static void _trigger_sigio(void) {
+    int sig = SIGIO;
+    extern int _sig_pipefd[2];
+    extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
+
+    _native_in_syscall++; /* no switching here */
+    real_write(_sig_pipefd[1], &sig, sizeof(int));
+    _native_sigpend++;
+    DEBUG("dev_eth_tap: sigpend++\n");
+    _native_in_syscall--;
+}
+
+static void _isr(dev_eth_t *ethdev) {
+    dev_eth_tap_t *dev = (dev_eth_tap_t*)ethdev;
+    unsigned frames = 0;
+
+    /* drain all pending frames, so one SIGIO serves a whole burst and no
+     * frame is left behind when signals coalesce */
+    dev->rx_more = 1;
+
+    while (dev->rx_more && (frames++ < DEV_ETH_TAP_RX_BATCH)) {
+        dev_eth_rx_handler(ethdev);
+    }
+
+    if (dev->rx_more) {
+        /* come back for the rest after other threads had their turn */
+        _trigger_sigio();
+    }
+    else {
+#ifdef __MACH__
+        kill(_sigio_child_pid, SIGCONT);
+#endif
+    }
 }
 
 static eth_driver_t eth_driver_tap = {
@@ -88,6 +121,7 @@ static eth_driver_t eth_driver_tap = {
     .get_promiscous = _get_promiscous,
     .set_promiscous = _set_promiscous,
     .isr = _isr,
+    .send_vec = _send_vec,
 };
 
 /* driver implementation */
@@ -118,39 +152,16 @@ static int _recv(dev_eth_t *dev_eth, char *buf, int len) {
                   "That's not me => Dropped\n",
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-#ifdef __MACH__
-            kill(_sigio_child_pid, SIGCONT);
-#endif
             return 0;
         }
-        /* work around lost signals */
-        fd_set rfds;
-        struct timeval t;
-        memset(&t, 0, sizeof(t));
-        FD_ZERO(&rfds);
-        FD_SET(dev->tap_fd, &rfds);
-
-        _native_in_syscall++; /* no switching here */
-
-        if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-            int sig = SIGIO;
-            extern int _sig_pipefd[2];
-            extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-            real_write(_sig_pipefd[1], &sig, sizeof(int));
-            _native_sigpend++;
-            DEBUG("dev_eth_tap: sigpend++\n");
-        }
-        else {
-#ifdef __MACH__
-        kill(_sigio_child_pid, SIGCONT);
-#endif
-        }
-
-        _native_in_syscall--;
 
         return nread;
     }
-    else if (nread == -1) {
+
+    /* nothing left to read */
+    dev->rx_more = 0;
+
+    if (nread == -1) {
         if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
         }
         else {
@@ -172,6 +183,19 @@ static int _send(dev_eth_t *ethdev, char* buf, int n) {
     return _native_write(dev->tap_fd, buf, n);
 }
 
+static int _send_vec(dev_eth_t *ethdev, const ng_netdev_iovec_t *vector,
+                     int count) {
+    dev_eth_tap_t *dev = (dev_eth_tap_t*)ethdev;
+    struct iovec iov[count];
+
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = vector[i].iov_base;
+        iov[i].iov_len = vector[i].iov_len;
+    }
+
+    return _native_writev(dev->tap_fd, iov, count);
+}
+
 void dev_eth_tap_setup(dev_eth_tap_t *dev, const char *name) {
     dev->ethdev.driver = &eth_driver_tap;
     strncpy(dev->tap_name, name, IFNAMSIZ);
@@ -51,6 +51,7 @@
 
 ssize_t (*real_read)(int fd, void *buf, size_t count);
 ssize_t (*real_write)(int fd, const void *buf, size_t count);
+ssize_t (*real_writev)(int fd, const struct iovec *iov, int iovcnt);
 size_t (*real_fread)(void *ptr, size_t size, size_t nmemb, FILE *stream);
 void (*real_clearerr)(FILE *stream);
 __attribute__((noreturn)) void (*real_exit)(int status);
@@ -209,6 +210,17 @@ ssize_t _native_write(int fd, const void *buf, size_t count)
     return r;
 }
 
+ssize_t _native_writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    ssize_t r;
+
+    _native_syscall_enter();
+    r = real_writev(fd, iov, iovcnt);
+    _native_syscall_leave();
+
+    return r;
+}
+
 #if defined(__FreeBSD__)
 #undef putchar
 #endif
@@ -385,6 +397,7 @@ void _native_init_syscalls(void)
 {
     *(void **)(&real_read) = dlsym(RTLD_NEXT, "read");
     *(void **)(&real_write) = dlsym(RTLD_NEXT, "write");
+    *(void **)(&real_writev) = dlsym(RTLD_NEXT, "writev");
     *(void **)(&real_malloc) = dlsym(RTLD_NEXT, "malloc");
     *(void **)(&real_calloc) = dlsym(RTLD_NEXT, "calloc");
     *(void **)(&real_realloc) = dlsym(RTLD_NEXT, "realloc");
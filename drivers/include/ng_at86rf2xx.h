@@ -406,6 +406,17 @@ size_t ng_at86rf2xx_tx_load(ng_at86rf2xx_t *dev, uint8_t *data, size_t len,
  */
 void ng_at86rf2xx_tx_exec(ng_at86rf2xx_t *dev);
 
+/**
+ * @brief   Trigger sending of the frame in the transmit buffer without
+ *          updating its length field
+ *
+ * Use this if the frame including its PHR was written to the frame buffer
+ * in one go.
+ *
+ * @param[in] dev           device to trigger
+ */
+void ng_at86rf2xx_tx_start(ng_at86rf2xx_t *dev);
+
 /**
  * @brief   Read the length of a received packet
  *
@@ -77,6 +77,49 @@ void ng_at86rf2xx_sram_write(const ng_at86rf2xx_t *dev,
                              const uint8_t *data,
                              const size_t len);
 
+/**
+ * @brief   Frame buffer read access appends the energy detection level and
+ *          the RX status after the LQI
+ *
+ * The AT86RF231 and AT86RF232 only append the LQI, their ED level has to be
+ * read from the PHY_ED_LEVEL register.
+ */
+#if defined(MODULE_NG_AT86RF233) || defined(MODULE_NG_AT86RF212B)
+#define NG_AT86RF2XX_FB_HAS_ED          (1)
+#endif
+
+/**
+ * @brief   Start a frame buffer access transaction
+ *
+ * Acquires the SPI bus and sends the frame buffer access command, the chip
+ * select line is kept active until ng_at86rf2xx_fb_stop() is called. Reading
+ * starts with the PHR, writing expects the PHR as first byte.
+ *
+ * @param[in] dev       device to access
+ * @param[in] access    NG_AT86RF2XX_ACCESS_READ or NG_AT86RF2XX_ACCESS_WRITE
+ */
+void ng_at86rf2xx_fb_start(const ng_at86rf2xx_t *dev, const uint8_t access);
+
+/**
+ * @brief   Transfer a chunk of data within an ongoing frame buffer access
+ *
+ * @param[in]  dev      device to access
+ * @param[in]  out      data to write, may be NULL when reading
+ * @param[out] in       buffer for the read data, may be NULL when writing
+ * @param[in]  len      number of bytes to transfer
+ */
+void ng_at86rf2xx_fb_transfer(const ng_at86rf2xx_t *dev,
+                              const uint8_t *out,
+                              uint8_t *in,
+                              const size_t len);
+
+/**
+ * @brief   Finish a frame buffer access transaction and release the SPI bus
+ *
+ * @param[in] dev       device to access
+ */
+void ng_at86rf2xx_fb_stop(const ng_at86rf2xx_t *dev);
+
 /**
  * @brief   Read the internal frame buffer of the given device
  *
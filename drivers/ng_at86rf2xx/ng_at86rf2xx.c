@@ -226,6 +226,11 @@ void ng_at86rf2xx_tx_exec(ng_at86rf2xx_t *dev)
 {
     /* write frame length field in FIFO */
     ng_at86rf2xx_sram_write(dev, 0, &(dev->frame_len), 1);
+    ng_at86rf2xx_tx_start(dev);
+}
+
+void ng_at86rf2xx_tx_start(ng_at86rf2xx_t *dev)
+{
     /* trigger sending of pre-loaded frame */
     ng_at86rf2xx_reg_write(dev, NG_AT86RF2XX_REG__TRX_STATE,
                            NG_AT86RF2XX_TRX_STATE__TX_START);
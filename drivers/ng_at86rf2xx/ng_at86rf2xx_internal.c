@@ -85,20 +85,38 @@ void ng_at86rf2xx_sram_write(const ng_at86rf2xx_t *dev,
     spi_release(dev->spi);
 }
 
-void ng_at86rf2xx_fb_read(const ng_at86rf2xx_t *dev,
-                          uint8_t *data,
-                          const size_t len)
+void ng_at86rf2xx_fb_start(const ng_at86rf2xx_t *dev, const uint8_t access)
 {
     spi_acquire(dev->spi);
     gpio_clear(dev->cs_pin);
-    spi_transfer_byte(dev->spi,
-                      NG_AT86RF2XX_ACCESS_FB | NG_AT86RF2XX_ACCESS_READ,
-                      NULL);
-    spi_transfer_bytes(dev->spi, NULL, (char *)data, len);
+    spi_transfer_byte(dev->spi, NG_AT86RF2XX_ACCESS_FB | access, NULL);
+}
+
+void ng_at86rf2xx_fb_transfer(const ng_at86rf2xx_t *dev,
+                              const uint8_t *out,
+                              uint8_t *in,
+                              const size_t len)
+{
+    if (len > 0) {
+        spi_transfer_bytes(dev->spi, (char *)out, (char *)in, len);
+    }
+}
+
+void ng_at86rf2xx_fb_stop(const ng_at86rf2xx_t *dev)
+{
     gpio_set(dev->cs_pin);
     spi_release(dev->spi);
 }
 
+void ng_at86rf2xx_fb_read(const ng_at86rf2xx_t *dev,
+                          uint8_t *data,
+                          const size_t len)
+{
+    ng_at86rf2xx_fb_start(dev, NG_AT86RF2XX_ACCESS_READ);
+    ng_at86rf2xx_fb_transfer(dev, NULL, data, len);
+    ng_at86rf2xx_fb_stop(dev);
+}
+
 uint8_t ng_at86rf2xx_get_status(const ng_at86rf2xx_t *dev)
 {
     return (ng_at86rf2xx_reg_read(dev, NG_AT86RF2XX_REG__TRX_STATUS)
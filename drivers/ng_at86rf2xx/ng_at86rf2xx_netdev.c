@@ -47,6 +47,10 @@ static size_t _make_data_frame_hdr(ng_at86rf2xx_t *dev, uint8_t *buf,
         buf[0] |= NG_IEEE802154_FCF_ACK_REQ;
     }
 
+    if (hdr->flags & NG_NETIF_HDR_FLAGS_MORE_DATA) {
+        buf[0] |= NG_IEEE802154_FCF_FRAME_PEND;
+    }
+
     /* fill in destination PAN ID */
     pos = 3;
     buf[pos++] = (uint8_t)((dev->pan) & 0xff);
@@ -209,7 +213,7 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
     ng_at86rf2xx_t *dev = (ng_at86rf2xx_t *)netdev;
     ng_pktsnip_t *snip;
     uint8_t mhr[NG_IEEE802154_MAX_HDR_LEN];
-    size_t len;
+    size_t len, payload_len;
 
     if (pkt == NULL) {
         return -ENOMSG;
@@ -228,23 +232,29 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
     }
     /* check if packet (header + payload + FCS) fits into FIFO */
     snip = pkt->next;
-    if ((ng_pkt_len(snip) + len + 2) > NG_AT86RF2XX_MAX_PKT_LENGTH) {
+    payload_len = ng_pkt_len(snip);
+    if ((payload_len + len + 2) > NG_AT86RF2XX_MAX_PKT_LENGTH) {
         DEBUG("[ng_at86rf2xx] error: packet too large to be send\n");
         ng_pktbuf_release(pkt);
         return -EOVERFLOW;
     }
 
     ng_at86rf2xx_tx_prepare(dev);
-    /* put header into FIFO */
-    len = ng_at86rf2xx_tx_load(dev, mhr, len, 0);
-    /* load packet data into FIFO */
+    dev->frame_len = (uint8_t)(len + payload_len + NG_IEEE802154_FCS_LEN);
+    /* write PHR, header and all payload chunks in a single frame buffer
+     * access instead of one SPI transaction per chunk */
+    ng_at86rf2xx_fb_start(dev, NG_AT86RF2XX_ACCESS_WRITE);
+    ng_at86rf2xx_fb_transfer(dev, &(dev->frame_len), NULL, 1);
+    ng_at86rf2xx_fb_transfer(dev, mhr, NULL, len);
     while (snip) {
-        len = ng_at86rf2xx_tx_load(dev, snip->data, snip->size, len);
+        ng_at86rf2xx_fb_transfer(dev, snip->data, NULL, snip->size);
+        len += snip->size;
         snip = snip->next;
     }
+    ng_at86rf2xx_fb_stop(dev);
     /* send data out directly if pre-loading id disabled */
     if (!(dev->options & NG_AT86RF2XX_OPT_PRELOADING)) {
-        ng_at86rf2xx_tx_exec(dev);
+        ng_at86rf2xx_tx_start(dev);
     }
     /* release packet */
     ng_pktbuf_release(pkt);
@@ -255,59 +265,82 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 static void _receive_data(ng_at86rf2xx_t *dev)
 {
     uint8_t mhr[NG_IEEE802154_MAX_HDR_LEN];
+    uint8_t phr;
+#ifdef NG_AT86RF2XX_FB_HAS_ED
+    uint8_t trailer[NG_IEEE802154_FCS_LEN + 2];     /* FCS, LQI and ED */
+#else
+    uint8_t trailer[NG_IEEE802154_FCS_LEN + 1];     /* FCS and LQI */
+#endif
     size_t pkt_len, hdr_len;
     ng_pktsnip_t *hdr, *payload = NULL;
     ng_netif_hdr_t *netif;
 
-    /* get the size of the received packet (unlocks frame buffer protection) */
-    pkt_len = ng_at86rf2xx_rx_len(dev);
+    /* the whole frame is read in a single frame buffer access, starting with
+     * the PHR (this also unlocks the frame buffer protection) */
+    ng_at86rf2xx_fb_start(dev, NG_AT86RF2XX_ACCESS_READ);
+    ng_at86rf2xx_fb_transfer(dev, NULL, &phr, 1);
 
     /* abort here already if no event callback is registered */
-    if (!dev->event_cb) {
+    if (!dev->event_cb || (phr <= NG_IEEE802154_FCS_LEN)) {
+        ng_at86rf2xx_fb_stop(dev);
         return;
     }
+    pkt_len = (size_t)(phr - NG_IEEE802154_FCS_LEN);
 
     /* in raw mode, just read the binary dump into the packet buffer */
     if (dev->options & NG_AT86RF2XX_OPT_RAWDUMP) {
         payload = ng_pktbuf_add(NULL, NULL, pkt_len, NG_NETTYPE_UNDEF);
         if (payload == NULL ) {
             DEBUG("[ng_at86rf2xx] error: unable to allocate RAW data\n");
+            ng_at86rf2xx_fb_stop(dev);
             return;
         }
-        ng_at86rf2xx_rx_read(dev, payload->data, pkt_len, 0);
+        ng_at86rf2xx_fb_transfer(dev, NULL, payload->data, pkt_len);
+        ng_at86rf2xx_fb_stop(dev);
         dev->event_cb(NETDEV_EVENT_RX_COMPLETE, payload);
         return;
     }
 
     /* get FCF field and compute 802.15.4 header length */
-    ng_at86rf2xx_rx_read(dev, mhr, 2, 0);
+    ng_at86rf2xx_fb_transfer(dev, NULL, mhr, 2);
     hdr_len = _get_frame_hdr_len(mhr);
-    if (hdr_len == 0) {
+    if ((hdr_len == 0) || (hdr_len > pkt_len)) {
         DEBUG("[ng_at86rf2xx] error: unable parse incoming frame header\n");
+        ng_at86rf2xx_fb_stop(dev);
         return;
     }
     /* read the rest of the header and parse the netif header from it */
-    ng_at86rf2xx_rx_read(dev, &(mhr[2]), hdr_len - 2, 2);
+    ng_at86rf2xx_fb_transfer(dev, NULL, &(mhr[2]), hdr_len - 2);
     hdr = _make_netif_hdr(mhr);
     if (hdr == NULL) {
         DEBUG("[ng_at86rf2xx] error: unable to allocate netif header\n");
+        ng_at86rf2xx_fb_stop(dev);
         return;
     }
-    /* fill missing fields in netif header */
-    netif = (ng_netif_hdr_t *)hdr->data;
-    netif->if_pid = dev->mac_pid;
-    ng_at86rf2xx_rx_read(dev, &(netif->lqi), 1, pkt_len);
-    netif->rssi = ng_at86rf2xx_reg_read(dev, NG_AT86RF2XX_REG__PHY_ED_LEVEL);
 
     /* allocate payload */
     payload = ng_pktbuf_add(hdr, NULL, (pkt_len - hdr_len), dev->proto);
     if (payload == NULL) {
         DEBUG("[ng_at86rf2xx] error: unable to allocate incoming payload\n");
+        ng_at86rf2xx_fb_stop(dev);
         ng_pktbuf_release(hdr);
         return;
     }
-    /* copy payload */
-    ng_at86rf2xx_rx_read(dev, payload->data, payload->size, hdr_len);
+    /* copy payload, then skip the FCS and get the LQI (and ED level) that
+     * the device appends to the frame */
+    ng_at86rf2xx_fb_transfer(dev, NULL, payload->data, payload->size);
+    ng_at86rf2xx_fb_transfer(dev, NULL, trailer, sizeof(trailer));
+    ng_at86rf2xx_fb_stop(dev);
+
+    /* fill missing fields in netif header */
+    netif = (ng_netif_hdr_t *)hdr->data;
+    netif->if_pid = dev->mac_pid;
+    netif->lqi = trailer[NG_IEEE802154_FCS_LEN];
+#ifdef NG_AT86RF2XX_FB_HAS_ED
+    netif->rssi = trailer[NG_IEEE802154_FCS_LEN + 1];
+#else
+    netif->rssi = ng_at86rf2xx_reg_read(dev, NG_AT86RF2XX_REG__PHY_ED_LEVEL);
+#endif
     /* finish up and send data to upper layers */
     dev->event_cb(NETDEV_EVENT_RX_COMPLETE, payload);
 }
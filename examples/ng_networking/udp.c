@@ -53,8 +53,9 @@ static void send(char *addr_str, char *port_str, char *data)
     port[0] = (uint8_t)tmp;
     port[1] = tmp >> 8;
 
-    /* allocate payload */
-    payload = ng_pktbuf_add(NULL, data, strlen(data), NG_NETTYPE_UNDEF);
+    /* allocate payload, with room for UDP and IPv6 header in front of it */
+    payload = ng_pktbuf_add_headroom(NULL, data, strlen(data),
+                                     NG_PKTBUF_HEADROOM, NG_NETTYPE_UNDEF);
     if (payload == NULL) {
         puts("Error: unable to copy data to packet buffer");
         return;
@@ -108,7 +109,11 @@ static void start_server(char *port_str)
     /* start server (which means registering pktdump for the chosen port) */
     server.pid = ng_pktdump_getpid();
     server.demux_ctx = (uint32_t)port;
-    ng_netreg_register(NG_NETTYPE_UDP, &server);
+    if (ng_netreg_register(NG_NETTYPE_UDP, &server) < 0) {
+        server.pid = KERNEL_PID_UNDEF;
+        puts("Error: unable to register server, network registry is full");
+        return;
+    }
     printf("Success: started UDP server on port %" PRIu16 "\n", port);
 }
 
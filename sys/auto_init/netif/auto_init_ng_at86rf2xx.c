@@ -20,7 +20,11 @@
 #ifdef MODULE_NG_AT86RF2XX
 
 #include "board.h"
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#else
 #include "net/ng_nomac.h"
+#endif
 #include "net/ng_netbase.h"
 
 #include "ng_at86rf2xx.h"
@@ -58,9 +62,15 @@ void auto_init_ng_at86rf2xx(void)
             DEBUG("Error initializing AT86RF2xx radio device!");
         }
         else {
+#ifdef MODULE_NG_CSMA
+            ng_csma_init(_nomac_stacks[i],
+                    AT86RF2XX_MAC_STACKSIZE, AT86RF2XX_MAC_PRIO,
+                    "at86rfxx", (ng_netdev_t *)&ng_at86rf2xx_devs[i]);
+#else
             ng_nomac_init(_nomac_stacks[i],
                     AT86RF2XX_MAC_STACKSIZE, AT86RF2XX_MAC_PRIO,
                     "at86rfxx", (ng_netdev_t *)&ng_at86rf2xx_devs[i]);
+#endif
         }
     }
 }
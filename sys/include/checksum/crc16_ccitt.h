@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc16_ccitt CRC16-CCITT
+ * @ingroup     sys_checksum
+ * @brief       CRC-16-CCITT checksum algorithm
+ * @details     This implementation processes the data least significant bit
+ *              first with the reflected polynomial 0x8408
+ *              (x^16 + x^12 + x^5 + 1) and without final XOR. With a start
+ *              value of 0 this is the frame check sequence of IEEE 802.15.4
+ *              (also known as CRC-16/KERMIT).
+ *
+ *              By default a 256 entry table (512 byte) is used. Set
+ *              CRC16_CCITT_SLICING to 1 to process four bytes per step with
+ *              four tables (2 KiB), or CRC16_CCITT_BITWISE to 1 to save the
+ *              table on platforms short of ROM.
+ * @{
+ *
+ * @file
+ * @brief       CRC-16-CCITT definitions
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef CRC16_CCITT_H_
+#define CRC16_CCITT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The reflected generator polynomial
+ */
+#define CRC16_CCITT_POLY    (0x8408)
+
+/**
+ * @brief   Use slicing-by-4 tables
+ */
+#ifndef CRC16_CCITT_SLICING
+#define CRC16_CCITT_SLICING (0)
+#endif
+
+/**
+ * @brief   Calculate bit by bit without tables
+ */
+#ifndef CRC16_CCITT_BITWISE
+#define CRC16_CCITT_BITWISE (0)
+#endif
+
+/**
+ * @brief   Updates a CRC-16-CCITT checksum with further data
+ *
+ * @param[in] crc   The checksum of the data so far, 0 to start.
+ * @param[in] buf   The data to add.
+ * @param[in] len   Length of @p buf in bytes.
+ *
+ * @return  The checksum of the data so far and @p buf.
+ */
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *buf, size_t len);
+
+/**
+ * @brief   Calculates the CRC-16-CCITT checksum of a buffer
+ *
+ * @param[in] buf   The data.
+ * @param[in] len   Length of @p buf in bytes.
+ *
+ * @return  The checksum of @p buf. It is 0 if @p buf ends with its own
+ *          checksum (least significant byte first).
+ */
+static inline uint16_t crc16_ccitt_calc(const uint8_t *buf, size_t len)
+{
+    return crc16_ccitt_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC16_CCITT_H_ */
+/** @} */
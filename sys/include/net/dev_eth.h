@@ -59,6 +59,7 @@ extern "C" {
 
 #include <stdint.h>
 #include "ng_ethernet/hdr.h"
+#include "net/ng_netdev.h"
 
 /**
  * @brief Structure to hold driver state
@@ -149,6 +150,21 @@ typedef struct eth_driver {
      * See receive packet flow description for details.
      */
     void (*isr)(dev_eth_t *dev);
+
+    /**
+     * @brief Send ethernet frame given as gather vector (optional)
+     *
+     * Like eth_driver::send, but the frame is spread over @p count
+     * elements of @p vector, so it can be sent without copying it into a
+     * contiguous buffer first. May be NULL if the device does not support
+     * this.
+     *
+     * @param vector    gather vector holding the frame
+     * @param count     nr of elements in @p vector
+     *
+     * @return nr of bytes sent, or <=0 on error
+     */
+    int (*send_vec)(dev_eth_t *dev, const ng_netdev_iovec_t *vector, int count);
 } eth_driver_t;
 
 /**
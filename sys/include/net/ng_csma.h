@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ng_csma CSMA/CA MAC layer
+ * @ingroup     net
+ * @brief       MAC protocol with unslotted CSMA/CA, link layer
+ *              acknowledgements and retransmissions
+ *
+ * Packets to send are queued per interface and sent one after another. Before
+ * each transmission the layer backs off for a random number of backoff
+ * periods and checks if the channel is clear with the device's
+ * @ref NETCONF_OPT_IS_CHANNEL_CLR option, as described for the unslotted
+ * CSMA/CA of IEEE 802.15.4. Devices that do not support this option are
+ * assumed to see a clear channel.
+ *
+ * Unicast packets are retransmitted if the device has its
+ * @ref NETCONF_OPT_AUTOACK option enabled but does not retransmit on its own
+ * (it does not support @ref NETCONF_OPT_RETRANS) and the acknowledgement is
+ * not reported with @ref NETDEV_EVENT_TX_ACKED in time. This requires the
+ * device to enable @ref NETCONF_OPT_ACK_REPORT, other devices' packets are
+ * sent only once.
+ *
+ * If the next queued packet goes to the same destination, the
+ * @ref NG_NETIF_HDR_FLAGS_MORE_DATA flag is set for the current one, so the
+ * device can announce it with the frame pending bit. The next packet is then
+ * sent right after a clear channel assessment without further backoff.
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the CSMA/CA MAC layer
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef NG_CSMA_H_
+#define NG_CSMA_H_
+
+#include <stdint.h>
+
+#include "kernel.h"
+#include "net/ng_netdev.h"
+#include "net/ng_netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Set the default message queue size for CSMA layers
+ */
+#ifndef NG_CSMA_MSG_QUEUE_SIZE
+#define NG_CSMA_MSG_QUEUE_SIZE          (8U)
+#endif
+
+/**
+ * @brief   Number of packets each CSMA layer queues for sending
+ */
+#ifndef NG_CSMA_TX_QUEUE_SIZE
+#define NG_CSMA_TX_QUEUE_SIZE           (4U)
+#endif
+
+/**
+ * @brief   Maximum number of CSMA layer instances
+ */
+#ifndef NG_CSMA_NUMOF
+#define NG_CSMA_NUMOF                   (NG_NETIF_NUMOF)
+#endif
+
+/**
+ * @brief   Initial backoff exponent (macMinBE)
+ */
+#ifndef NG_CSMA_MIN_BE
+#define NG_CSMA_MIN_BE                  (3U)
+#endif
+
+/**
+ * @brief   Maximum backoff exponent (macMaxBE)
+ */
+#ifndef NG_CSMA_MAX_BE
+#define NG_CSMA_MAX_BE                  (5U)
+#endif
+
+/**
+ * @brief   Number of backoffs before a channel access failure
+ *          (macMaxCSMABackoffs)
+ */
+#ifndef NG_CSMA_MAX_BACKOFFS
+#define NG_CSMA_MAX_BACKOFFS            (4U)
+#endif
+
+/**
+ * @brief   Number of retransmissions of unacknowledged packets
+ *          (macMaxFrameRetries)
+ */
+#ifndef NG_CSMA_MAX_RETRIES
+#define NG_CSMA_MAX_RETRIES             (3U)
+#endif
+
+/**
+ * @brief   Length of a backoff period in microseconds (20 symbols at
+ *          250 kbit/s)
+ */
+#ifndef NG_CSMA_BACKOFF_PERIOD
+#define NG_CSMA_BACKOFF_PERIOD          (320U)
+#endif
+
+/**
+ * @brief   Time to wait for an acknowledgement in microseconds
+ *          (macAckWaitDuration at 250 kbit/s)
+ *
+ * @note    Increase this for devices with a higher latency, e.g.
+ *          @ref net_ng_zep.
+ */
+#ifndef NG_CSMA_ACK_TIMEOUT
+#define NG_CSMA_ACK_TIMEOUT             (864U)
+#endif
+
+/**
+ * @brief   Message type for the end of a backoff
+ */
+#define NG_CSMA_MSG_BACKOFF             (0x0120)
+
+/**
+ * @brief   Message type for the timeout of an acknowledgement
+ */
+#define NG_CSMA_MSG_ACK_TIMEOUT         (0x0121)
+
+/**
+ * @brief   Statistics of a CSMA layer instance
+ */
+typedef struct {
+    uint32_t tx;            /**< packets sent (and acknowledged if requested) */
+    uint32_t rx;            /**< packets received */
+    uint32_t retries;       /**< retransmissions */
+    uint32_t busy;          /**< clear channel assessments with busy channel */
+    uint32_t full;          /**< packets dropped because the queue was full */
+    uint32_t access_fail;   /**< packets dropped on channel access failure */
+    uint32_t no_ack;        /**< packets dropped without acknowledgement */
+    uint32_t error;         /**< packets the device failed to send */
+} ng_csma_stats_t;
+
+/**
+ * @brief   Initialize an instance of the CSMA layer
+ *
+ * The initialization starts a new thread that connects to the given netdev
+ * device and starts a link layer event loop.
+ *
+ * @param[in] stack         stack for the control thread
+ * @param[in] stacksize     size of *stack*
+ * @param[in] priority      priority for the thread housing the CSMA instance
+ * @param[in] name          name of the thread housing the CSMA instance
+ * @param[in] dev           netdev device, needs to be already initialized
+ *
+ * @return                  PID of CSMA thread on success
+ * @return                  -EINVAL if creation of thread fails
+ * @return                  -ENODEV if *dev* is invalid
+ * @return                  -ENOBUFS if there are already @ref NG_CSMA_NUMOF
+ *                          instances
+ */
+kernel_pid_t ng_csma_init(char *stack, int stacksize, char priority,
+                          const char *name, ng_netdev_t *dev);
+
+/**
+ * @brief   Get the statistics of a CSMA layer instance
+ *
+ * @param[in] pid           PID of the CSMA thread
+ * @param[out] stats        the statistics
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p pid is not a CSMA layer
+ */
+int ng_csma_get_stats(kernel_pid_t pid, ng_csma_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_CSMA_H_ */
+/** @} */
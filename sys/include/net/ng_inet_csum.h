@@ -21,11 +21,38 @@
 #define NG_INET_CSUM_H_
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
+ *          buffer provides a slice of the full checksum domain, calculated in
+ *          order.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1071">
+ *          RFC 1071
+ *      </a>
+ *
+ * @details The Internet Checksum is not normalized (i. e. its 1's complement
+ *          was not taken of the result) to use it for further calculation.
+ *          Use this function to calculate the checksum over data spread over
+ *          several buffers (e.g. a chain of @ref ng_pktsnip_t), where a
+ *          buffer may have an odd length.
+ *
+ * @param[in] sum       An initial value for the checksum.
+ * @param[in] buf       A buffer.
+ * @param[in] len       Length of @p buf in byte.
+ * @param[in] accum_len Number of bytes the checksum was calculated over
+ *                      before @p buf.
+ *
+ * @return  The unnormalized Internet Checksum of @p buf.
+ */
+uint16_t ng_inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                            size_t accum_len);
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf.
  *
@@ -42,7 +69,10 @@ extern "C" {
  *
  * @return  The unnormalized Internet Checksum of @p buf.
  */
-uint16_t ng_inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len);
+static inline uint16_t ng_inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    return ng_inet_csum_slice(sum, buf, len, 0);
+}
 
 #ifdef __cplusplus
 }
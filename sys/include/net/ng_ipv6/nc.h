@@ -164,6 +164,10 @@ void ng_ipv6_nc_init(void);
  *                          to NG_IPV6_L2_ADDR_MAX. 0 if unknown.
  * @param[in] flags         Flags for the entry
  *
+ * @details If the neighbor cache is full, the least recently used entry is
+ *          replaced. Entries of type @ref NG_IPV6_NC_TYPE_REGISTERED are
+ *          never replaced.
+ *
  * @return  Pointer to new neighbor cache entry on success
  * @return  NULL, on failure
  */
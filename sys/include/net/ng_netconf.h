@@ -137,6 +137,10 @@ typedef enum {
     NETCONF_OPT_TX_END_IRQ,
     NETCONF_OPT_AUTOCCA,            /**< en/disable to check automatically
                                          before sending the channel is clear. */
+    NETCONF_OPT_ACK_REPORT,         /**< read if the device reports received
+                                     *   link layer ACKs with
+                                     *   NETDEV_EVENT_TX_ACKED as type
+                                     *   ng_netconf_enable_t */
     /* add more options if needed */
 
     /**
@@ -48,9 +48,20 @@ typedef enum {
     NETDEV_EVENT_RX_COMPLETE    = 0x0002,   /**< finished receiving a packet */
     NETDEV_EVENT_TX_STARTED     = 0x0004,   /**< started to transfer a packet */
     NETDEV_EVENT_TX_COMPLETE    = 0x0008,   /**< finished transferring packet */
+    NETDEV_EVENT_TX_ACKED       = 0x0010,   /**< received the link layer ACK
+                                             *   for the last packet sent */
     /* expand this list if needed */
 } ng_netdev_event_t;
 
+/**
+ * @brief   Element of a gather vector, layout compatible to POSIX
+ *          `struct iovec`
+ */
+typedef struct {
+    void *iov_base;     /**< start of the memory region */
+    size_t iov_len;     /**< length of the memory region in byte */
+} ng_netdev_iovec_t;
+
 /**
  * @brief   Event callback for signaling event to a MAC layer
  *
@@ -173,6 +184,43 @@ struct ng_netdev {
     kernel_pid_t mac_pid;               /**< the driver's thread's PID */
 };
 
+/**
+ * @brief   Fills a gather vector with the data of the snips of @p pkt
+ *
+ * @details Drivers can use this to stream a packet directly from the packet
+ *          buffer to the device (e.g. into a radio's frame buffer or with
+ *          `writev()`) instead of copying it into an intermediate buffer
+ *          first. Snips of length 0 are skipped.
+ *
+ * @param[in] pkt       A packet.
+ * @param[out] vector   The gather vector.
+ * @param[in] count     Maximum number of elements in @p vector.
+ *
+ * @return  Number of elements used in @p vector.
+ * @return  -EOVERFLOW, if @p pkt has more than @p count snips.
+ */
+static inline int ng_netdev_gather(const ng_pktsnip_t *pkt,
+                                   ng_netdev_iovec_t *vector, size_t count)
+{
+    size_t i = 0;
+
+    while (pkt != NULL) {
+        if (pkt->size > 0) {
+            if (i >= count) {
+                return -EOVERFLOW;
+            }
+
+            vector[i].iov_base = pkt->data;
+            vector[i].iov_len = pkt->size;
+            i++;
+        }
+
+        pkt = pkt->next;
+    }
+
+    return (int)i;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,15 @@ extern "C" {
  *          this flag the same way it does @ref NG_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define NG_NETIF_HDR_FLAGS_MULTICAST    (0x40)
+
+/**
+ * @brief   More packets to the same destination follow.
+ *
+ * @details Set by MAC layers that queue packets. The link layer may announce
+ *          the following packets to the receiver, e.g. with the frame
+ *          pending bit of IEEE 802.15.4.
+ */
+#define NG_NETIF_HDR_FLAGS_MORE_DATA    (0x20)
 /**
  * @}
  */
@@ -37,6 +37,23 @@ extern "C" {
  */
 #define NG_NETREG_DEMUX_CTX_ALL (0xffff0000)
 
+/**
+ * @brief   Maximum number of distinct pairs of type and demultiplexing context
+ *          in the registry.
+ *
+ * @details The registry is a hash table over these pairs, each slot costs
+ *          16 bytes of RAM on 32-bit platforms. The default covers the
+ *          stack's own protocol threads and a handful of listeners (e.g.
+ *          one per UDP port). Applications registering more pairs should
+ *          raise it: registration fails with -ENOMEM once all slots are
+ *          taken, and lookups probe more slots the fuller the table gets,
+ *          so keep some headroom above the expected number of pairs. A
+ *          power of two keeps the hash function a plain shift.
+ */
+#ifndef NG_NETREG_SIZE
+#define NG_NETREG_SIZE          (16)
+#endif
+
 /**
  * @brief   Entry to the @ref net_ng_netreg
  */
@@ -77,6 +94,8 @@ void ng_netreg_init(void);
  *
  * @return  0 on success
  * @return  -EINVAL if @p type was < NG_NETTYPE_UNDEF or >= NG_NETTYPE_NUMOF
+ * @return  -ENOMEM if the registry already holds NG_NETREG_SIZE distinct
+ *          pairs of type and demultiplexing context
  */
 int ng_netreg_register(ng_nettype_t type, ng_netreg_entry_t *entry);
 
@@ -108,6 +108,21 @@ typedef struct ng_pktsnip {
     void *data;                     /**< pointer to the data of the snip */
     size_t size;                    /**< the length of the snip in byte */
     ng_nettype_t type;              /**< protocol of the packet snip */
+    /**
+     * @brief   Number of unused bytes in front of ng_pktsnip_t::data reserved
+     *          for headers to be prepended in place.
+     *
+     * @internal
+     */
+    uint16_t headroom;
+    /**
+     * @brief   Next snip sharing ng_pktsnip_t::data, the sharing snips form a
+     *          ring. NULL if the data is not shared with a snip of another
+     *          packet, otherwise it needs to be copied before it is written to.
+     *
+     * @internal
+     */
+    struct ng_pktsnip *shared;
 } ng_pktsnip_t;
 
 /**
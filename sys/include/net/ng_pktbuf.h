@@ -56,6 +56,46 @@ extern "C" {
 #define NG_PKTBUF_SIZE  (6144)
 #endif  /* NG_PKTBUF_SIZE */
 
+/**
+ * @def     NG_PKTBUF_HEADROOM
+ * @brief   Default headroom to reserve for headers in sending direction with
+ *          @ref ng_pktbuf_add_headroom().
+ *
+ * @details Fits an IPv6 header (40 byte) and a UDP header (8 byte).
+ */
+#ifndef NG_PKTBUF_HEADROOM
+#define NG_PKTBUF_HEADROOM  (48)
+#endif
+
+/**
+ * @name    Slab packet buffer configuration
+ * @brief   Size classes of the packet buffer if the module `ng_pktbuf_slab`
+ *          is used.
+ *
+ * @details Instead of a first-fit arena of @ref NG_PKTBUF_SIZE byte, the
+ *          slab packet buffer allocates fixed-size chunks from separate pools
+ *          for @ref ng_pktsnip_t headers, small (e.g. IEEE 802.15.4 frames),
+ *          and large (e.g. full-MTU IPv6 packets) data in O(1) without
+ *          fragmentation. If a pool is exhausted the next bigger one is used.
+ * @{
+ */
+#ifndef NG_PKTBUF_SLAB_SNIP_NUMOF
+#define NG_PKTBUF_SLAB_SNIP_NUMOF   (32)    /**< number of packet snips */
+#endif
+#ifndef NG_PKTBUF_SLAB_SMALL_SIZE
+#define NG_PKTBUF_SLAB_SMALL_SIZE   (128)   /**< size of a small chunk */
+#endif
+#ifndef NG_PKTBUF_SLAB_SMALL_NUMOF
+#define NG_PKTBUF_SLAB_SMALL_NUMOF  (16)    /**< number of small chunks */
+#endif
+#ifndef NG_PKTBUF_SLAB_LARGE_SIZE
+#define NG_PKTBUF_SLAB_LARGE_SIZE   (1280)  /**< size of a large chunk */
+#endif
+#ifndef NG_PKTBUF_SLAB_LARGE_NUMOF
+#define NG_PKTBUF_SLAB_LARGE_NUMOF  (3)     /**< number of large chunks */
+#endif
+/** @} */
+
 /**
  * @brief   Adds a new ng_pktsnip_t and its packet to the packet buffer.
  *
@@ -107,6 +147,9 @@ extern "C" {
  *                      will be inserted into `result`. If @p data is already
  *                      in the packet buffer (e.g. a payload of an already
  *                      allocated packet) it will not be duplicated.
+ *                      If @p data is not in the packet buffer and @p pkt has
+ *                      enough headroom (see @ref ng_pktbuf_add_headroom()),
+ *                      `result` is placed in front of @p pkt's data.
  * @param[in] size      Length of @p data. If @p size is 0 no data will be inserted
  *                      into the the packet buffer and ng_pktsnip_t::data will be
  *                      set to @p data.
@@ -120,6 +163,39 @@ extern "C" {
 ng_pktsnip_t *ng_pktbuf_add(ng_pktsnip_t *pkt, void *data, size_t size,
                             ng_nettype_t type);
 
+/**
+ * @brief   Adds a new ng_pktsnip_t and its packet to the packet buffer and
+ *          reserves @p headroom bytes in front of its data.
+ *
+ * @details Behaves like @ref ng_pktbuf_add(), but if new data is allocated
+ *          @p headroom bytes are reserved in front of it. Headers later
+ *          prepended to the resulting snip with @ref ng_pktbuf_add() (with
+ *          @p data either NULL or not in the packet buffer) are then placed in
+ *          this headroom, so only a new ng_pktsnip_t and no data needs to be
+ *          allocated. The remaining headroom is handed on to the new header.
+ *
+ *          This is meant for packet creation in sending direction, e.g.
+ *
+ *          @code
+ *          payload = ng_pktbuf_add_headroom(NULL, data, size, NG_PKTBUF_HEADROOM,
+ *                                           NG_NETTYPE_UNDEF);
+ *          udp = ng_udp_hdr_build(payload, ...); // goes into headroom
+ *          @endcode
+ *
+ * @param[in,out] pkt   The packet you want to add a ng_pktsnip_t to. Leave
+ *                      NULL if you want to create a new packet.
+ * @param[in] data      Data of the new ng_pktsnip_t.
+ * @param[in] size      Length of @p data.
+ * @param[in] headroom  Number of bytes to reserve in front of the new data.
+ *                      Must not exceed `UINT16_MAX`.
+ * @param[in] type      Protocol type of the ng_pktsnip_t.
+ *
+ * @return  Pointer to the packet part that represents the new ng_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+ng_pktsnip_t *ng_pktbuf_add_headroom(ng_pktsnip_t *pkt, void *data, size_t size,
+                                     size_t headroom, ng_nettype_t type);
+
 /**
  * @brief   Reallocates ng_pktsnip_t::data of @p pkt in the packet buffer, without
  *          changing the content.
@@ -160,8 +236,11 @@ void ng_pktbuf_release(ng_pktsnip_t *pkt);
 /**
  * @brief   Must be called once before there is a write operation in a thread.
  *
- * @details This function duplicates a packet in the packet buffer if
- *          ng_pktsnip_t::users of @p pkt > 1.
+ * @details This function duplicates a packet snip in the packet buffer if
+ *          ng_pktsnip_t::users of @p pkt > 1. Only @p pkt is copied, the
+ *          snips following it stay shared with the other users. If
+ *          @p pkt's data is still shared after @ref ng_pktbuf_start_mark()
+ *          it is copied now.
  *
  * @note    Do *not* call this function in a thread twice on the same packet.
  *
@@ -173,6 +252,26 @@ void ng_pktbuf_release(ng_pktsnip_t *pkt);
  */
 ng_pktsnip_t *ng_pktbuf_start_write(ng_pktsnip_t *pkt);
 
+/**
+ * @brief   Must be called once before the ng_pktsnip_t of @p pkt (but not
+ *          its data) is changed in a thread, e.g. to mark a header with
+ *          @ref ng_pktbuf_add().
+ *
+ * @details If ng_pktsnip_t::users of @p pkt > 1 only the ng_pktsnip_t is
+ *          duplicated, its data stays shared with the other users (copy-on-
+ *          write). Call @ref ng_pktbuf_start_write() on a snip before
+ *          writing to its data.
+ *
+ * @note    Do *not* call this function in a thread twice on the same packet.
+ *
+ * @param[in] pkt   The packet you want to change.
+ *
+ * @return  The (new) pointer to the pkt.
+ * @return  NULL, if ng_pktsnip_t::users of @p pkt > 1 and if there is not
+ *          enough space in the packet buffer.
+ */
+ng_pktsnip_t *ng_pktbuf_start_mark(ng_pktsnip_t *pkt);
+
 /**
  * @brief   Deletes a snip from a packet and the packet buffer.
  *
@@ -197,7 +296,10 @@ static inline ng_pktsnip_t *ng_pktbuf_remove_snip(ng_pktsnip_t *pkt,
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes or, with the
+ *          module `ng_pktbuf_slab`, the current and maximum number of used
+ *          chunks per size class. Also the number of bytes copied by
+ *          copy-on-write is given.
  */
 void ng_pktbuf_stats(void);
 #endif
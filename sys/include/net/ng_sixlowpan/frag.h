@@ -41,6 +41,23 @@ extern "C" {
                                                      *   fragments */
 #define NG_SIXLOWPAN_FRAG_SIZE_MASK     (0x07ff)    /**< mask for datagram size */
 
+/**
+ * @brief   Message type for garbage collection of the reassembly buffer
+ */
+#define NG_SIXLOWPAN_MSG_FRAG_GC_RBUF   (0x0225)
+
+/**
+ * @brief   Reassembly statistics
+ */
+typedef struct {
+    uint32_t complete;  /**< datagrams reassembled */
+    uint32_t timeout;   /**< datagrams dropped because they timed out */
+    uint32_t full;      /**< datagrams dropped to make room for new ones */
+    uint32_t overlap;   /**< datagrams dropped due to overlapping fragments */
+    uint32_t invalid;   /**< datagrams dropped due to fragments exceeding their size */
+    uint32_t nomem;     /**< datagrams dropped for lack of packet buffer space */
+} ng_sixlowpan_frag_stats_t;
+
 /**
  * @brief   General and 1st 6LoWPAN fragmentation header
  *
@@ -123,6 +140,21 @@ void ng_sixlowpan_frag_send(kernel_pid_t pid, ng_pktsnip_t *pkt,
  */
 void ng_sixlowpan_frag_handle_pkt(ng_pktsnip_t *pkt);
 
+/**
+ * @brief   Garbage collects the reassembly buffer.
+ *
+ * @details To be called by the 6LoWPAN thread on
+ *          @ref NG_SIXLOWPAN_MSG_FRAG_GC_RBUF.
+ */
+void ng_sixlowpan_frag_gc_rbuf(void);
+
+/**
+ * @brief   Gets the reassembly statistics.
+ *
+ * @param[out] stats    The statistics since startup.
+ */
+void ng_sixlowpan_frag_get_stats(ng_sixlowpan_frag_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
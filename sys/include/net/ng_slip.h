@@ -11,6 +11,11 @@
  * @ingroup     net
  * @brief       Provides a SLIP interface over UART utilizing
  *              @ref driver_periph_uart.
+ *
+ * The UART interrupts only copy raw bytes between the UART and the RX and TX
+ * buffers. Decoding and encoding is done block-wise by the SLIP thread with
+ * @ref net_ng_slip_codec, and several frames can be in flight in each
+ * direction.
  * @see         <a href="https://www.ietf.org/rfc/rfc1055">RFC 1055</a>
  * @{
  *
@@ -44,18 +49,51 @@ extern "C" {
 #define NG_SLIP_BUFSIZE         (1500U)
 #endif
 
+/**
+ * @brief   Number of received frames that can wait in the RX buffer for
+ *          the SLIP thread
+ */
+#ifndef NG_SLIP_RX_QUEUE_SIZE
+#define NG_SLIP_RX_QUEUE_SIZE   (4U)
+#endif
+
+/**
+ * @brief   Number of packets that can wait for being encoded into the TX
+ *          buffer
+ */
+#ifndef NG_SLIP_TX_QUEUE_SIZE
+#define NG_SLIP_TX_QUEUE_SIZE   (4U)
+#endif
+
 /**
  * @brief   Device descriptor for SLIP devices
  */
 typedef struct {
     uart_t uart;                    /**< the UART interface */
-    ringbuffer_t *in_buf;           /**< RX buffer */
-    ringbuffer_t *out_buf;          /**< TX buffer */
+    ringbuffer_t in_buf;            /**< RX buffer, holds the undecoded bytes
+                                     *   of received frames */
+    ringbuffer_t out_buf;           /**< TX buffer, holds encoded bytes */
     char rx_mem[NG_SLIP_BUFSIZE];   /**< memory used by RX buffer */
     char tx_mem[NG_SLIP_BUFSIZE];   /**< memory used by TX buffer */
-    uint32_t in_bytes;              /**< the number of bytes received of a
+    uint16_t in_bytes;              /**< the number of bytes received of a
                                      *   currently incoming packet */
-    uint16_t in_esc;                /**< receiver is in escape mode */
+    uint8_t in_drop;                /**< the incoming packet is dropped */
+    uint8_t rx_head;                /**< first entry in ng_slip_dev_t::rx_frames */
+    uint8_t rx_num;                 /**< number of received frames */
+    /**
+     * @brief   (Undecoded) lengths of the received frames in the RX buffer
+     */
+    uint16_t rx_frames[NG_SLIP_RX_QUEUE_SIZE];
+    /**
+     * @brief   Packets waiting to be encoded into the TX buffer
+     */
+    ng_pktsnip_t *tx_queue[NG_SLIP_TX_QUEUE_SIZE];
+    uint8_t tx_head;                /**< first entry in ng_slip_dev_t::tx_queue */
+    uint8_t tx_num;                 /**< number of packets in the TX queue */
+    uint8_t tx_wait;                /**< thread waits for space in TX buffer */
+    ng_pktsnip_t *tx_snip;          /**< snip of the first packet in the TX
+                                     *   queue that is encoded next */
+    size_t tx_offset;               /**< offset in ng_slip_dev_t::tx_snip */
     kernel_pid_t slip_pid;          /**< PID of the device thread */
 } ng_slip_dev_t;
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ng_slip_codec SLIP encoding and decoding
+ * @ingroup     net_ng_slip
+ * @brief       Block-wise SLIP encoder and decoder
+ *
+ * Both directions work on whole blocks of data instead of single bytes, so
+ * they can be used on data drained from a UART FIFO or a DMA buffer. Runs of
+ * bytes that need no escaping are copied in one go.
+ * @{
+ *
+ * @file
+ * @brief       SLIP encoder and decoder definitions
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef NG_SLIP_CODEC_H_
+#define NG_SLIP_CODEC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   SLIP special characters
+ * @{
+ */
+#define NG_SLIP_END             (0xc0U)     /**< end of frame */
+#define NG_SLIP_ESC             (0xdbU)     /**< escape */
+#define NG_SLIP_END_ESC         (0xdcU)     /**< escaped END */
+#define NG_SLIP_ESC_ESC         (0xddU)     /**< escaped ESC */
+/** @} */
+
+/**
+ * @brief   State of the decoder for one frame
+ */
+typedef struct {
+    uint8_t *buf;           /**< buffer for the decoded frame */
+    size_t size;            /**< size of ng_slip_decoder_t::buf */
+    size_t len;             /**< number of decoded bytes of the frame, may be
+                             *   larger than ng_slip_decoder_t::size */
+    bool esc;               /**< the last byte was an ESC character */
+} ng_slip_decoder_t;
+
+/**
+ * @brief   Initializes a decoder for a new frame
+ *
+ * @param[out] dec      the decoder
+ * @param[in] buf       buffer for the decoded frame
+ * @param[in] size      size of @p buf
+ */
+static inline void ng_slip_decoder_init(ng_slip_decoder_t *dec, uint8_t *buf,
+                                        size_t size)
+{
+    dec->buf = buf;
+    dec->size = size;
+    dec->len = 0;
+    dec->esc = false;
+}
+
+/**
+ * @brief   Checks if the decoded frame did not fit into the decoder's buffer
+ *
+ * @param[in] dec       the decoder
+ *
+ * @return  true, if bytes of the frame were dropped
+ * @return  false, if the frame fit into the buffer
+ */
+static inline bool ng_slip_decoder_overflow(const ng_slip_decoder_t *dec)
+{
+    return (dec->len > dec->size);
+}
+
+/**
+ * @brief   Decodes a block of SLIP encoded data
+ *
+ * Decoding stops after the first END character, so the remainder of @p in
+ * belongs to the next frame. Bytes that do not fit into the buffer of @p dec
+ * are counted but dropped and invalid escape sequences are ignored.
+ *
+ * @param[in,out] dec   the decoder
+ * @param[in] in        SLIP encoded data
+ * @param[in,out] len   in: number of bytes in @p in,
+ *                      out: number of bytes consumed from @p in
+ *
+ * @return  true, if the frame was completed by an END character
+ * @return  false, if all of @p in was consumed without reaching the end of
+ *          the frame
+ */
+bool ng_slip_decode(ng_slip_decoder_t *dec, const uint8_t *in, size_t *len);
+
+/**
+ * @brief   Encodes a block of data
+ *
+ * An escape sequence is never split, so encoding stops early if the next
+ * escape sequence does not fit into @p out. The terminating END character
+ * is not added.
+ *
+ * @param[out] out      buffer for the encoded data
+ * @param[in] out_len   size of @p out
+ * @param[in] in        data to encode
+ * @param[in,out] len   in: number of bytes in @p in,
+ *                      out: number of bytes consumed from @p in
+ *
+ * @return  number of bytes written to @p out
+ */
+size_t ng_slip_encode(uint8_t *out, size_t out_len, const uint8_t *in,
+                      size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NG_SLIP_CODEC_H_ */
+/** @} */
@@ -37,6 +37,7 @@
 #include "net/ng_ipv6/addr.h"
 #include "net/ng_nettype.h"
 #include "thread.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,16 @@ extern "C" {
 #define NG_ZEP_MSG_QUEUE_SIZE   (8U)
 #endif
 
+/**
+ * @brief   Percentage of sent frames lost to simulated collisions
+ *
+ * @details If not 0, frames sent while the simulated channel is busy with a
+ *          received frame are lost as well. Use this to test MAC layers.
+ */
+#ifndef NG_ZEP_COLLISION_RATE
+#define NG_ZEP_COLLISION_RATE   (0U)
+#endif
+
 /**
  * @brief   Default addresses if the CPUID module is not present
  * @{
@@ -104,6 +115,8 @@ extern "C" {
 #define NG_ZEP_FLAGS_SRC_ADDR_LONG      (0x0002)    /**< send data using long source address */
 #define NG_ZEP_FLAGS_DST_ADDR_LONG      (0x0004)    /**< send data using long destination address */
 #define NG_ZEP_FLAGS_USE_SRC_PAN        (0x0008)    /**< do not compress source PAN ID */
+#define NG_ZEP_FLAGS_WAIT_ACK           (0x0010)    /**< last data frame is not
+                                                     *   acknowledged yet */
 /**
  * @}
  */
@@ -205,6 +218,10 @@ typedef struct {
     uint8_t chan;                   /**< the device's channel */
     uint8_t version;                /**< ZEP version to use (default 2) */
     uint8_t lqi_mode;               /**< LQI mode for send packets (default 1) */
+    uint8_t ack_seq;                /**< sequence number of the frame to be
+                                     *   acknowledged */
+    timex_t busy_until;             /**< time until the simulated channel is
+                                     *   busy */
     /**
      * @}
      */
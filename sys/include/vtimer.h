@@ -37,12 +37,27 @@ extern "C" {
  */
 #define MSG_TIMER 12345
 
+/**
+ * @brief Length of vtimer's internal tick in seconds with module vtimer_tickless
+ *
+ * Without vtimer_tickless, vtimer wakes up once per second to keep track of
+ * long-term timers. With it, the tick is stretched to this many seconds, or
+ * to what the hwtimer can represent, whichever is shorter. Timers within the
+ * current tick are scheduled directly.
+ */
+#ifndef VTIMER_TICKLESS_SECONDS
+#define VTIMER_TICKLESS_SECONDS (60U)
+#endif
+
 /**
  * @brief A vtimer object.
  *
  * This structure is used for declaring a vtimer. This should not be used by
  * programmers, use the vtimer_set_*-functions instead.
  *
+ * A vtimer_t has to be zero-initialized, e.g. with VTIMER_INIT, before it is
+ * set for the first time.
+ *
  * \hideinitializer
  */
 typedef struct vtimer_t {
@@ -60,6 +75,19 @@ typedef struct vtimer_t {
     kernel_pid_t pid;
 } vtimer_t;
 
+/**
+ * @brief Static initializer for vtimer_t.
+ */
+#define VTIMER_INIT { PRIORITY_QUEUE_NODE_INIT, { 0, 0 }, NULL, 0, NULL, KERNEL_PID_UNDEF }
+
+/**
+ * @brief vtimer statistics, e.g. to measure the number of wakeups
+ */
+typedef struct {
+    uint32_t wakeups;   /**< number of hwtimer interrupts handled */
+    uint32_t fired;     /**< number of timers fired, including vtimer's tick */
+} vtimer_stats_t;
+
 /**
  * @brief   Current system time
  * @return  Time as timex_t since system boot
@@ -107,6 +135,24 @@ int vtimer_sleep(timex_t time);
  */
 void vtimer_set_msg(vtimer_t *t, timex_t interval, kernel_pid_t pid, uint16_t type, void *ptr);
 
+/**
+ * @brief   set a vtimer with msg event handler that may fire late by up to
+ *          @p slack
+ *
+ * The timer's expiry time is moved within [interval, interval + slack], so
+ * that timers with overlapping windows share the same expiry time and are
+ * fired in one wakeup.
+ *
+ * @param[in]   t           pointer to preinitialised vtimer_t
+ * @param[in]   interval    vtimer timex_t interval
+ * @param[in]   slack       maximum time the timer may fire late
+ * @param[in]   pid         process id
+ * @param[in]   type        value for the msg_t type
+ * @param[in]   ptr         message value
+ */
+void vtimer_set_msg_with_slack(vtimer_t *t, timex_t interval, timex_t slack,
+                               kernel_pid_t pid, uint16_t type, void *ptr);
+
 /**
  * @brief   set a vtimer with wakeup event
  * @param[in]   t           pointer to preinitialised vtimer_t
@@ -116,6 +162,17 @@ void vtimer_set_msg(vtimer_t *t, timex_t interval, kernel_pid_t pid, uint16_t ty
  */
 int vtimer_set_wakeup(vtimer_t *t, timex_t interval, kernel_pid_t pid);
 
+/**
+ * @brief   set a vtimer with a callback event
+ * @note    the callback is executed in interrupt context
+ * @param[in]   t           pointer to preinitialised vtimer_t
+ * @param[in]   interval    the interval after which the timer shall fire
+ * @param[in]   cb          the function to call when the timer fires
+ * @param[in]   arg         optional argument, available as vtimer_t::arg in cb
+ * @return      0 on success, < 0 on error
+ */
+int vtimer_set_cb(vtimer_t *t, timex_t interval, void (*cb)(vtimer_t *timer), void *arg);
+
 /**
  * @brief   remove a vtimer
  * @param[in]   t           pointer to preinitialised vtimer_t
@@ -131,6 +188,12 @@ void vtimer_remove(vtimer_t *t);
  */
 int vtimer_msg_receive_timeout(msg_t *m, timex_t timeout);
 
+/**
+ * @brief   get vtimer's statistics
+ * @param[out]  out         statistics since vtimer_init()
+ */
+void vtimer_get_stats(vtimer_stats_t *out);
+
 #if ENABLE_DEBUG
 
 /**
@@ -21,6 +21,14 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the pseudo module wtimer_wheel, timers are kept in a hierarchical
+ * timing wheel instead, so insertion and removal are O(1). This costs
+ * WTIMER_WHEEL_LEVELS * WTIMER_WHEEL_SLOTS pointers of RAM, one more pointer
+ * per timer, and an additional low-level timer interrupt each time a timer
+ * is cascaded to a lower level of the wheel. Timers of the wtimer_wheel
+ * backend must not be set again while they are active, and must have been
+ * set or zero-initialized before they are removed.
+ *
  * @{
  * @file
  * @author Kaspar Schleiser <kaspar@schleiser.de>
@@ -54,6 +62,10 @@ typedef void (*timer_callback_t)(void*);
  */
 typedef struct wtimer {
     struct wtimer *next;        /**< reference to next timer in timer lists */
+#ifdef MODULE_WTIMER_WHEEL
+    struct wtimer **pprev;      /**< reference to the pointer to this timer,
+                                     NULL if the timer is not active */
+#endif
     uint32_t target;            /**< lower 32bit absolute target time */
     uint32_t long_target;       /**< upper 32bit absolute target time */
     timer_callback_t callback;  /**< callback function to call when timer expires */
@@ -189,7 +201,8 @@ void wtimer_set(wtimer_t *timer, uint32_t offset);
 /**
  * @brief remove a timer
  *
- * @note this function runs in O(n) with n being the number of active timers
+ * @note this function runs in O(n) with n being the number of active timers,
+ *       or in O(1) with the wtimer_wheel module
  *
  * @param[in] timer ptr to timer structure that will be removed
  *
@@ -247,6 +260,33 @@ int wtimer_remove(wtimer_t *timer);
 #define WTIMER_MASK 0
 #endif
 
+#ifndef WTIMER_WHEEL_BITS
+/**
+ * @brief number of bits of the target time per level of the timing wheel
+ *
+ * Only used by the wtimer_wheel module. Each level has
+ * 2^WTIMER_WHEEL_BITS slots, at most 32.
+ */
+#define WTIMER_WHEEL_BITS 4
+#endif
+
+#ifndef WTIMER_WHEEL_LEVELS
+/**
+ * @brief number of levels of the timing wheel
+ *
+ * Only used by the wtimer_wheel module. The wheel spans
+ * 2^(WTIMER_WHEEL_LEVELS * WTIMER_WHEEL_BITS) microseconds, at most 2^32.
+ * Timers further in the future are kept in a list that is scanned once per
+ * span.
+ */
+#define WTIMER_WHEEL_LEVELS 8
+#endif
+
+/**
+ * @brief number of slots per level of the timing wheel
+ */
+#define WTIMER_WHEEL_SLOTS (1 << WTIMER_WHEEL_BITS)
+
 #ifndef WTIMER_USLEEP_UNTIL_OVERHEAD
 /**
  * @brief wtimer_usleep_until overhead value
@@ -16,10 +16,12 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 #include <time.h>
 
 #include "ringbuffer.h"
+#include "checksum/crc16_ccitt.h"
 #include "hashes.h"
 #include "kernel.h"
 #include "msg.h"
@@ -45,7 +47,10 @@
 #define _EVENT_RX_STARTED       (1)
 #define _EVENT_RX_COMPLETE      (2)
 #define _RX_BUF_SIZE            (16U * sizeof(ng_pktsnip_t *))
-#define IEEE_802154_FCS_POLY    (0x8408)  /* x^16 + x^12 + x^5 + 1 for LSB first */
+
+#define _ACK_FRAME_LEN          (5U)    /* FCF, sequence number and FCS */
+#define _PHY_HDR_LEN            (6U)    /* preamble, SFD and PHR */
+#define _BYTE_AIRTIME           (32U)   /* in microseconds at 250 kbit/s */
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _rx_stack[NG_ZEP_STACK_SIZE];
@@ -81,6 +86,16 @@ static ng_pktsnip_t *_zep_hdr_build(ng_zep_t *dev, size_t size, bool ack);
 static size_t _zep_hdr_fill(ng_zep_t *dev, ng_zep_hdr_t *hdr,
                             size_t payload_len);
 
+/* Prepends UDP and IPv6 header to ZEP packet and sends it */
+static int _dispatch(ng_zep_t *dev, ng_pktsnip_t *pkt);
+
+/* Sends IEEE 802.15.4 ACK frame for sequence number */
+static void _send_ack(ng_zep_t *dev, uint8_t seq);
+
+/* Simulated channel state */
+static void _channel_busy(ng_zep_t *dev, size_t frame_len);
+static bool _channel_clear(ng_zep_t *dev);
+
 /* Event handlers for ISR events */
 static void _rx_started_event(ng_zep_t *dev);
 
@@ -88,8 +103,9 @@ static void _rx_started_event(ng_zep_t *dev);
 static size_t _make_data_frame_hdr(ng_zep_t *dev, uint8_t *buf,
                                    ng_netif_hdr_t *hdr);
 static size_t _get_frame_hdr_len(uint8_t *mhr);
+static bool _ack_requested(ng_zep_t *dev, uint8_t *mhr);
+static void _recv_ack(ng_zep_t *dev, uint8_t *frame, size_t frame_len);
 ng_pktsnip_t *_make_netif_hdr(uint8_t *mhr);
-static uint16_t _calc_fcs(uint16_t fcs, const uint8_t *frame, uint8_t frame_len);
 
 kernel_pid_t ng_zep_init(ng_zep_t *dev, uint16_t src_port, ng_ipv6_addr_t *dst,
                          uint16_t dst_port)
@@ -123,6 +139,7 @@ kernel_pid_t ng_zep_init(ng_zep_t *dev, uint16_t src_port, ng_ipv6_addr_t *dst,
     dev->chan = NG_ZEP_DEFAULT_CHANNEL;
     dev->pan = byteorder_btols(byteorder_htons(NG_ZEP_DEFAULT_PANID));
     dev->flags = NG_ZEP_FLAGS_USE_SRC_PAN;
+    dev->busy_until = timex_set(0, 0);
 #if CPUID_ID_LEN
     /* initialize dev->addr and dev->eui64 from cpuid if available */
     cpuid_get(cpuid);
@@ -208,11 +225,12 @@ static inline uint64_t *_get_uint64_ptr(void *ptr)
 static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 {
     ng_zep_t *dev = (ng_zep_t *)netdev;
-    ng_pktsnip_t *ptr, *new_pkt, *hdr;
+    ng_pktsnip_t *ptr, *new_pkt;
     ng_zep_hdr_t *zep;
     size_t payload_len = ng_pkt_len(pkt->next), hdr_len, mhr_offset;
     uint8_t mhr[NG_IEEE802154_MAX_HDR_LEN], *data;
     uint16_t fcs = 0;
+    int res;
 
     if ((netdev == NULL) || (netdev->driver != &_zep_driver)) {
         DEBUG("zep: wrong device on sending\n");
@@ -229,6 +247,16 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
         return -ENOMSG;
     }
 
+#if NG_ZEP_COLLISION_RATE
+    if (!_channel_clear(dev) ||
+        (genrand_uint32_range(0, 100) < NG_ZEP_COLLISION_RATE)) {
+        /* the radio would not notice either */
+        DEBUG("zep: frame lost in simulated collision\n");
+        ng_pktbuf_release(pkt);
+        return payload_len + hdr_len + NG_IEEE802154_FCS_LEN;
+    }
+#endif
+
     new_pkt = _zep_hdr_build(dev, hdr_len + payload_len + NG_IEEE802154_FCS_LEN, false);
 
     if (new_pkt == NULL) {
@@ -239,30 +267,6 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 
     zep = new_pkt->data;
 
-    hdr = ng_udp_hdr_build(new_pkt, (uint8_t *)(&(dev->src_port)), sizeof(uint16_t),
-                           (uint8_t *)(&(dev->dst_port)), sizeof(uint16_t));
-
-    if (hdr == NULL) {
-        DEBUG("zep: could not allocate UDP header in pktbuf\n");
-        ng_pktbuf_release(pkt);
-        ng_pktbuf_release(new_pkt);
-        return -ENOBUFS;
-    }
-
-    new_pkt = hdr;
-
-    hdr = ng_ipv6_hdr_build(new_pkt, NULL, 0, (uint8_t *) &(dev->dst),
-                            sizeof(ng_ipv6_addr_t));
-
-    if (hdr == NULL) {
-        DEBUG("zep: could not allocate IPv6 header in pktbuf\n");
-        ng_pktbuf_release(pkt);
-        ng_pktbuf_release(new_pkt);
-        return -ENOBUFS;
-    }
-
-    new_pkt = hdr;
-
     mhr_offset = _zep_hdr_fill(dev, zep, payload_len + hdr_len + NG_IEEE802154_FCS_LEN);
 
     if (mhr_offset == 0) {
@@ -274,12 +278,12 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 
     memcpy(((uint8_t *)zep) + mhr_offset, mhr, hdr_len);
 
-    fcs = _calc_fcs(fcs, ((uint8_t *)zep) + mhr_offset, hdr_len);
+    fcs = crc16_ccitt_update(fcs, ((uint8_t *)zep) + mhr_offset, hdr_len);
     data = ((uint8_t *)zep) + mhr_offset + hdr_len;
     ptr = pkt->next;
 
     while (ptr != NULL) {
-        fcs = _calc_fcs(fcs, ptr->data, ptr->size);
+        fcs = crc16_ccitt_update(fcs, ptr->data, ptr->size);
         memcpy(data, ptr->data, ptr->size);
         data += ptr->size;
         ptr = ptr->next;
@@ -290,13 +294,102 @@ static int _send(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
     DEBUG("zep: set frame FCS to 0x%04 " PRIx16 "\n", fcs);
     _set_uint16_ptr((uint16_t *)data, byteorder_btols(byteorder_htons(fcs)).u16);
 
-    if (!ng_netapi_dispatch_send(NG_NETTYPE_UDP, NG_NETREG_DEMUX_CTX_ALL, new_pkt)) {
+    res = _dispatch(dev, new_pkt);
+
+    if (res < 0) {
+        return res;
+    }
+
+    return payload_len + hdr_len + NG_IEEE802154_FCS_LEN;
+}
+
+static int _dispatch(ng_zep_t *dev, ng_pktsnip_t *pkt)
+{
+    ng_pktsnip_t *hdr;
+
+    hdr = ng_udp_hdr_build(pkt, (uint8_t *)(&(dev->src_port)), sizeof(uint16_t),
+                           (uint8_t *)(&(dev->dst_port)), sizeof(uint16_t));
+
+    if (hdr == NULL) {
+        DEBUG("zep: could not allocate UDP header in pktbuf\n");
+        ng_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+
+    pkt = hdr;
+
+    hdr = ng_ipv6_hdr_build(pkt, NULL, 0, (uint8_t *) &(dev->dst),
+                            sizeof(ng_ipv6_addr_t));
+
+    if (hdr == NULL) {
+        DEBUG("zep: could not allocate IPv6 header in pktbuf\n");
+        ng_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+
+    pkt = hdr;
+
+    if (!ng_netapi_dispatch_send(NG_NETTYPE_UDP, NG_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("zep: no UDP handler found: dropping packet\n");
-        ng_pktbuf_release(new_pkt);
+        ng_pktbuf_release(pkt);
         return -ENOENT;
     }
 
-    return payload_len + hdr_len + NG_IEEE802154_FCS_LEN;
+    return 0;
+}
+
+static void _send_ack(ng_zep_t *dev, uint8_t seq)
+{
+    ng_pktsnip_t *pkt;
+    uint8_t *frame;
+    size_t offset;
+    uint16_t fcs;
+
+    pkt = _zep_hdr_build(dev, _ACK_FRAME_LEN, false);
+
+    if (pkt == NULL) {
+        DEBUG("zep: could not allocate ACK in pktbuf\n");
+        return;
+    }
+
+    offset = _zep_hdr_fill(dev, pkt->data, _ACK_FRAME_LEN);
+
+    if (offset == 0) {
+        DEBUG("zep: error filling ZEP header\n");
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    frame = ((uint8_t *)pkt->data) + offset;
+    frame[0] = NG_IEEE802154_FCF_TYPE_ACK;
+    frame[1] = 0;
+    frame[2] = seq;
+    fcs = crc16_ccitt_calc(frame, 3);
+    frame[3] = (uint8_t)(fcs & 0xff);
+    frame[4] = (uint8_t)(fcs >> 8);
+
+    DEBUG("zep: send ACK for sequence number %" PRIu8 "\n", seq);
+    _dispatch(dev, pkt);
+}
+
+static void _channel_busy(ng_zep_t *dev, size_t frame_len)
+{
+    timex_t now;
+
+    vtimer_now(&now);
+    dev->busy_until = timex_add(now, timex_set(0, (_PHY_HDR_LEN + frame_len) *
+                                                  _BYTE_AIRTIME));
+}
+
+static bool _channel_clear(ng_zep_t *dev)
+{
+    timex_t now;
+
+    /* compare full timestamps, a difference of 32 bit microseconds would
+     * wrap after about 36 minutes */
+    vtimer_now(&now);
+
+    return (timex_cmp(now, dev->busy_until) >= 0);
 }
 
 static int _add_cb(ng_netdev_t *dev, ng_netdev_event_cb_t cb)
@@ -437,6 +530,24 @@ static int _get(ng_netdev_t *netdev, ng_netconf_opt_t opt, void *value,
             _set_flag_ptr(value, dev->flags, NG_ZEP_FLAGS_AUTOACK);
             return sizeof(uint16_t);
 
+        case NETCONF_OPT_IS_CHANNEL_CLR:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+
+            *((ng_netconf_enable_t *)value) = (_channel_clear(dev)) ?
+                                              NETCONF_ENABLE : NETCONF_DISABLE;
+            return sizeof(ng_netconf_enable_t);
+
+        case NETCONF_OPT_ACK_REPORT:
+            if (max_len < sizeof(ng_netconf_enable_t)) {
+                return -EOVERFLOW;
+            }
+
+            /* received ACKs are reported by _recv_ack() */
+            *((ng_netconf_enable_t *)value) = NETCONF_ENABLE;
+            return sizeof(ng_netconf_enable_t);
+
         default:
             return -ENOTSUP;
     }
@@ -543,8 +654,14 @@ static int _set(ng_netdev_t *netdev, ng_netconf_opt_t opt, void *value,
                 return -EOVERFLOW;
             }
 
-            _set_flag_ptr(value, dev->flags, NG_ZEP_FLAGS_AUTOACK);
-            return sizeof(uint16_t);
+            if (*((ng_netconf_enable_t *)value) == NETCONF_ENABLE) {
+                dev->flags |= NG_ZEP_FLAGS_AUTOACK;
+            }
+            else {
+                dev->flags &= ~NG_ZEP_FLAGS_AUTOACK;
+            }
+
+            return sizeof(ng_netconf_enable_t);
 
         default:
             return -ENOTSUP;
@@ -580,7 +697,10 @@ void *_event_loop(void *args)
 
     my_reg.pid = thread_getpid();
 
-    ng_netreg_register(NG_NETTYPE_UDP, &my_reg);
+    if (ng_netreg_register(NG_NETTYPE_UDP, &my_reg) < 0) {
+        DEBUG("zep: unable to register at netreg\n");
+        return NULL;
+    }
 
     while (1) {
         msg_receive(&msg);
@@ -724,7 +844,17 @@ static ng_pktsnip_t *_create_received(ng_zep_t *dev, ng_pktsnip_t *pkt,
 
     (void)version;
 
-    if ((frame_len != pkt->size) || (_calc_fcs(0, pkt->data, pkt->size) != 0)) {
+    /* the frame kept the simulated channel busy */
+    _channel_busy(dev, frame_len);
+
+    if ((frame_len != pkt->size) || (crc16_ccitt_calc(pkt->data, pkt->size) != 0)) {
+        return NULL;
+    }
+
+    if ((((uint8_t *)pkt->data)[0] & NG_IEEE802154_FCF_TYPE_MASK) ==
+        NG_IEEE802154_FCF_TYPE_ACK) {
+        _recv_ack(dev, pkt->data, pkt->size);
+        ng_pktbuf_release(pkt);
         return NULL;
     }
 
@@ -744,7 +874,9 @@ static ng_pktsnip_t *_create_received(ng_zep_t *dev, ng_pktsnip_t *pkt,
 
     mhr = ng_pktbuf_add(pkt, pkt->data, mhr_len, NG_NETTYPE_UNDEF);
 
-    /* TODO: send ACK */
+    if (_ack_requested(dev, mhr->data)) {
+        _send_ack(dev, ((uint8_t *)mhr->data)[2]);
+    }
 
     netif = _make_netif_hdr(mhr->data);
 
@@ -887,10 +1019,16 @@ static size_t _make_data_frame_hdr(ng_zep_t *dev, uint8_t *buf,
     buf[1] = 0x88;      /* use short src and dst addresses as starting point */
 
     /* if AUTOACK is enabled, then we also expect ACKs for this packet */
-    if (dev->flags & NG_ZEP_FLAGS_AUTOACK) {
+    if (!(hdr->flags & NG_NETIF_HDR_FLAGS_BROADCAST) &&
+        !(hdr->flags & NG_NETIF_HDR_FLAGS_MULTICAST) &&
+        (dev->flags & NG_ZEP_FLAGS_AUTOACK)) {
         buf[0] |= NG_IEEE802154_FCF_ACK_REQ;
     }
 
+    if (hdr->flags & NG_NETIF_HDR_FLAGS_MORE_DATA) {
+        buf[0] |= NG_IEEE802154_FCF_FRAME_PEND;
+    }
+
     /* fill in destination PAN ID */
     pos = 3;
     buf[pos++] = dev->pan.u8[0];
@@ -942,10 +1080,55 @@ static size_t _make_data_frame_hdr(ng_zep_t *dev, uint8_t *buf,
 
     /* set sequence number */
     buf[2] = dev->seq++;
+
+    if (buf[0] & NG_IEEE802154_FCF_ACK_REQ) {
+        dev->ack_seq = buf[2];
+        dev->flags |= NG_ZEP_FLAGS_WAIT_ACK;
+    }
+    else {
+        dev->flags &= ~NG_ZEP_FLAGS_WAIT_ACK;
+    }
+
     /* return actual header length */
     return pos;
 }
 
+static bool _ack_requested(ng_zep_t *dev, uint8_t *mhr)
+{
+    if (!(dev->flags & NG_ZEP_FLAGS_AUTOACK) ||
+        ((mhr[0] & NG_IEEE802154_FCF_TYPE_MASK) != NG_IEEE802154_FCF_TYPE_DATA) ||
+        !(mhr[0] & NG_IEEE802154_FCF_ACK_REQ)) {
+        return false;
+    }
+
+    /* destination address follows sequence number and destination PAN ID */
+    switch (mhr[1] & NG_IEEE802154_FCF_DST_ADDR_MASK) {
+        case NG_IEEE802154_FCF_DST_ADDR_SHORT:
+            return (memcmp(&mhr[5], &dev->addr, 2) == 0);
+
+        case NG_IEEE802154_FCF_DST_ADDR_LONG:
+            return (memcmp(&mhr[5], &dev->eui64, 8) == 0);
+
+        default:
+            return false;
+    }
+}
+
+static void _recv_ack(ng_zep_t *dev, uint8_t *frame, size_t frame_len)
+{
+    if ((frame_len != _ACK_FRAME_LEN) || !(dev->flags & NG_ZEP_FLAGS_WAIT_ACK) ||
+        (frame[2] != dev->ack_seq)) {
+        return;
+    }
+
+    DEBUG("zep: received ACK for sequence number %" PRIu8 "\n", frame[2]);
+    dev->flags &= ~NG_ZEP_FLAGS_WAIT_ACK;
+
+    if (dev->event_cb != NULL) {
+        dev->event_cb(NETDEV_EVENT_TX_ACKED, NULL);
+    }
+}
+
 static size_t _get_frame_hdr_len(uint8_t *mhr)
 {
     uint8_t tmp;
@@ -1063,24 +1246,6 @@ ng_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
     return snip;
 }
 
-static uint16_t _calc_fcs(uint16_t fcs, const uint8_t *frame, uint8_t frame_len)
-{
-    for (uint8_t byte = 0; byte < frame_len; ++byte) {
-        fcs ^= frame[byte];
-
-        for (uint8_t bit = 8; bit > 0; --bit) {
-            if (fcs & 0x0001) {
-                fcs = (fcs >> 1) ^ IEEE_802154_FCS_POLY;
-            }
-            else {
-                fcs = (fcs >> 1);
-            }
-        }
-    }
-
-    return fcs;
-}
-
 /**
  * @}
  */
@@ -37,6 +37,8 @@
 
 #include "ccnl-riot-compat.h"
 
+#include "kernel_macros.h"
+
 #define CCNL_DYNAMIC_FIB (0)
 
 static struct ccnl_interest_s *ccnl_interest_remove(struct ccnl_relay_s *ccnl,
@@ -76,7 +78,7 @@ void free_prefix(struct ccnl_prefix_s *p)
 void free_content(struct ccnl_content_s *c)
 {
     free_prefix(c->name);
-    free_2ptr_list(c->pkt, c);
+    free_3ptr_list(c->links, c->pkt, c);
 }
 
 void free_forward(struct ccnl_forward_s *fwd)
@@ -149,6 +151,137 @@ done:
     return rc;
 }
 
+// ----------------------------------------------------------------------
+// name hashing, for the content store and PIT indices
+
+#define CCNL_HASH_INIT  2166136261U // FNV-1a offset basis
+#define CCNL_HASH_PRIME 16777619U
+
+// extends the hash of a name prefix by one component (FNV-1a over the
+// component's length and bytes)
+static uint32_t ccnl_hash_comp(uint32_t h, unsigned char *comp, int len)
+{
+    int k;
+
+    h = (h ^ (uint32_t) len) * CCNL_HASH_PRIME;
+
+    for (k = 0; k < len; k++) {
+        h = (h ^ comp[k]) * CCNL_HASH_PRIME;
+    }
+
+    return h;
+}
+
+// hash of the first n components of p
+static uint32_t ccnl_prefix_hash(struct ccnl_prefix_s *p, int n)
+{
+    uint32_t h = CCNL_HASH_INIT;
+    int k;
+
+    for (k = 0; k < n; k++) {
+        h = ccnl_hash_comp(h, p->comp[k], p->complen[k]);
+    }
+
+    return h;
+}
+
+// ----------------------------------------------------------------------
+// ageing: interests, cached content, faces and FIB entries are kept on a
+// timing wheel in the slot of their expected expiry, so an ageing run only
+// checks the entries of one slot. Refreshing last_used does not move an
+// entry, it is moved on when its slot comes up and it has not expired yet.
+
+#define CCNL_AGEING_TICK_USEC TIMEOUT_TO_US(CCNL_CHECK_TIMEOUT_SEC, \
+                                            CCNL_CHECK_TIMEOUT_USEC)
+
+static const long ccnl_ageing_timeout[] = {
+    [CCNL_AGEING_INTEREST] = TIMEOUT_TO_US(CCNL_INTEREST_TIMEOUT_SEC,
+                                           CCNL_INTEREST_TIMEOUT_USEC),
+    [CCNL_AGEING_CONTENT] = TIMEOUT_TO_US(CCNL_CONTENT_TIMEOUT_SEC,
+                                          CCNL_CONTENT_TIMEOUT_USEC),
+    [CCNL_AGEING_FACE] = TIMEOUT_TO_US(CCNL_FACE_TIMEOUT_SEC,
+                                       CCNL_FACE_TIMEOUT_USEC),
+    [CCNL_AGEING_FWD] = TIMEOUT_TO_US(CCNL_FWD_TIMEOUT_SEC,
+                                      CCNL_FWD_TIMEOUT_USEC),
+};
+
+static struct timeval *ccnl_ageing_last_used(struct ccnl_ageing_s *a)
+{
+    switch (a->type) {
+        case CCNL_AGEING_INTEREST:
+            return &container_of(a, struct ccnl_interest_s, ageing)->last_used;
+        case CCNL_AGEING_CONTENT:
+            return &container_of(a, struct ccnl_content_s, ageing)->last_used;
+        case CCNL_AGEING_FACE:
+            return &container_of(a, struct ccnl_face_s, ageing)->last_used;
+        default:
+            return &container_of(a, struct ccnl_forward_s, ageing)->last_used;
+    }
+}
+
+// microseconds until the entry times out, negative if it has
+static long ccnl_ageing_left(struct ccnl_ageing_s *a, struct timeval *now)
+{
+    return timevaldelta(ccnl_ageing_last_used(a), now) +
+           ccnl_ageing_timeout[a->type];
+}
+
+static void ccnl_ageing_schedule(struct ccnl_relay_s *ccnl,
+                                 struct ccnl_ageing_s *a, struct timeval *now)
+{
+    long ticks = (ccnl_ageing_left(a, now) + CCNL_AGEING_TICK_USEC - 1) /
+                 CCNL_AGEING_TICK_USEC;
+    int slot;
+
+    if (ticks < 1) {
+        ticks = 1;
+    }
+    else if (ticks > CCNL_AGEING_WHEEL_SIZE - 1) {
+        ticks = CCNL_AGEING_WHEEL_SIZE - 1;
+    }
+
+    slot = (ccnl->ageing_pos + ticks) % CCNL_AGEING_WHEEL_SIZE;
+    a->slot = slot + 1;
+    a->prev = NULL;
+    a->next = ccnl->ageing_wheel[slot];
+    if (a->next) {
+        a->next->prev = a;
+    }
+    ccnl->ageing_wheel[slot] = a;
+    ccnl->ageing_stats.scheduled++;
+}
+
+static void ccnl_ageing_add(struct ccnl_relay_s *ccnl, struct ccnl_ageing_s *a,
+                            int type)
+{
+    struct timeval now;
+
+    ccnl_get_timeval(&now);
+    a->type = type;
+    ccnl_ageing_schedule(ccnl, a, &now);
+}
+
+static void ccnl_ageing_remove(struct ccnl_relay_s *ccnl,
+                               struct ccnl_ageing_s *a)
+{
+    if (!a->slot) {
+        return;
+    }
+
+    if (a->prev) {
+        a->prev->next = a->next;
+    }
+    else {
+        ccnl->ageing_wheel[a->slot - 1] = a->next;
+    }
+    if (a->next) {
+        a->next->prev = a->prev;
+    }
+
+    a->slot = 0;
+    ccnl->ageing_stats.scheduled--;
+}
+
 // ----------------------------------------------------------------------
 // ccnb parsing support
 
@@ -210,31 +343,29 @@ static int data2uint(unsigned char *cp, int len)
     return val;
 }
 
-struct ccnl_nonce_s *ccnl_nonce_new(struct ccnl_buf_s *that)
-{
-    struct ccnl_nonce_s *n = (struct ccnl_nonce_s *) ccnl_malloc(sizeof(struct ccnl_nonce_s));
-
-    n->buf = buf_dup(that);
-    ccnl_get_timeval(&n->created);
-
-    n->next = NULL;
-    n->prev = NULL;
-
-    return n;
-}
+#if CCNL_MAX_NONCES > 0xFFFF
+#error "ccnl: the nonce cache uses 16 bit indices"
+#endif
 
-struct ccnl_nonce_s *ccnl_nonce_remove(struct ccnl_relay_s *ccnl, struct ccnl_nonce_s *nonce)
+// drops the oldest nonce from the FIFO ring and its hash bucket
+static void ccnl_nonce_remove_oldest(struct ccnl_relay_s *ccnl)
 {
-    DEBUGMSG(99, "ccnl_nonce_remove: %u:%u:%u:%u\n",
-             nonce->buf->data[0], nonce->buf->data[1], nonce->buf->data[2], nonce->buf->data[3]);
+    struct ccnl_nonce_s *n = ccnl->nonces + ccnl->nonce_first;
+    uint16_t *pn = &ccnl->nonce_hash[n->hash % CCNL_NONCE_HASH_SIZE];
 
-    struct ccnl_nonce_s *next = nonce->next;
-    DBL_LINKED_LIST_REMOVE(ccnl->nonces, nonce);
+    DEBUGMSG(99, "ccnl_nonce_remove_oldest: %u:%u:%u:%u\n",
+             n->data[0], n->data[1], n->data[2], n->data[3]);
 
-    free(nonce->buf);
-    free(nonce);
+    // new nonces are put in front, so the oldest one is usually last
+    while (*pn != ccnl->nonce_first + 1) {
+        pn = &ccnl->nonces[*pn - 1].hnext;
+    }
 
-    return next;
+    *pn = n->hnext;
+    ccnl_free(n->buf);
+    n->buf = NULL;
+    ccnl->nonce_first = (ccnl->nonce_first + 1) % CCNL_MAX_NONCES;
+    ccnl->nonce_cnt--;
 }
 
 struct ccnl_buf_s *
@@ -472,6 +603,7 @@ ccnl_get_face_or_create(struct ccnl_relay_s *ccnl, int ifndx, uint16_t sender_id
 
     ccnl_get_timeval(&f->last_used);
     DBL_LINKED_LIST_ADD(ccnl->faces, f);
+    ccnl_ageing_add(ccnl, &f->ageing, CCNL_AGEING_FACE);
 
     return f;
 }
@@ -537,6 +669,7 @@ ccnl_face_remove(struct ccnl_relay_s *ccnl, struct ccnl_face_s *f)
 
     f2 = f->next;
     DBL_LINKED_LIST_REMOVE(ccnl->faces, f);
+    ccnl_ageing_remove(ccnl, &f->ageing);
     ccnl_free(f);
     return f2;
 }
@@ -721,35 +854,58 @@ int ccnl_face_enqueue(struct ccnl_relay_s *ccnl, struct ccnl_face_s *to,
 int ccnl_nonce_find_or_append(struct ccnl_relay_s *ccnl,
                               struct ccnl_buf_s *nonce)
 {
-    struct ccnl_nonce_s *n, *last;
-    int i;
+    struct ccnl_nonce_s *n;
+    struct ccnl_buf_s *buf = NULL;
+    int len = nonce->datalen;
+    uint32_t h = ccnl_hash_comp(CCNL_HASH_INIT, nonce->data, len);
+    uint16_t *bucket = &ccnl->nonce_hash[h % CCNL_NONCE_HASH_SIZE];
+    uint16_t k;
     DEBUGMSG(99, "ccnl_nonce_find_or_append: %u:%u:%u:%u\n",
              nonce->data[0], nonce->data[1], nonce->data[2], nonce->data[3]);
 
-    /* test for noce in nonce cache */
+    /* test for nonce in nonce cache */
+    for (k = *bucket; k; k = n->hnext) {
+        n = ccnl->nonces + k - 1;
 
-    for (n = ccnl->nonces, i = 0; n; n = n->next, i++) {
-        DEBUGMSG(1, "known: %u:%u:%u:%u\n",
-                 n->buf->data[0], n->buf->data[1], n->buf->data[2], n->buf->data[3]);
-        if (buf_equal(n->buf, nonce)) {
+        if (n->hash == h && n->len == len &&
+            !memcmp(n->buf ? n->buf->data : n->data, nonce->data, len)) {
             /* nonce in cache -> known */
             return -1;
         }
-        if (n->next) {
-            last = n->next;
+    }
+
+    /* long nonces do not fit into the cache entry, keep a copy */
+    if (len > CCNL_NONCE_MAX_LEN) {
+        buf = ccnl_buf_new(nonce->data, len);
+
+        if (!buf) {
+            /* can not remember it, so treat it as new */
+            return 0;
         }
     }
 
+    /* nonce cache full? drop oldest nonce */
+    if (ccnl->nonce_cnt >= CCNL_MAX_NONCES) {
+        ccnl_nonce_remove_oldest(ccnl);
+        bucket = &ccnl->nonce_hash[h % CCNL_NONCE_HASH_SIZE];
+    }
+
     /* nonce not in local cache, add it */
-    n = ccnl_nonce_new(nonce);
-    DBL_LINKED_LIST_ADD(ccnl->nonces, n);
+    k = (ccnl->nonce_first + ccnl->nonce_cnt) % CCNL_MAX_NONCES;
+    n = ccnl->nonces + k;
+    n->len = len;
+    n->buf = buf;
 
-    /* nonce chache full? */
-    if (i >= CCNL_MAX_NONCES) {
-        /* cache is full, drop oldest nonce: its the last element in the list */
-        ccnl_nonce_remove(ccnl, last);
+    if (!buf) {
+        memcpy(n->data, nonce->data, len);
     }
 
+    n->hash = h;
+    ccnl_get_timeval(&n->created);
+    n->hnext = *bucket;
+    *bucket = k + 1;
+    ccnl->nonce_cnt++;
+
     return 0;
 }
 
@@ -778,9 +934,37 @@ ccnl_interest_new(struct ccnl_relay_s *ccnl, struct ccnl_face_s *from,
     i->maxsuffix = maxsuffix;
     ccnl_get_timeval(&i->last_used);
     DBL_LINKED_LIST_ADD(ccnl->pit, i);
+    ccnl_ageing_add(ccnl, &i->ageing, CCNL_AGEING_INTEREST);
+
+    i->hash = ccnl_prefix_hash(i->prefix, i->prefix->compcnt);
+    i->hprev = NULL;
+    i->hnext = ccnl->pit_hash[i->hash % CCNL_PIT_HASH_SIZE];
+    if (i->hnext) {
+        i->hnext->hprev = i;
+    }
+    ccnl->pit_hash[i->hash % CCNL_PIT_HASH_SIZE] = i;
+
     return i;
 }
 
+struct ccnl_interest_s *
+ccnl_interest_find(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *prefix,
+                   struct ccnl_buf_s *ppkd, int minsuffix, int maxsuffix)
+{
+    uint32_t h = ccnl_prefix_hash(prefix, prefix->compcnt);
+    struct ccnl_interest_s *i;
+
+    for (i = ccnl->pit_hash[h % CCNL_PIT_HASH_SIZE]; i; i = i->hnext) {
+        if (i->hash == h && !ccnl_prefix_cmp(i->prefix, NULL, prefix, CMP_EXACT)
+            && i->minsuffix == minsuffix && i->maxsuffix == maxsuffix
+            && ((!ppkd && !i->ppkd) || buf_equal(ppkd, i->ppkd))) {
+            return i;
+        }
+    }
+
+    return NULL;
+}
+
 int ccnl_interest_append_pending(struct ccnl_interest_s *i,
                                  struct ccnl_face_s *from)
 {
@@ -876,6 +1060,18 @@ ccnl_interest_remove(struct ccnl_relay_s *ccnl, struct ccnl_interest_s *i)
 
     i2 = i->next;
     DBL_LINKED_LIST_REMOVE(ccnl->pit, i);
+    ccnl_ageing_remove(ccnl, &i->ageing);
+
+    if (i->hprev) {
+        i->hprev->hnext = i->hnext;
+    }
+    else {
+        ccnl->pit_hash[i->hash % CCNL_PIT_HASH_SIZE] = i->hnext;
+    }
+    if (i->hnext) {
+        i->hnext->hprev = i->hprev;
+    }
+
     free_prefix(i->prefix);
     free_3ptr_list(i->ppkd, i->pkt, i);
     return i2;
@@ -947,19 +1143,153 @@ ccnl_content_new(struct ccnl_relay_s *ccnl, struct ccnl_buf_s **pkt,
     return c;
 }
 
+// returns the index node of the name prefix with the given hash and length,
+// creating it if requested
+static struct ccnl_cs_node_s *
+ccnl_cs_node_get(struct ccnl_relay_s *ccnl, uint32_t h, int compcnt, int create)
+{
+    struct ccnl_cs_node_s **bucket = &ccnl->content_hash[h % CCNL_CONTENT_HASH_SIZE];
+    struct ccnl_cs_node_s *n;
+
+    for (n = *bucket; n; n = n->next) {
+        if (n->hash == h && n->compcnt == compcnt) {
+            return n;
+        }
+    }
+
+    if (!create) {
+        return NULL;
+    }
+
+    n = (struct ccnl_cs_node_s *) ccnl_calloc(1, sizeof(struct ccnl_cs_node_s));
+
+    if (n) {
+        n->hash = h;
+        n->compcnt = compcnt;
+        n->next = *bucket;
+        *bucket = n;
+    }
+
+    return n;
+}
+
+static void ccnl_cs_node_unlink(struct ccnl_relay_s *ccnl,
+                                struct ccnl_content_link_s *l)
+{
+    struct ccnl_cs_node_s *n = l->node, **pn;
+
+    if (l->prev) {
+        l->prev->next = l->next;
+    }
+    else if (n->exact == l) {
+        n->exact = l->next;
+    }
+    else {
+        n->longer = l->next;
+    }
+
+    if (l->next) {
+        l->next->prev = l->prev;
+    }
+
+    if (n->exact || n->longer) {
+        return;
+    }
+
+    // last content with this prefix is gone
+    for (pn = &ccnl->content_hash[n->hash % CCNL_CONTENT_HASH_SIZE]; *pn != n;
+         pn = &(*pn)->next) {
+    }
+
+    *pn = n->next;
+    ccnl_free(n);
+}
+
 struct ccnl_content_s *
 ccnl_content_remove(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 {
     struct ccnl_content_s *c2;
+    int k;
     DEBUGMSG(99, "ccnl_content_remove: %s\n", ccnl_prefix_to_path(c->name));
 
     c2 = c->next;
+    if (ccnl->contentsend == c) {
+        ccnl->contentsend = c->prev;
+    }
     DBL_LINKED_LIST_REMOVE(ccnl->contents, c);
+    ccnl_ageing_remove(ccnl, &c->ageing);
+
+    for (k = 0; c->links && k < c->name->compcnt; k++) {
+        ccnl_cs_node_unlink(ccnl, c->links + k);
+    }
+
     free_content(c);
     ccnl->contentcnt--;
     return c2;
 }
 
+// marks c as most recently used
+static void ccnl_content_touch(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
+{
+    ccnl_get_timeval(&c->last_used);
+
+    if (ccnl->contents == c) {
+        return;
+    }
+
+    if (ccnl->contentsend == c) {
+        ccnl->contentsend = c->prev;
+    }
+    DBL_LINKED_LIST_REMOVE(ccnl->contents, c);
+    c->prev = NULL;
+    DBL_LINKED_LIST_ADD(ccnl->contents, c);
+}
+
+// lists c under all prefixes of its name
+static int ccnl_content_index(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
+{
+    uint32_t h = CCNL_HASH_INIT;
+    int k;
+
+    if (c->name->compcnt == 0) {
+        return 0;
+    }
+
+    c->links = (struct ccnl_content_link_s *) ccnl_calloc(c->name->compcnt,
+               sizeof(struct ccnl_content_link_s));
+
+    if (!c->links) {
+        return -1;
+    }
+
+    for (k = 0; k < c->name->compcnt; k++) {
+        struct ccnl_content_link_s *l = c->links + k, **list;
+
+        h = ccnl_hash_comp(h, c->name->comp[k], c->name->complen[k]);
+        l->c = c;
+        l->node = ccnl_cs_node_get(ccnl, h, k + 1, 1);
+
+        if (!l->node) {
+            while (k-- > 0) {
+                ccnl_cs_node_unlink(ccnl, c->links + k);
+            }
+
+            ccnl_free(c->links);
+            c->links = NULL;
+            return -1;
+        }
+
+        list = (k == c->name->compcnt - 1) ? &l->node->exact : &l->node->longer;
+        l->next = *list;
+        if (l->next) {
+            l->next->prev = l;
+        }
+        *list = l;
+    }
+
+    return 0;
+}
+
 struct ccnl_content_s *
 ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 {
@@ -973,14 +1303,10 @@ ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
 
     while (ccnl->max_cache_entries <= ccnl->contentcnt) {
         DEBUGMSG(1, "  remove Least Recently Used content...\n");
-        struct ccnl_content_s *c2, *lru = NULL;
+        struct ccnl_content_s *lru = ccnl->contentsend;
 
-        for (c2 = ccnl->contents; c2; c2 = c2->next) {
-            DEBUGMSG(1, "    '%s' -> %ld:%ld\n", ccnl_prefix_to_path(c2->name), c2->last_used.tv_sec, c2->last_used.tv_usec);
-            if (!(c2->flags & CCNL_CONTENT_FLAGS_STATIC)
-                && ((!lru) || timevaldelta(&c2->last_used, &lru->last_used) < 0)) {
-                lru = c2;
-            }
+        while (lru && (lru->flags & CCNL_CONTENT_FLAGS_STATIC)) {
+            lru = lru->prev;
         }
 
         if (lru) {
@@ -993,12 +1319,184 @@ ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c)
         }
     }
 
+    if (ccnl_content_index(ccnl, c) < 0) {
+        DEBUGMSG(1, "  can't get memory for content index\n");
+        return NULL;
+    }
+
     DEBUGMSG(1, "  add new content to store: '%s'\n", ccnl_prefix_to_path(c->name));
+    c->prev = NULL;
     DBL_LINKED_LIST_ADD(ccnl->contents, c);
+    if (!ccnl->contentsend) {
+        ccnl->contentsend = c;
+    }
+    ccnl_ageing_add(ccnl, &c->ageing, CCNL_AGEING_CONTENT);
+
     ccnl->contentcnt++;
     return c;
 }
 
+static struct ccnl_content_s *
+ccnl_content_find_in_list(struct ccnl_content_link_s *l,
+                          struct ccnl_prefix_s *prefix, struct ccnl_buf_s *ppkd,
+                          int minsuffix, int maxsuffix)
+{
+    for (; l; l = l->next) {
+        if (ccnl_i_prefixof_c(prefix, ppkd, minsuffix, maxsuffix, l->c)) {
+            return l->c;
+        }
+    }
+
+    return NULL;
+}
+
+// returns cached content matching the interest and marks it as used
+struct ccnl_content_s *
+ccnl_content_find(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *prefix,
+                  struct ccnl_buf_s *ppkd, int minsuffix, int maxsuffix)
+{
+    struct ccnl_content_s *c = NULL;
+    struct ccnl_cs_node_s *n;
+    int last = prefix->compcnt - 1;
+    uint32_t h;
+
+    if (prefix->compcnt == 0) {
+        // every name matches the empty prefix
+        for (c = ccnl->contents; c; c = c->next) {
+            if (ccnl_i_prefixof_c(prefix, ppkd, minsuffix, maxsuffix, c)) {
+                break;
+            }
+        }
+    }
+    else {
+        h = ccnl_prefix_hash(prefix, last);
+
+        if (last > 0 && prefix->complen[last] == 32) { // SHA256_DIGEST_LEN
+            // the last component may be the content's implicit digest
+            n = ccnl_cs_node_get(ccnl, h, last, 0);
+            c = n ? ccnl_content_find_in_list(n->exact, prefix, ppkd,
+                                              minsuffix, maxsuffix) : NULL;
+        }
+
+        if (!c) {
+            h = ccnl_hash_comp(h, prefix->comp[last], prefix->complen[last]);
+            n = ccnl_cs_node_get(ccnl, h, prefix->compcnt, 0);
+
+            if (n) {
+                c = ccnl_content_find_in_list(n->exact, prefix, ppkd,
+                                              minsuffix, maxsuffix);
+                if (!c) {
+                    c = ccnl_content_find_in_list(n->longer, prefix, ppkd,
+                                                  minsuffix, maxsuffix);
+                }
+            }
+        }
+    }
+
+    if (c) {
+        ccnl_content_touch(ccnl, c);
+    }
+
+    return c;
+}
+
+// returns cached content with the given name and packet
+static struct ccnl_content_s *
+ccnl_content_find_dup(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *name,
+                      struct ccnl_buf_s *pkt)
+{
+    struct ccnl_cs_node_s *n;
+    struct ccnl_content_link_s *l;
+
+    if (name->compcnt == 0) {
+        struct ccnl_content_s *c;
+
+        for (c = ccnl->contents; c; c = c->next) {
+            if (buf_equal(c->pkt, pkt)) {
+                return c;
+            }
+        }
+
+        return NULL;
+    }
+
+    n = ccnl_cs_node_get(ccnl, ccnl_prefix_hash(name, name->compcnt),
+                         name->compcnt, 0);
+
+    for (l = n ? n->exact : NULL; l; l = l->next) {
+        if (buf_equal(l->c->pkt, pkt)) {
+            return l->c;
+        }
+    }
+
+    return NULL;
+}
+
+// deliver content c to all faces of interest i, but only one copy per face
+// returns: number of forwards
+static int ccnl_content_serve_interest(struct ccnl_relay_s *ccnl,
+                                       struct ccnl_content_s *c,
+                                       struct ccnl_face_s *from,
+                                       struct ccnl_interest_s *i)
+{
+    struct ccnl_pendint_s *pi;
+    int cnt = 0;
+
+    // CONFORM: "Data MUST only be transmitted in response to
+    // an Interest that matches the Data."
+    for (pi = i->pending; pi; pi = pi->next) {
+        if (pi->face->flags & CCNL_FACE_FLAGS_SERVED) {
+            continue;
+        }
+
+        if (pi->face == from) {
+            // the existing pending interest is from the same face
+            // as the newly arrived content is...no need to send content back
+            DEBUGMSG(1, "  detected looping content, before loop could happen\n");
+            continue;
+        }
+
+        pi->face->flags |= CCNL_FACE_FLAGS_SERVED;
+
+        DEBUGMSG(6, "  forwarding content <%s>\n",
+                 ccnl_prefix_to_path(c->name));
+        pi->face->stat.send_content[c->served_cnt % CCNL_MAX_CONTENT_SERVED_STAT]++;
+        ccnl_face_enqueue(ccnl, pi->face, buf_dup(c->pkt));
+
+        c->served_cnt++;
+        ccnl_get_timeval(&c->last_used);
+        cnt++;
+    }
+
+    return cnt;
+}
+
+// serve and remove all interests with the given prefix hash and length
+// matching content c
+static int ccnl_content_serve_bucket(struct ccnl_relay_s *ccnl,
+                                     struct ccnl_content_s *c,
+                                     struct ccnl_face_s *from,
+                                     uint32_t h, int compcnt)
+{
+    struct ccnl_interest_s *i, *next;
+    int cnt = 0;
+
+    for (i = ccnl->pit_hash[h % CCNL_PIT_HASH_SIZE]; i; i = next) {
+        next = i->hnext;
+
+        if (i->hash != h || i->prefix->compcnt != compcnt
+            || !ccnl_i_prefixof_c(i->prefix, i->ppkd, i->minsuffix,
+                                  i->maxsuffix, c)) {
+            continue;
+        }
+
+        cnt += ccnl_content_serve_interest(ccnl, c, from, i);
+        ccnl_interest_remove(ccnl, i);
+    }
+
+    return cnt;
+}
+
 // deliver new content c to all clients with (loosely) matching interest,
 // but only one copy per face
 // returns: number of forwards
@@ -1006,51 +1504,27 @@ int ccnl_content_serve_pending(struct ccnl_relay_s *ccnl,
                                struct ccnl_content_s *c,
                                struct ccnl_face_s *from)
 {
-    struct ccnl_interest_s *i;
     struct ccnl_face_s *f;
-    int cnt = 0;
+    uint32_t h = CCNL_HASH_INIT;
+    int k, cnt = 0;
     DEBUGMSG(99, "ccnl_content_serve_pending\n");
 
     for (f = ccnl->faces; f; f = f->next) {
         f->flags &= ~CCNL_FACE_FLAGS_SERVED;    // reply on a face only once
     }
 
-    for (i = ccnl->pit; i;) {
-        struct ccnl_pendint_s *pi;
-
-        if (!ccnl_i_prefixof_c(i->prefix, i->ppkd, i->minsuffix, i->maxsuffix,
-                               c)) {
-            i = i->next;
-            continue;
-        }
-
-        // CONFORM: "Data MUST only be transmitted in response to
-        // an Interest that matches the Data."
-        for (pi = i->pending; pi; pi = pi->next) {
-            if (pi->face->flags & CCNL_FACE_FLAGS_SERVED) {
-                continue;
-            }
-
-            if (pi->face == from) {
-                // the existing pending interest is from the same face
-                // as the newly arrived content is...no need to send content back
-                DEBUGMSG(1, "  detected looping content, before loop could happen\n");
-                continue;
-            }
+    // matching interests name a prefix of c's name...
+    cnt += ccnl_content_serve_bucket(ccnl, c, from, h, 0);
 
-            pi->face->flags |= CCNL_FACE_FLAGS_SERVED;
-
-            DEBUGMSG(6, "  forwarding content <%s>\n",
-                     ccnl_prefix_to_path(c->name));
-            pi->face->stat.send_content[c->served_cnt % CCNL_MAX_CONTENT_SERVED_STAT]++;
-            ccnl_face_enqueue(ccnl, pi->face, buf_dup(c->pkt));
-
-            c->served_cnt++;
-            ccnl_get_timeval(&c->last_used);
-            cnt++;
-        }
+    for (k = 0; k < c->name->compcnt; k++) {
+        h = ccnl_hash_comp(h, c->name->comp[k], c->name->complen[k]);
+        cnt += ccnl_content_serve_bucket(ccnl, c, from, h, k + 1);
+    }
 
-        i = ccnl_interest_remove(ccnl, i);
+    // ...or its full name including the implicit digest
+    if (ccnl->pit) {
+        h = ccnl_hash_comp(h, compute_ccnx_digest(c->pkt), 32); // SHA256_DIGEST_LEN
+        cnt += ccnl_content_serve_bucket(ccnl, c, from, h, c->name->compcnt + 1);
     }
 
     return cnt;
@@ -1107,6 +1581,7 @@ void ccnl_content_learn_name_route(struct ccnl_relay_s *ccnl, struct ccnl_prefix
         /* create a new fib entry */
         fwd = ccnl_forward_new(p, f, threshold_prefix, flags);
         DBL_LINKED_LIST_ADD(ccnl->fib, fwd);
+        ccnl_ageing_add(ccnl, &fwd->ageing, CCNL_AGEING_FWD);
         DEBUGMSG(999, "ccnl_content_learn_name_route: new route '%s' on face %d learned\n", ccnl_prefix_to_path(fwd->prefix), f->faceid);
     }
     else {
@@ -1115,11 +1590,12 @@ void ccnl_content_learn_name_route(struct ccnl_relay_s *ccnl, struct ccnl_prefix
         /* if the new entry has shorter prefix */
         if (p->compcnt < fwd->prefix->compcnt) {
             /* we need to aggregate! */
-            DBL_LINKED_LIST_REMOVE(ccnl->fib, fwd);
+            ccnl_forward_remove(ccnl, fwd);
 
             /* create a new fib entry */
             fwd = ccnl_forward_new(p, f, (p->compcnt - match_len), flags);
             DBL_LINKED_LIST_ADD(ccnl->fib, fwd);
+            ccnl_ageing_add(ccnl, &fwd->ageing, CCNL_AGEING_FWD);
             DEBUGMSG(999, "ccnl_content_learn_name_route: route '%s' on face %d replaced\n", ccnl_prefix_to_path(fwd->prefix), f->faceid);
         }
         else {
@@ -1140,6 +1616,7 @@ ccnl_forward_remove(struct ccnl_relay_s *ccnl, struct ccnl_forward_s *fwd)
 
     fwd2 = fwd->next;
     DBL_LINKED_LIST_REMOVE(ccnl->fib, fwd);
+    ccnl_ageing_remove(ccnl, &fwd->ageing);
 
     for (struct ccnl_interest_s *p = ccnl->pit; p; p = p->next) {
         if (p->forwarded_over == fwd) {
@@ -1198,12 +1675,57 @@ void ccnl_do_nonce_timeout(void *ptr, void *dummy)
     ccnl_get_timeval(&now);
     //DEBUGMSG(99, "ccnl_do_nonce_timeout: %lu:%lu\n", now.tv_sec, now.tv_usec);
 
-    for (struct ccnl_nonce_s *n = relay->nonces; n;) {
-        if (ccnl_is_timed_out(&now, &n->created, CCNL_NONCE_TIMEOUT_SEC, CCNL_NONCE_TIMEOUT_USEC)) {
-            n = ccnl_nonce_remove(relay, n);
-        } else {
-            n = n->next;
-        }
+    // the ring is ordered by age, so only expired nonces are visited
+    while (relay->nonce_cnt &&
+           ccnl_is_timed_out(&now, &relay->nonces[relay->nonce_first].created,
+                             CCNL_NONCE_TIMEOUT_SEC, CCNL_NONCE_TIMEOUT_USEC)) {
+        ccnl_nonce_remove_oldest(relay);
+    }
+}
+
+// removes an entry that timed out
+static void ccnl_ageing_expire(struct ccnl_relay_s *relay,
+                               struct ccnl_ageing_s *a)
+{
+    struct ccnl_interest_s *i;
+
+    switch (a->type) {
+        case CCNL_AGEING_INTEREST:
+            i = container_of(a, struct ccnl_interest_s, ageing);
+            if (i->from && i->from->ifndx == RIOT_MSG_IDX) {
+                /* this interest was requested by an app from this node */
+                /* inform this app about this problem */
+                riot_send_nack(i->from->faceid);
+            }
+            ccnl_interest_remove(relay, i);
+            break;
+        case CCNL_AGEING_CONTENT:
+            ccnl_content_remove(relay, container_of(a, struct ccnl_content_s, ageing));
+            break;
+        case CCNL_AGEING_FACE:
+            ccnl_face_remove(relay, container_of(a, struct ccnl_face_s, ageing));
+            break;
+        default:
+            ccnl_forward_remove(relay, container_of(a, struct ccnl_forward_s, ageing));
+            break;
+    }
+}
+
+// static entries never expire and are dropped from the wheel
+static int ccnl_ageing_is_static(struct ccnl_ageing_s *a)
+{
+    switch (a->type) {
+        case CCNL_AGEING_CONTENT:
+            return container_of(a, struct ccnl_content_s, ageing)->flags &
+                   CCNL_CONTENT_FLAGS_STATIC;
+        case CCNL_AGEING_FACE:
+            return container_of(a, struct ccnl_face_s, ageing)->flags &
+                   CCNL_FACE_FLAGS_STATIC;
+        case CCNL_AGEING_FWD:
+            return container_of(a, struct ccnl_forward_s, ageing)->flags &
+                   CCNL_FORWARD_FLAGS_STATIC;
+        default:
+            return 0;
     }
 }
 
@@ -1213,59 +1735,42 @@ void ccnl_do_ageing(void *ptr, void *dummy)
     (void) dummy; /* unused */
 
     struct ccnl_relay_s *relay = (struct ccnl_relay_s *) ptr;
-    struct ccnl_interest_s *i = relay->pit;
-    struct ccnl_content_s *c = relay->contents;
-
-    struct ccnl_face_s *f = relay->faces;
+    struct ccnl_ageing_stats_s *stats = &relay->ageing_stats;
+    struct ccnl_ageing_s *a;
     struct timeval now;
     ccnl_get_timeval(&now);
-    //DEBUGMSG(999, "ccnl_do_ageing %ld:%ld\n", now.tv_sec, now.tv_usec);
 
-    while (i) {
-        if (ccnl_is_timed_out(&now, &i->last_used, CCNL_INTEREST_TIMEOUT_SEC,
-                CCNL_INTEREST_TIMEOUT_USEC)) {
-            if (i->from->ifndx == RIOT_MSG_IDX) {
-                /* this interest was requested by an app from this node */
-                /* inform this app about this problem */
-                riot_send_nack(i->from->faceid);
-            }
-            i = ccnl_interest_remove(relay, i);
-        }
-        else {
-            i = i->next;
-        }
-    }
+    relay->ageing_pos = (relay->ageing_pos + 1) % CCNL_AGEING_WHEEL_SIZE;
+    stats->checked = 0;
+    stats->expired = 0;
 
-    while (c) {
-        if (ccnl_is_timed_out(&now, &c->last_used, CCNL_CONTENT_TIMEOUT_SEC, CCNL_CONTENT_TIMEOUT_USEC)
-            && !(c->flags & CCNL_CONTENT_FLAGS_STATIC)) {
-            c = ccnl_content_remove(relay, c);
-        }
-        else {
-            c = c->next;
+    // expiring an entry may remove others of the same slot (e.g. the
+    // interests of a face), so always continue with the slot's head
+    while ((a = relay->ageing_wheel[relay->ageing_pos])) {
+        ccnl_ageing_remove(relay, a);
+        stats->checked++;
+
+        if (ccnl_ageing_is_static(a)) {
+            continue;
         }
-    }
 
-    while (f) {
-        if (!(f->flags & CCNL_FACE_FLAGS_STATIC)
-            && ccnl_is_timed_out(&now, &f->last_used, CCNL_FACE_TIMEOUT_SEC, CCNL_FACE_TIMEOUT_USEC)) {
-            f = ccnl_face_remove(relay, f);
+        if (ccnl_ageing_left(a, &now) < 0) {
+            stats->expired++;
+            ccnl_ageing_expire(relay, a);
         }
         else {
-            f = f->next;
+            ccnl_ageing_schedule(relay, a, &now);
         }
     }
 
-    struct ccnl_forward_s *fwd = relay->fib;
-    while (fwd) {
-        if (!(fwd->flags & CCNL_FORWARD_FLAGS_STATIC)
-            && ccnl_is_timed_out(&now, &fwd->last_used, CCNL_FWD_TIMEOUT_SEC, CCNL_FWD_TIMEOUT_USEC)) {
-            fwd = ccnl_forward_remove(relay, fwd);
-        }
-        else {
-            fwd = fwd->next;
-        }
+    stats->ticks++;
+    if (stats->checked > stats->checked_max) {
+        stats->checked_max = stats->checked;
     }
+
+    DEBUGMSG(99, "ccnl_do_ageing: tick %lu checked %u expired %u (max %u, "
+             "%u scheduled)\n", stats->ticks, stats->checked, stats->expired,
+             stats->checked_max, stats->scheduled);
 }
 
 void ccnl_core_cleanup(struct ccnl_relay_s *ccnl)
@@ -1285,8 +1790,8 @@ void ccnl_core_cleanup(struct ccnl_relay_s *ccnl)
         ccnl_content_remove(ccnl, ccnl->contents);
     }
 
-    while (ccnl->nonces) {
-        ccnl_nonce_remove(ccnl, ccnl->nonces);
+    while (ccnl->nonce_cnt) {
+        ccnl_nonce_remove_oldest(ccnl);
     }
 
     for (k = 0; k < ccnl->ifcount; k++) {
@@ -1339,11 +1844,9 @@ int ccnl_core_RX_i_or_c(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
 
         // CONFORM: Step 1:
         if (aok & 0x01) { // honor "answer-from-existing-content-store" flag
-            for (c = relay->contents; c; c = c->next) {
-                if (!ccnl_i_prefixof_c(p, ppkd, minsfx, maxsfx, c)) {
-                    continue;
-                }
+            c = ccnl_content_find(relay, p, ppkd, minsfx, maxsfx);
 
+            if (c) {
                 // FIXME: should check stale bit in aok here
                 DEBUGMSG(7, "  matching content for interest, content %p\n",
                          (void *) c);
@@ -1359,13 +1862,7 @@ int ccnl_core_RX_i_or_c(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
         }
 
         // CONFORM: Step 2: check whether interest is already known
-        for (i = relay->pit; i; i = i->next) {
-            if (!ccnl_prefix_cmp(i->prefix, NULL, p, CMP_EXACT)
-                && i->minsuffix == minsfx && i->maxsuffix == maxsfx
-                && ((!ppkd && !i->ppkd) || buf_equal(ppkd, i->ppkd))) {
-                break;
-            }
-        }
+        i = ccnl_interest_find(relay, p, ppkd, minsfx, maxsfx);
 
         if (!i) { // this is a new/unknown I request: create and propagate
             i = ccnl_interest_new(relay, from, &buf, &p, minsfx, maxsfx, &ppkd);
@@ -1394,11 +1891,9 @@ int ccnl_core_RX_i_or_c(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
         from->stat.received_content++;
 
         // CONFORM: Step 1:
-        for (c = relay->contents; c; c = c->next) {
-            if (buf_equal(c->pkt, buf)) {
-                DEBUGMSG(1, "content is dup: skip\n");
-                goto Skip;
-            }
+        if (ccnl_content_find_dup(relay, p, buf)) {
+            DEBUGMSG(1, "content is dup: skip\n");
+            goto Skip;
         }
 
         c = ccnl_content_new(relay, &buf, &p, &ppkd, content, contlen);
@@ -1419,7 +1914,9 @@ int ccnl_core_RX_i_or_c(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
 
             if (relay->max_cache_entries != 0) { // it's set to -1 or a limit
                 DEBUGMSG(7, "  adding content to cache\n");
-                ccnl_content_add2cache(relay, c);
+                if (!ccnl_content_add2cache(relay, c)) {
+                    free_content(c);
+                }
             }
             else {
                 DEBUGMSG(7, "  content not added to cache\n");
@@ -46,6 +46,37 @@
 
 #define CCNL_FORWARD_FLAGS_STATIC  0x01
 
+// number of buckets of the content store's name prefix index
+#ifndef CCNL_CONTENT_HASH_SIZE
+#define CCNL_CONTENT_HASH_SIZE  64
+#endif
+
+// number of buckets of the PIT's prefix index
+#ifndef CCNL_PIT_HASH_SIZE
+#define CCNL_PIT_HASH_SIZE      32
+#endif
+
+// number of buckets of the nonce cache's hash set
+#ifndef CCNL_NONCE_HASH_SIZE
+#define CCNL_NONCE_HASH_SIZE    64
+#endif
+
+// nonces up to this length are stored inline, longer ones in a separate buffer
+#ifndef CCNL_NONCE_MAX_LEN
+#define CCNL_NONCE_MAX_LEN      8
+#endif
+
+// number of slots of the ageing timing wheel, each covering one
+// CCNL_CHECK_TIMEOUT period; longer timeouts take several turns
+#ifndef CCNL_AGEING_WHEEL_SIZE
+#define CCNL_AGEING_WHEEL_SIZE  16
+#endif
+
+#define CCNL_AGEING_INTEREST    0
+#define CCNL_AGEING_CONTENT     1
+#define CCNL_AGEING_FACE        2
+#define CCNL_AGEING_FWD         3
+
 #include <inttypes.h>
 #include <time.h>
 #include <sys/time.h>
@@ -86,14 +117,41 @@ struct ccnl_if_s { // interface for packet IO
     struct ccnl_face_s *broadcast_face;
 };
 
+struct ccnl_nonce_s {
+    uint16_t hnext;     // index + 1 of the next nonce in the bucket, 0: none
+    int len;
+    unsigned char data[CCNL_NONCE_MAX_LEN];
+    struct ccnl_buf_s *buf; // copy of nonces longer than CCNL_NONCE_MAX_LEN
+    uint32_t hash;
+    struct timeval created;
+};
+
+struct ccnl_ageing_s { // link in ccnl_relay_s.ageing_wheel
+    struct ccnl_ageing_s *next, *prev;
+    int slot; // index + 1 of the wheel slot, 0: not on the wheel
+    int type; // CCNL_AGEING_*
+};
+
+struct ccnl_ageing_stats_s {
+    unsigned long ticks;        // number of ageing runs
+    unsigned int checked;       // entries checked by the last run
+    unsigned int expired;       // entries removed by the last run
+    unsigned int checked_max;   // most entries checked by a single run
+    unsigned int scheduled;     // entries on the wheel
+};
+
 struct ccnl_relay_s {
     struct timeval startup_time;
     int id;
     struct ccnl_face_s *faces;
     struct ccnl_forward_s *fib;
     struct ccnl_interest_s *pit;
-    struct ccnl_content_s *contents; //, *contentsend;
-    struct ccnl_nonce_s *nonces;
+    struct ccnl_content_s *contents, *contentsend; // most recently used first
+    struct ccnl_nonce_s nonces[CCNL_MAX_NONCES]; // FIFO ring, oldest first
+    int nonce_first;    // index of the oldest nonce
+    int nonce_cnt;      // number of cached nonces
+    uint16_t nonce_hash[CCNL_NONCE_HASH_SIZE]; // index + 1 of the first
+                                               // nonce, 0: empty
     int contentcnt;     // number of cached items
     int max_cache_entries;  // -1: unlimited
     struct ccnl_if_s ifs[CCNL_MAX_INTERFACES];
@@ -104,6 +162,11 @@ struct ccnl_relay_s {
     struct ccnl_sched_s *(*defaultInterfaceScheduler)(struct ccnl_relay_s *,
             void(*cts_done)(void *, void *));
     struct ccnl_http_s *http;
+    struct ccnl_cs_node_s *content_hash[CCNL_CONTENT_HASH_SIZE];
+    struct ccnl_interest_s *pit_hash[CCNL_PIT_HASH_SIZE];
+    struct ccnl_ageing_s *ageing_wheel[CCNL_AGEING_WHEEL_SIZE];
+    int ageing_pos;     // slot checked by the last ageing run
+    struct ccnl_ageing_stats_s ageing_stats;
     struct ccnl_stats_s *stats;
     void *aux;
     int fib_threshold_prefix; /* how may name components should be considdered as dynamic */
@@ -120,12 +183,6 @@ struct ccnl_buf_s {
     unsigned char data[1];
 };
 
-struct ccnl_nonce_s {
-    struct ccnl_nonce_s *next, *prev;
-    struct timeval created;
-    struct ccnl_buf_s *buf;
-};
-
 struct ccnl_prefix_s {
     unsigned char **comp;
     int *complen;
@@ -167,6 +224,7 @@ struct ccnl_face_s {
     sockunion peer;
     int flags;
     struct timeval last_used; // updated when we receive a packet
+    struct ccnl_ageing_s ageing;
     struct ccnl_buf_s *outq, *outqend; // queue of packets to send
     struct ccnl_frag_s *frag;  // which special datagram armoring
     struct ccnl_sched_s *sched;
@@ -180,10 +238,13 @@ struct ccnl_forward_s {
     struct ccnl_face_s *face;
     int flags;
     struct timeval last_used; // updated when we use this fib entry
+    struct ccnl_ageing_s ageing;
 };
 
 struct ccnl_interest_s {
     struct ccnl_interest_s *next, *prev;
+    struct ccnl_interest_s *hnext, *hprev; // chain in ccnl_relay_s.pit_hash
+    uint32_t hash; // hash of the prefix
     struct ccnl_face_s *from;
     struct ccnl_pendint_s *pending; // linked list of faces wanting that content
     struct ccnl_prefix_s *prefix;
@@ -191,6 +252,7 @@ struct ccnl_interest_s {
     struct ccnl_buf_s *ppkd;       // publisher public key digest
     struct ccnl_buf_s *pkt;    // full datagram
     struct timeval last_used;
+    struct ccnl_ageing_s ageing;
     int retries;
     struct ccnl_forward_s *forwarded_over;
 };
@@ -201,8 +263,25 @@ struct ccnl_pendint_s { // pending interest
     struct timeval last_used;
 };
 
+// name prefix of cached content, kept in ccnl_relay_s.content_hash
+struct ccnl_cs_node_s {
+    struct ccnl_cs_node_s *next; // in hash bucket
+    struct ccnl_content_link_s *exact; // content named exactly by the prefix
+    struct ccnl_content_link_s *longer; // content with longer names
+    uint32_t hash;
+    int compcnt;
+};
+
+// membership of a content in the ccnl_cs_node_s of one of its name prefixes
+struct ccnl_content_link_s {
+    struct ccnl_content_link_s *next, *prev;
+    struct ccnl_content_s *c;
+    struct ccnl_cs_node_s *node;
+};
+
 struct ccnl_content_s {
     struct ccnl_content_s *next, *prev;
+    struct ccnl_content_link_s *links; // one per name component, NULL if not cached
     struct ccnl_prefix_s *name;
     struct ccnl_buf_s *ppkd; // publisher public key digest
     struct ccnl_buf_s *pkt; // full datagram
@@ -212,6 +291,7 @@ struct ccnl_content_s {
     // NON-CONFORM: "The [ContentSTore] MUST also implement the Staleness Bit."
     // >> CCNL: currently no stale bit, old content is fully removed <<
     struct timeval last_used;
+    struct ccnl_ageing_s ageing; // only while cached
     int served_cnt;
 };
 
@@ -254,6 +334,14 @@ ccnl_content_new(struct ccnl_relay_s *ccnl, struct ccnl_buf_s **pkt,
 struct ccnl_content_s *
 ccnl_content_add2cache(struct ccnl_relay_s *ccnl, struct ccnl_content_s *c);
 
+struct ccnl_content_s *
+ccnl_content_find(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *prefix,
+                  struct ccnl_buf_s *ppkd, int minsuffix, int maxsuffix);
+
+struct ccnl_interest_s *
+ccnl_interest_find(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *prefix,
+                   struct ccnl_buf_s *ppkd, int minsuffix, int maxsuffix);
+
 void ccnl_content_learn_name_route(struct ccnl_relay_s *ccnl, struct ccnl_prefix_s *p,
                                    struct ccnl_face_s *f, int threshold_prefix, int flags);
 
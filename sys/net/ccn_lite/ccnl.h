@@ -56,7 +56,11 @@ extern "C" {
 #define CCNL_MAX_NAME_COMP              16
 #define CCNL_MAX_IF_QLEN                64
 
-#define CCNL_MAX_NONCES                 256 // for detected dups
+// size of the ring of nonces kept to detect duplicate interests, about
+// 32 bytes each; a larger ring detects loops over more intermediate interests
+#ifndef CCNL_MAX_NONCES
+#define CCNL_MAX_NONCES                 32
+#endif
 
 #define TIMEOUT_TO_US(SEC, USEC) ((SEC)*1000*1000 + (USEC))
 
@@ -14,13 +14,88 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/ng_inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-uint16_t ng_inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+/**
+ * @brief   Sums up @p buf as 16-bit words in host byte order.
+ *
+ * @details Word-at-a-time implementation of RFC 1071, section 4: @p buf is
+ *          summed up in 32-bit words into a 64-bit accumulator, so carries are
+ *          only folded back once at the end. An unaligned start is paired
+ *          with a preceding zero byte and compensated by swapping the bytes
+ *          of the result, a trailing odd byte is paired with a zero byte.
+ *
+ * @param[in] buf   A buffer.
+ * @param[in] len   Length of @p buf in byte.
+ *
+ * @return  The folded sum of @p buf in host byte order.
+ */
+static uint16_t _sum_words(const uint8_t *buf, uint16_t len)
+{
+    uint64_t acc = 0;
+    uint16_t word = 0;
+    int odd = ((uintptr_t)buf) & 1;
+    const uint32_t *words;
+
+    if (odd && (len > 0)) {
+        ((uint8_t *)&word)[1] = *buf;
+        acc += word;
+        buf++;
+        len--;
+    }
+
+    if ((((uintptr_t)buf) & 2) && (len >= 2)) {
+        acc += *((const uint16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+
+    words = (const uint32_t *)buf;
+
+    while (len >= 16) {
+        acc += words[0];
+        acc += words[1];
+        acc += words[2];
+        acc += words[3];
+        words += 4;
+        len -= 16;
+    }
+
+    while (len >= 4) {
+        acc += *(words++);
+        len -= 4;
+    }
+
+    buf = (const uint8_t *)words;
+
+    if (len >= 2) {
+        acc += *((const uint16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+
+    if (len > 0) {
+        word = 0;
+        ((uint8_t *)&word)[0] = *buf;
+        acc += word;
+    }
+
+    /* fold 64-bit accumulator to 16 bit */
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+
+    return (odd) ? byteorder_swaps((uint16_t)acc) : (uint16_t)acc;
+}
+
+uint16_t ng_inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                            size_t accum_len)
 {
     uint32_t csum = sum;
 
@@ -34,14 +109,13 @@ uint16_t ng_inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
 #endif
 #endif
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (*buf << 8) + *(buf + 1);   /* group bytes by 16-byte words
-                                             * and add them*/
+    if ((accum_len & 1) && (len > 0)) {
+        /* buf continues a 16-bit word started by the previous slice */
+        csum += *(buf++);
+        len--;
     }
 
-    if (len & 1) {                      /* if len is odd */
-        csum += (*buf << 8);            /* add last byte as top half of 16-byte word */
-    }
+    csum += NTOHS(_sum_words(buf, len));
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
@@ -26,83 +26,180 @@
 
 #define _INVALID_TYPE(type) (((type) < NG_NETTYPE_UNDEF) || ((type) >= NG_NETTYPE_NUMOF))
 
-/* The registry as lookup table by ng_nettype_t */
-static ng_netreg_entry_t *netreg[NG_NETTYPE_NUMOF];
+/**
+ * @brief   A slot of the registry, holding all entries of one type and
+ *          demultiplexing context
+ */
+typedef struct {
+    ng_netreg_entry_t *entries; /**< entries in this slot, NULL if slot is empty */
+    uint32_t demux_ctx;         /**< demultiplexing context of the entries */
+    ng_nettype_t type;          /**< type of the entries */
+    int num;                    /**< number of entries in this slot */
+} _netreg_slot_t;
+
+/* The registry as open addressing hash table by ng_nettype_t and demux context */
+static _netreg_slot_t netreg[NG_NETREG_SIZE];
+
+static inline unsigned _hash(ng_nettype_t type, uint32_t demux_ctx)
+{
+    /* Knuth's multiplicative hash, ports and protocol numbers are often
+     * sequential. Only the upper bits of the product depend on all bits of
+     * the key (the type in particular), so scale the product down to the
+     * table size instead of taking it modulo the size. For a power of two
+     * size this is just a shift by (32 - log2(NG_NETREG_SIZE)). */
+    uint32_t h = (((uint32_t)type << 24) ^ demux_ctx) * 2654435761U;
+
+    return (unsigned)(((uint64_t)h * NG_NETREG_SIZE) >> 32);
+}
+
+static inline unsigned _next(unsigned idx)
+{
+    return (idx + 1) % NG_NETREG_SIZE;
+}
+
+/* returns slot for type and demux_ctx or the empty slot it would be inserted
+ * in, NULL if it does not exist and the registry is full */
+static _netreg_slot_t *_find(ng_nettype_t type, uint32_t demux_ctx)
+{
+    unsigned idx = _hash(type, demux_ctx);
+
+    for (unsigned i = 0; i < NG_NETREG_SIZE; i++) {
+        _netreg_slot_t *slot = &netreg[idx];
+
+        if ((slot->entries == NULL) ||
+            ((slot->type == type) && (slot->demux_ctx == demux_ctx))) {
+            return slot;
+        }
+
+        idx = _next(idx);
+    }
+
+    return NULL;
+}
+
+/* empties slot and moves subsequent slots of the probe sequence back */
+static void _remove(_netreg_slot_t *slot)
+{
+    unsigned hole = slot - netreg;
+
+    netreg[hole].entries = NULL;
+
+    for (unsigned idx = _next(hole); netreg[idx].entries != NULL; idx = _next(idx)) {
+        unsigned home = _hash(netreg[idx].type, netreg[idx].demux_ctx);
+
+        /* move slot unless its home lies cyclically in (hole, idx] */
+        if ((hole < idx) ? ((home <= hole) || (home > idx))
+                         : ((home <= hole) && (home > idx))) {
+            netreg[hole] = netreg[idx];
+            netreg[idx].entries = NULL;
+            hole = idx;
+        }
+    }
+}
 
 void ng_netreg_init(void)
 {
-    /* set all pointers in registry to NULL */
-    memset(netreg, 0, NG_NETTYPE_NUMOF * sizeof(ng_netreg_entry_t *));
+    /* set all slots in registry to empty */
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int ng_netreg_register(ng_nettype_t type, ng_netreg_entry_t *entry)
 {
+    _netreg_slot_t *slot;
+
     if (_INVALID_TYPE(type)) {
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    slot = _find(type, entry->demux_ctx);
+
+    if (slot == NULL) {
+        return -ENOMEM;
+    }
+
+    if (slot->entries == NULL) {
+        slot->type = type;
+        slot->demux_ctx = entry->demux_ctx;
+        slot->num = 0;
+    }
+
+    LL_PREPEND(slot->entries, entry);
+    slot->num++;
 
     return 0;
 }
 
 void ng_netreg_unregister(ng_nettype_t type, ng_netreg_entry_t *entry)
 {
+    _netreg_slot_t *slot;
+    ng_netreg_entry_t *tmp;
+
     if (_INVALID_TYPE(type)) {
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    slot = _find(type, entry->demux_ctx);
+
+    if ((slot == NULL) || (slot->entries == NULL)) {
+        return;
+    }
+
+    /* entry might not be registered */
+    LL_FOREACH(slot->entries, tmp) {
+        if (tmp == entry) {
+            break;
+        }
+    }
+
+    if (tmp == NULL) {
+        return;
+    }
+
+    LL_DELETE(slot->entries, entry);
+
+    if (--slot->num == 0) {
+        _remove(slot);
+    }
 }
 
 ng_netreg_entry_t *ng_netreg_lookup(ng_nettype_t type, uint32_t demux_ctx)
 {
-    ng_netreg_entry_t *res;
+    _netreg_slot_t *slot;
 
     if (_INVALID_TYPE(type)) {
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    slot = _find(type, demux_ctx);
 
-    return res;
+    return (slot == NULL) ? NULL : slot->entries;
 }
 
 int ng_netreg_num(ng_nettype_t type, uint32_t demux_ctx)
 {
-    int num = 0;
-    ng_netreg_entry_t *entry;
+    _netreg_slot_t *slot;
 
     if (_INVALID_TYPE(type)) {
         return 0;
     }
 
-    entry = netreg[type];
+    slot = _find(type, demux_ctx);
 
-    while (entry != NULL) {
-        if (entry->demux_ctx == demux_ctx) {
-            num++;
-        }
-
-        entry = entry->next;
+    if ((slot == NULL) || (slot->entries == NULL)) {
+        return 0;
     }
 
-    return num;
+    return slot->num;
 }
 
 ng_netreg_entry_t *ng_netreg_getnext(ng_netreg_entry_t *entry)
 {
-    uint32_t demux_ctx;
-
     if (entry == NULL) {
         return NULL;
     }
 
-    demux_ctx = entry->demux_ctx;
-
-    LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
-
-    return entry;
+    /* all entries of a slot share type and demux context */
+    return entry->next;
 }
 
 int ng_netreg_calc_csum(ng_pktsnip_t *hdr, ng_pktsnip_t *pseudo_hdr)
@@ -22,7 +22,7 @@
 #include "net/ng_pktbuf.h"
 #include "utlist.h"
 
-#if NG_PKTBUF_SIZE == 0
+#if (NG_PKTBUF_SIZE == 0) && !defined(MODULE_NG_PKTBUF_SLAB)
 /* chunk table to allow for free(ptr + x)-like behaviour */
 typedef struct __attribute__((packed)) _chunk_list_t {
     struct _chunk_list_t *next;
@@ -78,7 +78,8 @@ bool _pktbuf_internal_contains(const void *ptr);
 /**
  * @brief   Prints some statistics about the packet buffer to stdout.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes or the
+ *          high-water mark of each size class.
  */
 void _pktbuf_internal_stats(void);
 #endif
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_ng_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Slab allocator backend for the packet buffer
+ *
+ * @details Memory is split into fixed-size chunks of three size classes, each
+ *          managed by a free stack, so allocation and freeing of a chunk as
+ *          well as looking up the chunk of a pointer are O(1).
+ *
+ * @author  agent <agent@local>
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "net/ng_pktbuf.h"
+#include "_pktbuf_internal.h"
+
+#ifdef MODULE_NG_PKTBUF_SLAB
+
+#define _PKTBUF_ALIGN_BYTES (sizeof(void *))
+
+/**
+ * @brief   aligns @p size to the next word alignment.
+ */
+#define _AL_SZ(size)        ((((size) + _PKTBUF_ALIGN_BYTES - 1) / \
+                              _PKTBUF_ALIGN_BYTES) * _PKTBUF_ALIGN_BYTES)
+
+#define _SNIP_SIZE          _AL_SZ(sizeof(ng_pktsnip_t))
+#define _SMALL_SIZE         _AL_SZ(NG_PKTBUF_SLAB_SMALL_SIZE)
+#define _LARGE_SIZE         _AL_SZ(NG_PKTBUF_SLAB_LARGE_SIZE)
+
+#if (NG_PKTBUF_SLAB_SNIP_NUMOF > 255) || (NG_PKTBUF_SLAB_SMALL_NUMOF > 255) || \
+    (NG_PKTBUF_SLAB_LARGE_NUMOF > 255)
+#error "ng_pktbuf_slab: a size class can have at most 255 chunks"
+#endif
+
+/**
+ * @brief   Data type to represent a size class of the slab allocator.
+ */
+typedef struct {
+    uint8_t *buf;       /**< memory of the chunks */
+    uint8_t *pkts;      /**< number of users of each chunk */
+    uint8_t *free;      /**< stack of free chunk indices */
+    uint16_t size;      /**< size of a chunk in byte */
+    uint8_t numof;      /**< number of chunks */
+    uint8_t free_num;   /**< number of chunks on stack _slab_class_t::free */
+#ifdef DEVELHELP
+    uint8_t max_used;   /**< high-water mark of used chunks */
+#endif
+} _slab_class_t;
+
+#define _CLASS_NUMOF    (3)     /**< snips, small chunks, and large chunks */
+
+static uint8_t _snip_buf[NG_PKTBUF_SLAB_SNIP_NUMOF * _SNIP_SIZE]
+__attribute__((aligned(sizeof(void *))));
+static uint8_t _small_buf[NG_PKTBUF_SLAB_SMALL_NUMOF * _SMALL_SIZE]
+__attribute__((aligned(sizeof(void *))));
+static uint8_t _large_buf[NG_PKTBUF_SLAB_LARGE_NUMOF * _LARGE_SIZE]
+__attribute__((aligned(sizeof(void *))));
+
+static uint8_t _snip_pkts[NG_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _small_pkts[NG_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _large_pkts[NG_PKTBUF_SLAB_LARGE_NUMOF];
+
+static uint8_t _snip_free[NG_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _small_free[NG_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _large_free[NG_PKTBUF_SLAB_LARGE_NUMOF];
+
+static _slab_class_t _classes[_CLASS_NUMOF] = {
+    { .buf = _snip_buf, .pkts = _snip_pkts, .free = _snip_free,
+      .size = _SNIP_SIZE, .numof = NG_PKTBUF_SLAB_SNIP_NUMOF },
+    { .buf = _small_buf, .pkts = _small_pkts, .free = _small_free,
+      .size = _SMALL_SIZE, .numof = NG_PKTBUF_SLAB_SMALL_NUMOF },
+    { .buf = _large_buf, .pkts = _large_pkts, .free = _large_free,
+      .size = _LARGE_SIZE, .numof = NG_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+static bool _initialized = false;
+
+static void _init(void)
+{
+    for (int i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_class_t *class = &_classes[i];
+
+        /* stack free chunks in reverse, so the first chunks are allocated
+         * first */
+        for (uint8_t j = 0; j < class->numof; j++) {
+            class->free[j] = class->numof - j - 1;
+        }
+
+        memset(class->pkts, 0, class->numof);
+        class->free_num = class->numof;
+#ifdef DEVELHELP
+        class->max_used = 0;
+#endif
+    }
+
+    _initialized = true;
+}
+
+static inline bool _in_class(const _slab_class_t *class, const void *ptr)
+{
+    return (((uint8_t *)ptr) >= class->buf) &&
+           (((uint8_t *)ptr) < (class->buf + (class->numof * class->size)));
+}
+
+/**
+ * @brief   Finds the class and index of the chunk @p ptr points into
+ *
+ * @return  The class of the chunk, NULL if @p ptr is not in the packet buffer
+ */
+static _slab_class_t *_find(const void *ptr, uint8_t *idx)
+{
+    for (int i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_class_t *class = &_classes[i];
+
+        if (_in_class(class, ptr)) {
+            *idx = (uint8_t)((((uint8_t *)ptr) - class->buf) / class->size);
+            return class;
+        }
+    }
+
+    return NULL;
+}
+
+static inline uint8_t *_chunk(const _slab_class_t *class, uint8_t idx)
+{
+    return class->buf + (idx * class->size);
+}
+
+static void *_alloc_in(_slab_class_t *class)
+{
+    uint8_t idx;
+
+    if (class->free_num == 0) {
+        return NULL;
+    }
+
+    idx = class->free[--class->free_num];
+    class->pkts[idx] = 1;
+
+#ifdef DEVELHELP
+    if ((class->numof - class->free_num) > class->max_used) {
+        class->max_used = class->numof - class->free_num;
+    }
+#endif
+
+    return _chunk(class, idx);
+}
+
+static void _free_helper(_slab_class_t *class, uint8_t idx)
+{
+    if ((class->pkts[idx] > 0) && ((--class->pkts[idx]) == 0)) {
+        class->free[class->free_num++] = idx;
+    }
+}
+
+void *_pktbuf_internal_alloc(size_t size)
+{
+    if (!_initialized) {
+        _init();
+    }
+
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* take smallest class that fits, fall back to bigger ones if exhausted */
+    for (int i = 0; i < _CLASS_NUMOF; i++) {
+        if (size <= _classes[i].size) {
+            void *ptr = _alloc_in(&_classes[i]);
+
+            if (ptr != NULL) {
+                return ptr;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+bool _pktbuf_internal_add_pkt(void *ptr)
+{
+    uint8_t idx;
+    _slab_class_t *class = _find(ptr, &idx);
+
+    /* the counter of users is only 8 bit wide, refuse further users
+     * instead of wrapping around and freeing a chunk that is still in use */
+    if ((class != NULL) && (class->pkts[idx] > 0) &&
+        (class->pkts[idx] < UINT8_MAX)) {
+        class->pkts[idx]++;
+
+        return true;
+    }
+
+    return false;
+}
+
+void _pktbuf_internal_free(void *ptr)
+{
+    uint8_t idx;
+    _slab_class_t *class = _find(ptr, &idx);
+
+    if (class != NULL) {
+        _free_helper(class, idx);
+    }
+}
+
+void *_pktbuf_internal_realloc(void *ptr, size_t size)
+{
+    uint8_t idx;
+    _slab_class_t *class;
+    uint8_t *new;
+    size_t old_size = 0;
+
+    if (size == 0) {
+        return NULL;
+    }
+
+    class = _find(ptr, &idx);
+
+    if (class != NULL) {
+        old_size = (_chunk(class, idx) + class->size) - ((uint8_t *)ptr);
+
+        /* the chunk is not shared and the rest of it is big enough */
+        if ((class->pkts[idx] == 1) && (size <= old_size)) {
+            return ptr;
+        }
+    }
+
+    new = _pktbuf_internal_alloc(size);
+
+    if ((new != NULL) && (class != NULL)) {
+        memcpy(new, ptr, (old_size < size) ? old_size : size);
+        _free_helper(class, idx);
+    }
+
+    return new;
+}
+
+bool _pktbuf_internal_contains(const void *ptr)
+{
+    uint8_t idx;
+
+    return (_find(ptr, &idx) != NULL);
+}
+
+#ifdef DEVELHELP
+void _pktbuf_internal_stats(void)
+{
+    static const char *names[] = { "snip", "small", "large" };
+
+    if (!_initialized) {
+        _init();
+    }
+
+    printf("Slab packet buffer\n");
+
+    for (int i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_class_t *class = &_classes[i];
+
+        printf(" * %-5s %4u byte x %3u: %3u used, %3u maximum used\n", names[i],
+               (unsigned)class->size, (unsigned)class->numof,
+               (unsigned)(class->numof - class->free_num),
+               (unsigned)class->max_used);
+    }
+}
+#endif
+
+/* for testing */
+#ifdef TEST_SUITES
+bool _pktbuf_internal_is_empty(void)
+{
+    if (!_initialized) {
+        return true;
+    }
+
+    for (int i = 0; i < _CLASS_NUMOF; i++) {
+        if (_classes[i].free_num != _classes[i].numof) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void _pktbuf_internal_reset(void)
+{
+    _init();
+}
+#endif  /* TEST_SUITES */
+#endif  /* MODULE_NG_PKTBUF_SLAB */
+
+/** @} */
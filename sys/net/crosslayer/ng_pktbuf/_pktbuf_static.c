@@ -25,7 +25,7 @@
 #include "_pktbuf_internal.h"
 
 /* only for static packet buffer */
-#if NG_PKTBUF_SIZE > 0
+#if (NG_PKTBUF_SIZE > 0) && !defined(MODULE_NG_PKTBUF_SLAB)
 
 #define _PKTBUF_ALIGN_BYTES (sizeof(void *))
 
@@ -303,6 +303,6 @@ void _pktbuf_internal_reset(void)
 #endif
 }
 #endif  /* TEST_SUITES */
-#endif  /* NG_PKTBUF_SIZE > 0 */
+#endif  /* (NG_PKTBUF_SIZE > 0) && !defined(MODULE_NG_PKTBUF_SLAB) */
 
 /** @} */
@@ -35,11 +35,19 @@
 
 static mutex_t _pktbuf_mutex = MUTEX_INIT;
 
+#ifdef DEVELHELP
+static size_t _pktbuf_copied_bytes = 0;
+#endif
+
 /* internal ng_pktbuf functions */
 static ng_pktsnip_t *_pktbuf_alloc(size_t size);
 static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
-                                        size_t size, ng_nettype_t type);
+                                        size_t size, size_t headroom,
+                                        ng_nettype_t type);
 static ng_pktsnip_t *_pktbuf_duplicate(const ng_pktsnip_t *pkt);
+static void *_pktbuf_copy_data(const ng_pktsnip_t *pkt, size_t size);
+static void _pktbuf_share(ng_pktsnip_t *pkt, ng_pktsnip_t *other);
+static void _pktbuf_unshare(ng_pktsnip_t *pkt);
 
 int ng_pktbuf_realloc_data(ng_pktsnip_t *pkt, size_t size)
 {
@@ -58,7 +66,18 @@ int ng_pktbuf_realloc_data(ng_pktsnip_t *pkt, size_t size)
 
     mutex_lock(&_pktbuf_mutex);
 
-    new = _pktbuf_internal_realloc(pkt->data, size);
+    if (pkt->shared) {
+        /* do not resize data other packets are still using */
+        new = (size > 0) ? _pktbuf_copy_data(pkt, size) : NULL;
+
+        if (new != NULL) {
+            _pktbuf_internal_free(pkt->data);
+            _pktbuf_unshare(pkt);
+        }
+    }
+    else {
+        new = _pktbuf_internal_realloc(pkt->data, size);
+    }
 
     mutex_unlock(&_pktbuf_mutex);
 
@@ -67,6 +86,10 @@ int ng_pktbuf_realloc_data(ng_pktsnip_t *pkt, size_t size)
         return ENOMEM;
     }
 
+    if (new != pkt->data) {
+        pkt->headroom = 0;
+    }
+
     pkt->data = new;
     pkt->size = size;
 
@@ -80,7 +103,25 @@ ng_pktsnip_t *ng_pktbuf_add(ng_pktsnip_t *pkt, void *data, size_t size,
 
     mutex_lock(&_pktbuf_mutex);
 
-    new_pktsnip = _pktbuf_add_unsafe(pkt, data, size, type);
+    new_pktsnip = _pktbuf_add_unsafe(pkt, data, size, 0, type);
+
+    mutex_unlock(&_pktbuf_mutex);
+
+    return new_pktsnip;
+}
+
+ng_pktsnip_t *ng_pktbuf_add_headroom(ng_pktsnip_t *pkt, void *data, size_t size,
+                                     size_t headroom, ng_nettype_t type)
+{
+    ng_pktsnip_t *new_pktsnip;
+
+    if (headroom > UINT16_MAX) {
+        return NULL;
+    }
+
+    mutex_lock(&_pktbuf_mutex);
+
+    new_pktsnip = _pktbuf_add_unsafe(pkt, data, size, headroom, type);
 
     mutex_unlock(&_pktbuf_mutex);
 
@@ -119,6 +160,8 @@ void ng_pktbuf_release(ng_pktsnip_t *pkt)
         }
 
         if (pkt->users == 0) {
+            _pktbuf_unshare(pkt);
+
             if (_pktbuf_internal_contains(pkt->data)) {
                 DEBUG("pktbuf: free pkt->data = %p\n", pkt->data);
                 _pktbuf_internal_free(pkt->data);
@@ -138,10 +181,16 @@ void ng_pktbuf_release(ng_pktsnip_t *pkt)
 
 ng_pktsnip_t *ng_pktbuf_start_write(ng_pktsnip_t *pkt)
 {
-    if (pkt != NULL && pkt->users > 1) {
-        ng_pktsnip_t *res = NULL;
+    if (pkt == NULL) {
+        return NULL;
+    }
 
-        mutex_lock(&_pktbuf_mutex);
+    /* other users may release pkt or write to the shared data concurrently,
+     * so only check them under the mutex */
+    mutex_lock(&_pktbuf_mutex);
+
+    if (pkt->users > 1) {
+        ng_pktsnip_t *res = NULL;
 
         DEBUG("pktbuf: pkt->users = %u => copy-on-write\n", pkt->users);
         res = _pktbuf_duplicate(pkt);
@@ -154,6 +203,71 @@ ng_pktsnip_t *ng_pktbuf_start_write(ng_pktsnip_t *pkt)
 
         return res;
     }
+    else if (pkt->shared) {
+        void *new;
+
+        DEBUG("pktbuf: pkt->data = %p is shared => copy-on-write\n", pkt->data);
+        new = _pktbuf_copy_data(pkt, pkt->size);
+
+        if (new == NULL) {
+            mutex_unlock(&_pktbuf_mutex);
+            return NULL;
+        }
+
+        _pktbuf_internal_free(pkt->data);
+        pkt->data = new;
+        pkt->headroom = 0;
+        _pktbuf_unshare(pkt);
+    }
+
+    mutex_unlock(&_pktbuf_mutex);
+
+    return pkt;
+}
+
+ng_pktsnip_t *ng_pktbuf_start_mark(ng_pktsnip_t *pkt)
+{
+    if (pkt != NULL && pkt->users > 1) {
+        ng_pktsnip_t *res;
+
+        mutex_lock(&_pktbuf_mutex);
+
+        DEBUG("pktbuf: pkt->users = %u => clone snip, share data\n", pkt->users);
+        res = (ng_pktsnip_t *)_pktbuf_internal_alloc(sizeof(ng_pktsnip_t));
+
+        if (res == NULL) {
+            mutex_unlock(&_pktbuf_mutex);
+            return NULL;
+        }
+
+        res->shared = NULL;
+
+        if (_pktbuf_internal_contains(pkt->data)) {
+            if (!_pktbuf_internal_add_pkt(pkt->data)) {
+                _pktbuf_internal_free(res);
+                mutex_unlock(&_pktbuf_mutex);
+                return NULL;
+            }
+
+            /* data is copied by whoever writes to it first */
+            _pktbuf_share(pkt, res);
+        }
+
+        res->next = pkt->next;
+        res->data = pkt->data;
+        res->size = pkt->size;
+        res->type = pkt->type;
+        res->users = 1;
+        res->headroom = 0;  /* headroom stays with pkt */
+        DEBUG("pktbuf: (pkt = %p) cloned to (res = %p)\n", (void *)pkt,
+              (void *)res);
+
+        pkt->users--;
+
+        mutex_unlock(&_pktbuf_mutex);
+
+        return res;
+    }
 
     return pkt;
 }
@@ -190,16 +304,59 @@ static ng_pktsnip_t *_pktbuf_alloc(size_t size)
     pkt->next = NULL;
     pkt->size = size;
     pkt->users = 1;
+    pkt->headroom = 0;
+    pkt->shared = NULL;
 
     return pkt;
 }
 
 static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
-                                        size_t size, ng_nettype_t type)
+                                        size_t size, size_t headroom,
+                                        ng_nettype_t type)
 {
     ng_pktsnip_t *new_pktsnip;
 
-    if (pkt == NULL || pkt->data != data) {
+    if ((pkt != NULL) && (size != 0) && (pkt->headroom >= size) &&
+        ((data == NULL) || !_pktbuf_internal_contains(data))) {
+        new_pktsnip = (ng_pktsnip_t *)_pktbuf_internal_alloc(sizeof(ng_pktsnip_t));
+        DEBUG("pktbuf: allocated (new_pktsnip = %p) ", (void *)new_pktsnip);
+
+        if (new_pktsnip == NULL) {
+            DEBUG("=> failed\n");
+            return NULL;
+        }
+
+        DEBUG("of size %u\n", (unsigned)sizeof(ng_pktsnip_t));
+        DEBUG("pktbuf: Adding chunk to %p ", pkt->data);
+
+        if (!_pktbuf_internal_add_pkt(pkt->data)) {
+            DEBUG("failed (freeing %p)\n", (void *)new_pktsnip);
+            _pktbuf_internal_free(new_pktsnip);
+
+            return NULL;
+        }
+
+        DEBUG("successful\n");
+
+        /* take data from pkt's headroom, so no new chunk is needed */
+        new_pktsnip->data = ((uint8_t *)pkt->data) - size;
+        new_pktsnip->headroom = pkt->headroom - size;
+        new_pktsnip->shared = NULL;
+        pkt->headroom = 0;
+        DEBUG("pktbuf: set new_pktsnip->data = %p from headroom (%u byte left)\n",
+              new_pktsnip->data, (unsigned)new_pktsnip->headroom);
+
+        if (data != NULL) {
+            DEBUG("pktbuf: copying %u byte from %p to %p\n", (unsigned)size,
+                  data, new_pktsnip->data);
+            memcpy(new_pktsnip->data, data, size);
+        }
+
+        new_pktsnip->next = NULL;
+        LL_PREPEND(pkt, new_pktsnip);
+        DEBUG("pktbuf: prepended new_pktsnip to pkt\n");
+    }
+    else if (pkt == NULL || pkt->data != data) {
         new_pktsnip = (ng_pktsnip_t *)_pktbuf_internal_alloc(sizeof(ng_pktsnip_t));
         DEBUG("pktbuf: allocated (new_pktsnip = %p) ", (void *)new_pktsnip);
 
@@ -210,8 +367,11 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
 
         DEBUG("of size %u\n", (unsigned)sizeof(ng_pktsnip_t));
 
+        new_pktsnip->headroom = 0;
+        new_pktsnip->shared = NULL;
+
         if ((size != 0) && (!_pktbuf_internal_contains(data))) {
-            new_pktsnip->data = _pktbuf_internal_alloc(size);
+            new_pktsnip->data = _pktbuf_internal_alloc(size + headroom);
             DEBUG("pktbuf: allocated (new_pktsnip->data = %p) ", new_pktsnip->data);
 
             if (new_pktsnip->data == NULL) {
@@ -221,7 +381,10 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
                 return NULL;
             }
 
-            DEBUG("of size %u\n", (unsigned)size);
+            DEBUG("of size %u (headroom %u)\n", (unsigned)size,
+                  (unsigned)headroom);
+            new_pktsnip->data = ((uint8_t *)new_pktsnip->data) + headroom;
+            new_pktsnip->headroom = (uint16_t)headroom;
 
             if (data != NULL) {
                 DEBUG("pktbuf: copying %u byte from %p to %p\n", (unsigned)size,
@@ -231,9 +394,9 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
         }
         else {
             if (_pktbuf_internal_contains(data)) {
-                DEBUG("pktbuf: Adding chunk to %p ", new_pktsnip->data);
+                DEBUG("pktbuf: Adding chunk to %p ", data);
 
-                if (!_pktbuf_internal_add_pkt(new_pktsnip->data)) {
+                if (!_pktbuf_internal_add_pkt(data)) {
                     _pktbuf_internal_free(new_pktsnip);
                     DEBUG("failed (freeing %p)\n", (void *)pkt);
 
@@ -286,6 +449,14 @@ static ng_pktsnip_t *_pktbuf_add_unsafe(ng_pktsnip_t *pkt, void *data,
         DEBUG("successful\n");
         new_pktsnip->next = pkt->next;
         new_pktsnip->data = data;
+        new_pktsnip->headroom = pkt->headroom;
+        new_pktsnip->shared = NULL;
+
+        if (pkt->shared != NULL) {
+            /* the split off part still shares data with the other packets */
+            _pktbuf_share(pkt, new_pktsnip);
+        }
+        pkt->headroom = 0;
         DEBUG("pktbuf: set new_pktsnip->data = %p\n", new_pktsnip->data);
 
         DEBUG("pktbuf: add new_pktsnip (%p) to pkt (%p) after head\n",
@@ -321,6 +492,9 @@ static ng_pktsnip_t *_pktbuf_duplicate(const ng_pktsnip_t *pkt)
     DEBUG("pktbuf: copying %u byte from %p to %p\n", (unsigned)pkt->size,
           pkt->data, res->data);
     memcpy(res->data, pkt->data, pkt->size);
+#ifdef DEVELHELP
+    _pktbuf_copied_bytes += pkt->size;
+#endif
     res->type = pkt->type;
     res->next = pkt->next;
     DEBUG("pktbuf: set res->next to %p", (void *)pkt->next);
@@ -328,10 +502,61 @@ static ng_pktsnip_t *_pktbuf_duplicate(const ng_pktsnip_t *pkt)
     return res;
 }
 
+static void *_pktbuf_copy_data(const ng_pktsnip_t *pkt, size_t size)
+{
+    void *new = _pktbuf_internal_alloc(size);
+
+    if (new == NULL) {
+        DEBUG("pktbuf: unable to allocate %u byte for copy\n", (unsigned)size);
+        return NULL;
+    }
+
+    size = (size < pkt->size) ? size : pkt->size;
+    DEBUG("pktbuf: copying %u byte from %p to %p\n", (unsigned)size,
+          pkt->data, new);
+    memcpy(new, pkt->data, size);
+#ifdef DEVELHELP
+    _pktbuf_copied_bytes += size;
+#endif
+
+    return new;
+}
+
+/* adds other to the ring of snips sharing the data of pkt */
+static void _pktbuf_share(ng_pktsnip_t *pkt, ng_pktsnip_t *other)
+{
+    if (pkt->shared == NULL) {
+        pkt->shared = pkt;
+    }
+
+    other->shared = pkt->shared;
+    pkt->shared = other;
+}
+
+/* removes pkt from the ring of snips sharing its data, a snip that is left
+ * alone in the ring does not share its data anymore */
+static void _pktbuf_unshare(ng_pktsnip_t *pkt)
+{
+    ng_pktsnip_t *prev = pkt->shared;
+
+    if (prev == NULL) {
+        return;
+    }
+
+    while (prev->shared != pkt) {
+        prev = prev->shared;
+    }
+
+    prev->shared = (pkt->shared == prev) ? NULL : pkt->shared;
+    pkt->shared = NULL;
+}
+
 #ifdef DEVELHELP
 void ng_pktbuf_stats(void)
 {
     _pktbuf_internal_stats();
+    printf(" * Bytes copied on copy-on-write: %u\n",
+           (unsigned)_pktbuf_copied_bytes);
 }
 #endif
 
@@ -344,6 +569,9 @@ bool ng_pktbuf_is_empty(void)
 void ng_pktbuf_reset(void)
 {
     _pktbuf_internal_reset();
+#ifdef DEVELHELP
+    _pktbuf_copied_bytes = 0;
+#endif
 }
 #endif
 
@@ -156,12 +156,25 @@ static inline bool RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
     #    define RPL_MAX_ROUTING_ENTRIES (128)
     #endif
 #endif
-#define RPL_MAX_SRH_PATH_LENGTH 10;
+#define RPL_MAX_SRH_PATH_LENGTH 10
+/* number of hash buckets of the routing table */
+#ifndef RPL_ROUTING_HASH_SIZE
+#define RPL_ROUTING_HASH_SIZE (32)
+#endif
+/* number of destinations the root caches source routes for */
+#ifndef RPL_SRH_CACHE_SIZE
+#define RPL_SRH_CACHE_SIZE (4)
+#endif
 #define RPL_SRH_ENTRIES 15
 #define RPL_ROOT_RANK 256
 #define RPL_DEFAULT_LIFETIME 0xff
 #define RPL_LIFETIME_UNIT 2
 #define RPL_LIFETIME_STEP 2
+/* microseconds the periodic lifetime update may be delayed to share a wakeup
+ * with other timers */
+#ifndef RPL_LIFETIME_SLACK
+#define RPL_LIFETIME_SLACK (250000U)
+#endif
 #define RPL_GROUNDED 1
 #define RPL_PRF_MASK 0x7
 #define RPL_MOP_SHIFT 3
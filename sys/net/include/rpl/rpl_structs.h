@@ -210,7 +210,7 @@ typedef struct rpl_of_t {
 typedef struct {
     ipv6_addr_t address;
     ipv6_addr_t next_hop;
-    uint16_t lifetime;
+    uint32_t expires;   /* in seconds of vtimer_now() */
     uint8_t used;
 } rpl_routing_entry_t;
 
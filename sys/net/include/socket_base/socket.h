@@ -166,14 +166,24 @@ typedef uint32_t  socklen_t;    ///< POSIX compatible type for address length.
 #define TRANSPORT_LAYER_SOCKET_STATIC_MSS       48  ///< Static TCP maxmimum segment size.
 
 /**
- * Static TCP flow control window for window size 1.
+ * Static TCP flow control window, i.e. the number of bytes a peer may have
+ * in flight to a socket. Defaults to four segments.
  */
-#define TRANSPORT_LAYER_SOCKET_STATIC_WINDOW    1 * TRANSPORT_LAYER_SOCKET_STATIC_MSS
+#ifndef TRANSPORT_LAYER_SOCKET_STATIC_WINDOW
+#define TRANSPORT_LAYER_SOCKET_STATIC_WINDOW    (4 * TRANSPORT_LAYER_SOCKET_STATIC_MSS)
+#endif
 
 /**
- * Maximum size of TCP buffer.
+ * Maximum size of TCP receive buffer per socket. Must not be smaller than
+ * TRANSPORT_LAYER_SOCKET_STATIC_WINDOW.
  */
-#define TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER   1 * TRANSPORT_LAYER_SOCKET_STATIC_WINDOW
+#ifndef TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER
+#define TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER   (TRANSPORT_LAYER_SOCKET_STATIC_WINDOW)
+#endif
+
+#if TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER < TRANSPORT_LAYER_SOCKET_STATIC_WINDOW
+#error "TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER must hold a full window"
+#endif
 
 /**
  * Socket address type for IPv6 communication.
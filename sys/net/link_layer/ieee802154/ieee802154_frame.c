@@ -17,11 +17,11 @@
  */
 
 #include "ieee802154_frame.h"
+#include "checksum/crc16_ccitt.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-#define IEEE_802154_FCS_POLY    (0x8408)  /* x^16 + x^12 + x^5 + 1 for LSB first */
 
 uint8_t ieee802154_hdr_ptr;
 uint8_t ieee802154_payload_ptr;
@@ -265,22 +265,7 @@ uint8_t ieee802154_frame_read(uint8_t *buf, ieee802154_frame_t *frame,
 /* crc with lsb first */
 uint16_t ieee802154_frame_get_fcs(const uint8_t *frame, uint8_t frame_len)
 {
-    uint16_t r = 0;
-
-    for (uint8_t byte = 0; byte < frame_len; ++byte) {
-        r ^= frame[byte];
-
-        for (uint8_t bit = 8; bit > 0; --bit) {
-            if (r & 0x0001) {
-                r = (r >> 1) ^ IEEE_802154_FCS_POLY;
-            }
-            else {
-                r = (r >> 1);
-            }
-        }
-    }
-
-    return r;
+    return crc16_ccitt_calc(frame, frame_len);
 }
 
 void ieee802154_frame_print_fcf_frame(ieee802154_frame_t *frame)
@@ -0,0 +1,558 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_ng_csma
+ * @file
+ * @brief       Implementation of the CSMA/CA MAC protocol
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "irq.h"
+#include "kernel.h"
+#include "msg.h"
+#include "random.h"
+#include "thread.h"
+#include "timex.h"
+#include "vtimer.h"
+#include "net/ng_csma.h"
+#include "net/ng_netbase.h"
+#include "net/ng_pktqueue.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+/* For PRIu16 etc. */
+#include <inttypes.h>
+#endif
+
+/**
+ * @brief   States of the transmission of the packet at the queue's head
+ */
+typedef enum {
+    _IDLE = 0,      /**< nothing to send */
+    _BACKOFF,       /**< waiting for the next clear channel assessment */
+    _WAIT_ACK,      /**< sent, waiting for the acknowledgement */
+} _state_t;
+
+/**
+ * @brief   A CSMA layer instance
+ */
+typedef struct {
+    ng_netdev_t *dev;               /**< the device, NULL if unused */
+    kernel_pid_t pid;               /**< PID of the instance's thread */
+    _state_t state;                 /**< state of the current transmission */
+    uint8_t nb;                     /**< number of backoffs (NB) */
+    uint8_t be;                     /**< backoff exponent (BE) */
+    uint8_t retries;                /**< retransmissions of current packet */
+    bool burst;                     /**< the last packet announced the
+                                     *   current one as pending */
+    vtimer_t timer;                 /**< backoff and acknowledgement timer */
+    timex_t deadline;               /**< time the timer expires at */
+    uint16_t timer_id;              /**< ID of the current timer, messages
+                                     *   of earlier timers are stale */
+    ng_pktqueue_t *queue;           /**< packets to send, head is current */
+    ng_pktqueue_t nodes[NG_CSMA_TX_QUEUE_SIZE]; /**< queue nodes */
+    ng_csma_stats_t stats;          /**< statistics */
+} _csma_t;
+
+static _csma_t _csma[NG_CSMA_NUMOF];
+
+static void _next(_csma_t *ctx);
+
+static _csma_t *_get_ctx(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < NG_CSMA_NUMOF; i++) {
+        if ((_csma[i].dev != NULL) && (_csma[i].pid == pid)) {
+            return &_csma[i];
+        }
+    }
+
+    return NULL;
+}
+
+static inline ng_netif_hdr_t *_netif_hdr(ng_pktsnip_t *pkt)
+{
+    return (ng_netif_hdr_t *)pkt->data;
+}
+
+static inline bool _is_unicast(ng_netif_hdr_t *hdr)
+{
+    return !(hdr->flags &
+             (NG_NETIF_HDR_FLAGS_BROADCAST | NG_NETIF_HDR_FLAGS_MULTICAST));
+}
+
+static bool _same_dst(ng_netif_hdr_t *a, ng_netif_hdr_t *b)
+{
+    return _is_unicast(a) && _is_unicast(b) &&
+           (a->dst_l2addr_len == b->dst_l2addr_len) &&
+           (memcmp(ng_netif_hdr_get_dst_addr(a), ng_netif_hdr_get_dst_addr(b),
+                   a->dst_l2addr_len) == 0);
+}
+
+static bool _get_flag(ng_netdev_t *dev, ng_netconf_opt_t opt)
+{
+    ng_netconf_enable_t enable = NETCONF_DISABLE;
+
+    return (dev->driver->get(dev, opt, &enable, sizeof(enable)) >= 0) &&
+           (enable == NETCONF_ENABLE);
+}
+
+static bool _channel_clear(ng_netdev_t *dev)
+{
+    ng_netconf_enable_t clear;
+
+    if (dev->driver->get(dev, NETCONF_OPT_IS_CHANNEL_CLR, &clear,
+                         sizeof(clear)) < 0) {
+        /* device can't tell, so just send */
+        return true;
+    }
+
+    return (clear == NETCONF_ENABLE);
+}
+
+/* unicasts are acknowledged if the device reports ACKs to us and does not
+ * retransmit on its own */
+static bool _wants_ack(ng_netdev_t *dev, ng_pktsnip_t *pkt)
+{
+    uint8_t retrans;
+
+    return _is_unicast(_netif_hdr(pkt)) &&
+           _get_flag(dev, NETCONF_OPT_AUTOACK) &&
+           _get_flag(dev, NETCONF_OPT_ACK_REPORT) &&
+           (dev->driver->get(dev, NETCONF_OPT_RETRANS, &retrans,
+                             sizeof(retrans)) == -ENOTSUP);
+}
+
+static void _set_timer(_csma_t *ctx, uint32_t usec, uint16_t type)
+{
+    timex_t interval;
+    void *id;
+
+    /* messages of the previous timer may still be queued, ignore them */
+    vtimer_remove(&ctx->timer);
+    id = (void *)(uintptr_t)(++ctx->timer_id);
+
+    if (usec == 0) {
+        /* go through the queue anyway, so pending messages are handled
+         * before */
+        msg_t msg;
+
+        msg.type = type;
+        msg.content.ptr = id;
+
+        if (msg_send_to_self(&msg)) {
+            /* already queued, so it can't get lost */
+            ctx->deadline = timex_set(UINT32_MAX, 0);
+            return;
+        }
+
+        /* queue is full, take the timer */
+        usec = 1;
+    }
+
+    interval = timex_set(0, usec);
+    timex_normalize(&interval);
+    vtimer_now(&ctx->deadline);
+    ctx->deadline = timex_add(ctx->deadline, interval);
+    vtimer_set_msg(&ctx->timer, interval, ctx->pid, type, id);
+}
+
+static void _backoff(_csma_t *ctx)
+{
+    uint32_t periods = 0;
+
+    if (ctx->be > 0) {
+        periods = genrand_uint32_range(0, 1 << ctx->be);
+    }
+
+    DEBUG("csma: backoff for %" PRIu32 " periods\n", periods);
+    ctx->state = _BACKOFF;
+    _set_timer(ctx, periods * NG_CSMA_BACKOFF_PERIOD, NG_CSMA_MSG_BACKOFF);
+}
+
+static void _start(_csma_t *ctx)
+{
+    ctx->nb = 0;
+    /* a pending packet follows right after the previous one */
+    ctx->be = (ctx->burst) ? 0 : NG_CSMA_MIN_BE;
+    ctx->burst = false;
+    _backoff(ctx);
+}
+
+/* finishes the current packet and counts it to the given statistic */
+static void _done(_csma_t *ctx, uint32_t *counter)
+{
+    ng_pktqueue_t *node = ng_pktqueue_remove_head(&ctx->queue);
+
+    (*counter)++;
+    ctx->burst = (counter == &ctx->stats.tx) &&
+                 (_netif_hdr(node->pkt)->flags & NG_NETIF_HDR_FLAGS_MORE_DATA);
+    ng_pktbuf_release(node->pkt);
+    node->pkt = NULL;
+    ctx->retries = 0;
+    ctx->state = _IDLE;
+    _next(ctx);
+}
+
+/* announces the next packet in the current one if it has the same
+ * destination */
+static void _announce(_csma_t *ctx)
+{
+    ng_pktqueue_t *head = ctx->queue;
+    ng_pktsnip_t *pkt;
+
+    if ((head->next == NULL) ||
+        !_same_dst(_netif_hdr(head->pkt), _netif_hdr(head->next->pkt)) ||
+        (_netif_hdr(head->pkt)->flags & NG_NETIF_HDR_FLAGS_MORE_DATA)) {
+        return;
+    }
+
+    if ((pkt = ng_pktbuf_start_write(head->pkt)) == NULL) {
+        return;
+    }
+
+    head->pkt = pkt;
+    _netif_hdr(pkt)->flags |= NG_NETIF_HDR_FLAGS_MORE_DATA;
+}
+
+static void _next(_csma_t *ctx)
+{
+    if (ctx->queue == NULL) {
+        ctx->burst = false;
+        return;
+    }
+
+    _announce(ctx);
+    _start(ctx);
+}
+
+static void _transmit(_csma_t *ctx)
+{
+    ng_netdev_t *dev = ctx->dev;
+    ng_pktsnip_t *pkt = ctx->queue->pkt;
+    bool ack = _wants_ack(dev, pkt);
+
+    /* keep the packet for retransmissions, the device releases it */
+    ng_pktbuf_hold(pkt, 1);
+
+    if (dev->driver->send_data(dev, pkt) < 0) {
+        DEBUG("csma: device failed to send\n");
+        _done(ctx, &ctx->stats.error);
+        return;
+    }
+
+    if (!ack) {
+        _done(ctx, &ctx->stats.tx);
+        return;
+    }
+
+    ctx->state = _WAIT_ACK;
+    _set_timer(ctx, NG_CSMA_ACK_TIMEOUT, NG_CSMA_MSG_ACK_TIMEOUT);
+}
+
+static void _backoff_expired(_csma_t *ctx)
+{
+    if (ctx->state != _BACKOFF) {
+        return;
+    }
+
+    if (_channel_clear(ctx->dev)) {
+        _transmit(ctx);
+        return;
+    }
+
+    DEBUG("csma: channel busy\n");
+    ctx->stats.busy++;
+
+    if (++ctx->nb > NG_CSMA_MAX_BACKOFFS) {
+        DEBUG("csma: channel access failure\n");
+        _done(ctx, &ctx->stats.access_fail);
+        return;
+    }
+
+    if (ctx->be < NG_CSMA_MAX_BE) {
+        ctx->be++;
+    }
+
+    _backoff(ctx);
+}
+
+static void _ack_timeout(_csma_t *ctx)
+{
+    if (ctx->state != _WAIT_ACK) {
+        return;
+    }
+
+    if (ctx->retries >= NG_CSMA_MAX_RETRIES) {
+        DEBUG("csma: no ACK, dropping packet\n");
+        _done(ctx, &ctx->stats.no_ack);
+        return;
+    }
+
+    DEBUG("csma: no ACK, retransmitting\n");
+    ctx->retries++;
+    ctx->stats.retries++;
+    _start(ctx);
+}
+
+static void _acked(_csma_t *ctx)
+{
+    if (ctx->state != _WAIT_ACK) {
+        return;
+    }
+
+    vtimer_remove(&ctx->timer);
+    _done(ctx, &ctx->stats.tx);
+}
+
+static void _timer_expired(_csma_t *ctx, msg_t *msg)
+{
+    if ((uintptr_t)msg->content.ptr != ctx->timer_id) {
+        DEBUG("csma: stale timer message\n");
+        return;
+    }
+
+    if (msg->type == NG_CSMA_MSG_BACKOFF) {
+        _backoff_expired(ctx);
+    }
+    else {
+        _ack_timeout(ctx);
+    }
+}
+
+/* the timer's message is dropped if the queue is full, so take over on
+ * the next message that arrives after the deadline */
+static void _check_timer(_csma_t *ctx)
+{
+    timex_t now;
+
+    if (ctx->state == _IDLE) {
+        return;
+    }
+
+    vtimer_now(&now);
+
+    if (timex_cmp(now, ctx->deadline) < 0) {
+        return;
+    }
+
+    DEBUG("csma: timer message lost\n");
+
+    if (ctx->state == _BACKOFF) {
+        _backoff_expired(ctx);
+    }
+    else {
+        _ack_timeout(ctx);
+    }
+}
+
+static void _enqueue(_csma_t *ctx, ng_pktsnip_t *pkt)
+{
+    ng_pktqueue_t *node = NULL;
+
+    for (unsigned i = 0; i < NG_CSMA_TX_QUEUE_SIZE; i++) {
+        if (ctx->nodes[i].pkt == NULL) {
+            node = &ctx->nodes[i];
+            break;
+        }
+    }
+
+    if (node == NULL) {
+        DEBUG("csma: queue full, dropping packet\n");
+        ctx->stats.full++;
+        ng_pktbuf_release(pkt);
+        return;
+    }
+
+    node->pkt = pkt;
+    ng_pktqueue_add(&ctx->queue, node);
+
+    if (ctx->state == _IDLE) {
+        _next(ctx);
+    }
+    else if (ctx->state == _BACKOFF) {
+        _announce(ctx);
+    }
+}
+
+/**
+ * @brief   Function called by the device driver on device events
+ *
+ * @param[in] event         type of event
+ * @param[in] data          optional parameter
+ */
+static void _event_cb(ng_netdev_event_t event, void *data)
+{
+    /* drivers call this from isr_event(), so from the instance's thread */
+    _csma_t *ctx = _get_ctx(thread_getpid());
+
+    DEBUG("csma: event triggered -> %i\n", event);
+
+    if (event == NETDEV_EVENT_RX_COMPLETE) {
+        ng_pktsnip_t *pkt;
+
+        /* get pointer to the received packet */
+        pkt = (ng_pktsnip_t *)data;
+
+        if (ctx != NULL) {
+            ctx->stats.rx++;
+        }
+
+        /* send the packet to everyone interested in it's type */
+        if (!ng_netapi_dispatch_receive(pkt->type, NG_NETREG_DEMUX_CTX_ALL, pkt)) {
+            DEBUG("csma: unable to forward packet of type %i\n", pkt->type);
+            ng_pktbuf_release(pkt);
+        }
+    }
+    else if ((event == NETDEV_EVENT_TX_ACKED) && (ctx != NULL)) {
+        _acked(ctx);
+    }
+}
+
+/**
+ * @brief   Startup code and event loop of the CSMA layer
+ *
+ * @param[in] args          expects a pointer to the instance
+ *
+ * @return                  never returns
+ */
+static void *_csma_thread(void *args)
+{
+    _csma_t *ctx = (_csma_t *)args;
+    ng_netdev_t *dev = ctx->dev;
+    ng_netapi_opt_t *opt;
+    int res;
+    msg_t msg, reply, msg_queue[NG_CSMA_MSG_QUEUE_SIZE];
+
+    /* setup the MAC layers message queue */
+    msg_init_queue(msg_queue, NG_CSMA_MSG_QUEUE_SIZE);
+    /* save the PID to the device descriptor and register the device */
+    ctx->pid = thread_getpid();
+    dev->mac_pid = ctx->pid;
+    ng_netif_add(dev->mac_pid);
+    /* register the event callback with the device driver */
+    dev->driver->add_event_callback(dev, _event_cb);
+
+    /* start the event loop */
+    while (1) {
+        DEBUG("csma: waiting for incoming messages\n");
+        msg_receive(&msg);
+        /* dispatch NETDEV, NETAPI and timer messages */
+        switch (msg.type) {
+            case NG_NETDEV_MSG_TYPE_EVENT:
+                DEBUG("csma: NG_NETDEV_MSG_TYPE_EVENT received\n");
+                dev->driver->isr_event(dev, msg.content.value);
+                break;
+            case NG_NETAPI_MSG_TYPE_SND:
+                DEBUG("csma: NG_NETAPI_MSG_TYPE_SND received\n");
+                _enqueue(ctx, (ng_pktsnip_t *)msg.content.ptr);
+                break;
+            case NG_CSMA_MSG_BACKOFF:
+            case NG_CSMA_MSG_ACK_TIMEOUT:
+                _timer_expired(ctx, &msg);
+                break;
+            case NG_NETAPI_MSG_TYPE_SET:
+                /* TODO: filter out MAC layer options -> for now forward
+                         everything to the device driver */
+                DEBUG("csma: NG_NETAPI_MSG_TYPE_SET received\n");
+                /* read incoming options */
+                opt = (ng_netapi_opt_t *)msg.content.ptr;
+                /* set option for device driver */
+                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+                DEBUG("csma: response of netdev->set: %i\n", res);
+                /* send reply to calling thread */
+                reply.type = NG_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            case NG_NETAPI_MSG_TYPE_GET:
+                /* TODO: filter out MAC layer options -> for now forward
+                         everything to the device driver */
+                DEBUG("csma: NG_NETAPI_MSG_TYPE_GET received\n");
+                /* read incoming options */
+                opt = (ng_netapi_opt_t *)msg.content.ptr;
+                /* get option from device driver */
+                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+                DEBUG("csma: response of netdev->get: %i\n", res);
+                /* send reply to calling thread */
+                reply.type = NG_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("csma: Unknown command %" PRIu16 "\n", msg.type);
+                break;
+        }
+
+        _check_timer(ctx);
+    }
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t ng_csma_init(char *stack, int stacksize, char priority,
+                          const char *name, ng_netdev_t *dev)
+{
+    _csma_t *ctx = NULL;
+    kernel_pid_t res;
+    unsigned state;
+
+    /* check if given netdev device is defined and the driver is set */
+    if (dev == NULL || dev->driver == NULL) {
+        return -ENODEV;
+    }
+
+    state = disableIRQ();
+
+    for (unsigned i = 0; i < NG_CSMA_NUMOF; i++) {
+        if (_csma[i].dev == NULL) {
+            ctx = &_csma[i];
+            memset(ctx, 0, sizeof(_csma_t));
+            ctx->pid = KERNEL_PID_UNDEF;
+            ctx->dev = dev;
+            break;
+        }
+    }
+
+    restoreIRQ(state);
+
+    if (ctx == NULL) {
+        return -ENOBUFS;
+    }
+
+    /* create new CSMA thread */
+    res = thread_create(stack, stacksize, priority, CREATE_STACKTEST,
+                        _csma_thread, (void *)ctx, name);
+    if (res <= 0) {
+        ctx->dev = NULL;
+        return -EINVAL;
+    }
+    return res;
+}
+
+int ng_csma_get_stats(kernel_pid_t pid, ng_csma_stats_t *stats)
+{
+    _csma_t *ctx = _get_ctx(pid);
+
+    if (ctx == NULL) {
+        return -ENOENT;
+    }
+
+    *stats = ctx->stats;
+
+    return 0;
+}
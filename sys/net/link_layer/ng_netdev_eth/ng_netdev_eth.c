@@ -50,6 +50,14 @@ ng_netdev_eth_t ng_netdev_eth;
 static uint8_t send_buffer[NG_ETHERNET_MAX_LEN];
 static uint8_t recv_buffer[NG_ETHERNET_MAX_LEN];
 
+/**
+ * @brief   Maximum number of elements in the gather vector for dev_eth
+ *          devices that support eth_driver_t::send_vec
+ */
+#ifndef NG_NETDEV_ETH_IOVEC_NUMOF
+#define NG_NETDEV_ETH_IOVEC_NUMOF   (8)
+#endif
+
 #define _ISR_EVENT_RX (1U)
 
 /* driver function definitions */
@@ -85,9 +93,16 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
+/* build Ethernet header from pkt */
+static int _marshall_ethernet_hdr(ng_netdev_eth_t *dev, ng_ethernet_hdr_t *hdr,
+                                  ng_pktsnip_t *pkt);
+
 /* build Ethernet packet from pkt */
 static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_t *pkt);
 
+/* send Ethernet packet from pkt without copying its payload */
+static int _send_vec(ng_netdev_eth_t *dev, ng_pktsnip_t *pkt);
+
 /* build ISR handler for ISR events */
 void _trigger_isr_event(void);
 
@@ -110,6 +125,17 @@ static int _send_data(ng_netdev_t *netdev, ng_pktsnip_t *pkt)
 
     DEBUG("\n");
 
+    if (dev->ethdev->driver->send_vec != NULL) {
+        nsent = _send_vec(dev, pkt);
+
+        if (nsent != -EOVERFLOW) {
+            ng_pktbuf_release(pkt);
+            return nsent;
+        }
+
+        DEBUG("ng_netdev_eth: too many snips for gather, copying\n");
+    }
+
     to_send = _marshall_ethernet(dev, send_buffer, pkt);
     ng_pktbuf_release(pkt);
 
@@ -374,10 +400,9 @@ static inline void _addr_set_multicast(uint8_t *dst, ng_pktsnip_t *payload)
     }
 }
 
-static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_t *pkt)
+static int _marshall_ethernet_hdr(ng_netdev_eth_t *dev, ng_ethernet_hdr_t *hdr,
+                                  ng_pktsnip_t *pkt)
 {
-    int data_len = 0;
-    ng_ethernet_hdr_t *hdr = (ng_ethernet_hdr_t *)buffer;
     ng_netif_hdr_t *netif_hdr;
     ng_pktsnip_t *payload;
 
@@ -404,7 +429,7 @@ static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_
 
     /* set ethernet header */
     if (netif_hdr->src_l2addr_len == NG_ETHERNET_ADDR_LEN) {
-        memcpy(hdr->dst, ng_netif_hdr_get_src_addr(netif_hdr),
+        memcpy(hdr->src, ng_netif_hdr_get_src_addr(netif_hdr),
                netif_hdr->src_l2addr_len);
     }
     else {
@@ -431,6 +456,19 @@ static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_
           hdr->dst[0], hdr->dst[1], hdr->dst[2],
           hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
+    return 0;
+}
+
+static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_t *pkt)
+{
+    int data_len = 0, res;
+    ng_pktsnip_t *payload;
+
+    if ((res = _marshall_ethernet_hdr(dev, (ng_ethernet_hdr_t *)buffer, pkt)) < 0) {
+        return res;
+    }
+
+    payload = pkt->next;
     data_len += sizeof(ng_ethernet_hdr_t);
 
     while (payload != NULL) {
@@ -458,6 +496,56 @@ static int _marshall_ethernet(ng_netdev_eth_t *dev, uint8_t *buffer, ng_pktsnip_
     return data_len;
 }
 
+static int _send_vec(ng_netdev_eth_t *dev, ng_pktsnip_t *pkt)
+{
+    static const uint8_t padding[NG_ETHERNET_MIN_LEN];
+    ng_netdev_iovec_t vector[NG_NETDEV_ETH_IOVEC_NUMOF];
+    ng_ethernet_hdr_t hdr;
+    dev_eth_t *ethdev = dev->ethdev;
+    int count, res;
+    size_t data_len;
+
+    if ((res = _marshall_ethernet_hdr(dev, &hdr, pkt)) < 0) {
+        return res;
+    }
+
+    vector[0].iov_base = &hdr;
+    vector[0].iov_len = sizeof(ng_ethernet_hdr_t);
+
+    /* keep last element free for padding */
+    count = ng_netdev_gather(pkt->next, &vector[1], NG_NETDEV_ETH_IOVEC_NUMOF - 2);
+
+    if (count < 0) {
+        return count;
+    }
+
+    count++;
+    data_len = sizeof(ng_ethernet_hdr_t) + ng_pkt_len(pkt->next);
+
+    if (data_len > NG_ETHERNET_MAX_LEN) {
+        DEBUG("ng_netdev_eth: Packet too big for ethernet frame\n");
+        return -ENOBUFS;
+    }
+
+    /* Pad to minimum payload size (see _marshall_ethernet()) */
+    if (data_len < NG_ETHERNET_MIN_LEN) {
+        vector[count].iov_base = (void *)padding;
+        vector[count].iov_len = NG_ETHERNET_MIN_LEN - data_len;
+        data_len = NG_ETHERNET_MIN_LEN;
+        count++;
+    }
+
+    DEBUG("ng_netdev_eth: send %u bytes in %d chunks\n", (unsigned)data_len,
+          count);
+
+    if ((res = ethdev->driver->send_vec(ethdev, vector, count)) < 0) {
+        DEBUG("writev\n");
+        return -EIO;
+    }
+
+    return res;
+}
+
 void dev_eth_isr(dev_eth_t* dev)
 {
     (void)dev;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_ng_slip_codec
+ * @{
+ *
+ * @file
+ * @brief       SLIP encoder and decoder implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "net/ng_slip/codec.h"
+
+static inline bool _is_special(uint8_t c)
+{
+    return (c == NG_SLIP_END) || (c == NG_SLIP_ESC);
+}
+
+static inline void _put(ng_slip_decoder_t *dec, uint8_t c)
+{
+    if (dec->len < dec->size) {
+        dec->buf[dec->len] = c;
+    }
+    dec->len++;
+}
+
+bool ng_slip_decode(ng_slip_decoder_t *dec, const uint8_t *in, size_t *len)
+{
+    size_t i = 0;
+
+    while (i < *len) {
+        size_t run = i;
+
+        if (dec->esc) {
+            dec->esc = false;
+
+            switch (in[i++]) {
+                case NG_SLIP_END_ESC:
+                    _put(dec, NG_SLIP_END);
+                    break;
+
+                case NG_SLIP_ESC_ESC:
+                    _put(dec, NG_SLIP_ESC);
+                    break;
+
+                default:
+                    /* invalid escape sequence: drop the byte */
+                    break;
+            }
+
+            continue;
+        }
+
+        /* copy run of ordinary bytes in one go */
+        while ((run < *len) && !_is_special(in[run])) {
+            run++;
+        }
+
+        if (run > i) {
+            size_t n = run - i;
+
+            if (dec->len < dec->size) {
+                size_t space = dec->size - dec->len;
+                memcpy(dec->buf + dec->len, in + i, (n < space) ? n : space);
+            }
+
+            dec->len += n;
+            i = run;
+            continue;
+        }
+
+        if (in[i++] == NG_SLIP_END) {
+            *len = i;
+            return true;
+        }
+
+        dec->esc = true;
+    }
+
+    return false;
+}
+
+size_t ng_slip_encode(uint8_t *out, size_t out_len, const uint8_t *in,
+                      size_t *len)
+{
+    size_t i = 0, o = 0;
+
+    while ((i < *len) && (o < out_len)) {
+        size_t run = i;
+
+        /* copy run of ordinary bytes in one go */
+        while ((run < *len) && ((run - i) < (out_len - o)) &&
+               !_is_special(in[run])) {
+            run++;
+        }
+
+        if (run > i) {
+            memcpy(out + o, in + i, run - i);
+            o += run - i;
+            i = run;
+            continue;
+        }
+
+        if (!_is_special(in[i]) || ((out_len - o) < 2)) {
+            break;
+        }
+
+        out[o++] = NG_SLIP_ESC;
+        out[o++] = (in[i++] == NG_SLIP_END) ? NG_SLIP_END_ESC : NG_SLIP_ESC_ESC;
+    }
+
+    *len = i;
+    return o;
+}
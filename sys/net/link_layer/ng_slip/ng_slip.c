@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "irq.h"
 #include "kernel.h"
 #include "kernel_types.h"
 #include "msg.h"
@@ -34,75 +35,97 @@
 #include "net/ng_ipv6/hdr.h"
 
 #include "net/ng_slip.h"
+#include "net/ng_slip/codec.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-#define _SLIP_END               ('\xc0')
-#define _SLIP_ESC               ('\xdb')
-#define _SLIP_END_ESC           ('\xdc')
-#define _SLIP_ESC_ESC           ('\xdd')
-
 #define _SLIP_MSG_TYPE          (0xc1dc)    /* chosen randomly */
+#define _SLIP_MSG_TX            (0xc1dd)
 #define _SLIP_NAME              "SLIP"
 #define _SLIP_MSG_QUEUE_SIZE    (8U)
 
+/* size of the blocks that are moved between the ring buffers and the codec */
+#define _SLIP_CHUNK_SIZE        (64U)
+/* the thread continues encoding once the TX buffer drained to this level */
+#define _SLIP_TX_LOW_WATER      (NG_SLIP_BUFSIZE / 4)
+
 #define _SLIP_DEV(arg)    ((ng_slip_dev_t *)arg)
 
 /* UART callbacks */
 static void _slip_rx_cb(void *arg, char data)
 {
-    if (data == _SLIP_END) {
-        msg_t msg;
+    ng_slip_dev_t *dev = _SLIP_DEV(arg);
 
-        msg.type = _SLIP_MSG_TYPE;
-        msg.content.value = _SLIP_DEV(arg)->in_bytes;
+    /* just store the raw bytes, decoding is done by the thread */
+    if ((uint8_t)data != NG_SLIP_END) {
+        if (!dev->in_drop) {
+            if (ringbuffer_full(&dev->in_buf)) {
+                dev->in_drop = 1;
+            }
+            else {
+                ringbuffer_add_one(&dev->in_buf, data);
+                dev->in_bytes++;
+            }
+        }
 
-        msg_send_int(&msg, _SLIP_DEV(arg)->slip_pid);
+        return;
+    }
 
-        _SLIP_DEV(arg)->in_bytes = 0;
+    if (dev->in_drop || (dev->rx_num >= NG_SLIP_RX_QUEUE_SIZE)) {
+        /* take the bytes of the dropped frame back from the buffer's tail */
+        dev->in_buf.avail -= dev->in_bytes;
     }
+    else if (dev->in_bytes > 0) {
+        msg_t msg;
 
-    if (_SLIP_DEV(arg)->in_esc) {
-        _SLIP_DEV(arg)->in_esc = 0;
+        dev->rx_frames[(dev->rx_head + dev->rx_num) % NG_SLIP_RX_QUEUE_SIZE] =
+            dev->in_bytes;
+        dev->rx_num++;
 
-        switch (data) {
-            case (_SLIP_END_ESC):
-                if (ringbuffer_add_one(_SLIP_DEV(arg)->in_buf, _SLIP_END) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
+        msg.type = _SLIP_MSG_TYPE;
+        msg.content.value = dev->in_bytes;
 
-                break;
+        msg_send_int(&msg, dev->slip_pid);
+    }
 
-            case (_SLIP_ESC_ESC):
-                if (ringbuffer_add_one(_SLIP_DEV(arg)->in_buf, _SLIP_ESC) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
+    dev->in_bytes = 0;
+    dev->in_drop = 0;
+}
 
-                break;
+/* wakes the thread up to continue encoding, tx_wait stays set if the
+ * message got lost */
+static void _slip_tx_wakeup(ng_slip_dev_t *dev)
+{
+    msg_t msg;
 
-            default:
-                break;
-        }
-    }
-    else if (data == _SLIP_ESC) {
-        _SLIP_DEV(arg)->in_esc = 1;
-    }
-    else {
-        if (ringbuffer_add_one(_SLIP_DEV(arg)->in_buf, data) < 0) {
-            _SLIP_DEV(arg)->in_bytes++;
-        }
+    msg.type = _SLIP_MSG_TX;
+
+    if (msg_send_int(&msg, dev->slip_pid) > 0) {
+        dev->tx_wait = 0;
     }
 }
 
 int _slip_tx_cb(void *arg)
 {
-    if (_SLIP_DEV(arg)->out_buf->avail > 0) {
-        char c = (char)ringbuffer_get_one(_SLIP_DEV(arg)->out_buf);
-        uart_write((uart_t)(_SLIP_DEV(arg)->uart), c);
+    ng_slip_dev_t *dev = _SLIP_DEV(arg);
+
+    if (dev->out_buf.avail > 0) {
+        char c = (char)ringbuffer_get_one(&dev->out_buf);
+        uart_write((uart_t)(dev->uart), c);
+
+        if (dev->tx_wait && (dev->out_buf.avail <= _SLIP_TX_LOW_WATER)) {
+            _slip_tx_wakeup(dev);
+        }
+
         return 1;
     }
 
+    /* retry if the thread's message queue was full before */
+    if (dev->tx_wait) {
+        _slip_tx_wakeup(dev);
+    }
+
     return 0;
 }
 
@@ -112,29 +135,58 @@ static void _slip_receive(ng_slip_dev_t *dev, size_t bytes)
     ng_netif_hdr_t *hdr;
     ng_netreg_entry_t *sendto;
     ng_pktsnip_t *pkt, *netif_hdr;
+    ng_slip_decoder_t dec;
+
+    netif_hdr = ng_pktbuf_add(NULL, NULL, sizeof(ng_netif_hdr_t),
+                              NG_NETTYPE_NETIF);
+    pkt = NULL;
+
+    if (netif_hdr != NULL) {
+        hdr = netif_hdr->data;
+        ng_netif_hdr_init(hdr, 0, 0);
+        hdr->if_pid = thread_getpid();
 
-    pkt = ng_pktbuf_add(NULL, NULL, bytes, NG_NETTYPE_UNDEF);
+        /* the decoded frame is never larger than the encoded one */
+        pkt = ng_pktbuf_add(netif_hdr, NULL, bytes, NG_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            ng_pktbuf_release(netif_hdr);
+        }
+    }
+
+    /* without packet the frame still needs to be removed from the buffer */
+    ng_slip_decoder_init(&dec, (pkt != NULL) ? pkt->data : NULL,
+                         (pkt != NULL) ? bytes : 0);
+
+    while (bytes > 0) {
+        uint8_t chunk[_SLIP_CHUNK_SIZE];
+        size_t n = (bytes < sizeof(chunk)) ? bytes : sizeof(chunk);
+        unsigned state = disableIRQ();
+
+        n = ringbuffer_get(&dev->in_buf, (char *)chunk, n);
+        restoreIRQ(state);
+
+        if (n == 0) {
+            DEBUG("slip: could not read %zu bytes from ringbuffer\n", bytes);
+            break;
+        }
+
+        bytes -= n;
+        ng_slip_decode(&dec, chunk, &n);
+    }
 
     if (pkt == NULL) {
         DEBUG("slip: no space left in packet buffer\n");
         return;
     }
 
-    netif_hdr = ng_pktbuf_add(pkt, NULL, sizeof(ng_netif_hdr_t),
-                              NG_NETTYPE_NETIF);
-
-    if (netif_hdr == NULL) {
-        DEBUG("slip: no space left in packet buffer\n");
+    if ((bytes > 0) || (dec.len == 0)) {
         ng_pktbuf_release(pkt);
         return;
     }
 
-    hdr = netif_hdr->data;
-    ng_netif_hdr_init(hdr, 0, 0);
-    hdr->if_pid = thread_getpid();
-
-    if (ringbuffer_get(dev->in_buf, pkt->data, bytes) != bytes) {
-        DEBUG("slip: could not read %zu bytes from ringbuffer\n", bytes);
+    if ((dec.len < pkt->size) && (ng_pktbuf_realloc_data(pkt, dec.len) != 0)) {
+        DEBUG("slip: unable to shrink packet to %zu bytes\n", dec.len);
         ng_pktbuf_release(pkt);
         return;
     }
@@ -150,6 +202,7 @@ static void _slip_receive(ng_slip_dev_t *dev, size_t bytes)
     if (sendto == NULL) {
         DEBUG("slip: unable to forward packet of type %i\n", pkt->type);
         ng_pktbuf_release(pkt);
+        return;
     }
 
     ng_pktbuf_hold(pkt, ng_netreg_num(pkt->type, NG_NETREG_DEMUX_CTX_ALL) - 1);
@@ -161,50 +214,132 @@ static void _slip_receive(ng_slip_dev_t *dev, size_t bytes)
     }
 }
 
-static inline void _slip_send_char(ng_slip_dev_t *dev, char c)
+/* handle all frames the UART callback completed so far */
+static void _slip_receive_all(ng_slip_dev_t *dev)
 {
-    ringbuffer_add_one(dev->out_buf, c);
-    uart_tx_begin(dev->uart);
+    while (1) {
+        size_t bytes;
+        unsigned state = disableIRQ();
+
+        if (dev->rx_num == 0) {
+            restoreIRQ(state);
+            return;
+        }
+
+        bytes = dev->rx_frames[dev->rx_head];
+        dev->rx_head = (dev->rx_head + 1) % NG_SLIP_RX_QUEUE_SIZE;
+        dev->rx_num--;
+        restoreIRQ(state);
+
+        _slip_receive(dev, bytes);
+    }
 }
 
-/* SLIP send handler */
-static void _slip_send(ng_slip_dev_t *dev, ng_pktsnip_t *pkt)
+/* encode queued packets into the TX buffer as long as there is space */
+static void _slip_send_all(ng_slip_dev_t *dev)
 {
-    ng_pktsnip_t *ptr;
+    unsigned state = disableIRQ();
 
-    ptr = pkt->next;    /* ignore ng_netif_hdr_t, we don't need it */
+    /* a wakeup of the UART callback is not needed anymore */
+    dev->tx_wait = 0;
+    restoreIRQ(state);
 
-    while (ptr != NULL) {
-        DEBUG("slip: send pktsnip of length %zu over UART_%d\n", ptr->size, uart);
-        char *data = ptr->data;
+    while (dev->tx_num > 0) {
+        uint8_t chunk[_SLIP_CHUNK_SIZE];
+        size_t space, n = 0;
 
-        for (size_t i = 0; i < ptr->size; i++) {
-            switch (data[i]) {
-                case _SLIP_END:
-                    DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
-                    break;
+        state = disableIRQ();
+        space = ringbuffer_get_free(&dev->out_buf);
+        restoreIRQ(state);
 
-                case _SLIP_ESC:
-                    DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
-                    break;
+        if (space > sizeof(chunk)) {
+            space = sizeof(chunk);
+        }
 
-                default:
-                    _slip_send_char(dev, data[i]);
+        while ((dev->tx_snip != NULL) && (n < space)) {
+            size_t len = dev->tx_snip->size - dev->tx_offset;
 
-                    break;
+            n += ng_slip_encode(chunk + n, space - n,
+                                (uint8_t *)dev->tx_snip->data + dev->tx_offset,
+                                &len);
+            dev->tx_offset += len;
+
+            if (dev->tx_offset < dev->tx_snip->size) {
+                break;
             }
+
+            dev->tx_snip = dev->tx_snip->next;
+            dev->tx_offset = 0;
         }
 
-        ptr = ptr->next;
+        if ((dev->tx_snip == NULL) && (n < space)) {
+            chunk[n++] = NG_SLIP_END;
+            ng_pktbuf_release(dev->tx_queue[dev->tx_head]);
+            dev->tx_head = (dev->tx_head + 1) % NG_SLIP_TX_QUEUE_SIZE;
+            dev->tx_num--;
+
+            if (dev->tx_num > 0) {
+                /* ignore ng_netif_hdr_t, we don't need it */
+                dev->tx_snip = dev->tx_queue[dev->tx_head]->next;
+                dev->tx_offset = 0;
+            }
+        }
+
+        if (n > 0) {
+            state = disableIRQ();
+            ringbuffer_add(&dev->out_buf, (char *)chunk, n);
+            restoreIRQ(state);
+            uart_tx_begin(dev->uart);
+            continue;
+        }
+
+        /* TX buffer is full: wait for the UART callback to drain it */
+        state = disableIRQ();
+
+        if (dev->out_buf.avail > _SLIP_TX_LOW_WATER) {
+            dev->tx_wait = 1;
+            restoreIRQ(state);
+            return;
+        }
+
+        restoreIRQ(state);
+    }
+}
+
+/* continues encoding if the TX buffer drained while the wakeup of the UART
+ * callback got lost */
+static void _slip_send_resume(ng_slip_dev_t *dev)
+{
+    unsigned state = disableIRQ();
+    bool resume = !dev->tx_wait || (dev->out_buf.avail <= _SLIP_TX_LOW_WATER);
+
+    restoreIRQ(state);
+
+    if (resume) {
+        _slip_send_all(dev);
+    }
+}
+
+/* SLIP send handler */
+static void _slip_send(ng_slip_dev_t *dev, ng_pktsnip_t *pkt)
+{
+    if (dev->tx_num >= NG_SLIP_TX_QUEUE_SIZE) {
+        DEBUG("slip: TX queue full, dropping packet\n");
+        ng_pktbuf_release(pkt);
+        return;
     }
 
-    _slip_send_char(dev, _SLIP_END);
+    DEBUG("slip: queue packet of length %zu for UART_%d\n",
+          ng_pkt_len(pkt->next), dev->uart);
+    dev->tx_queue[(dev->tx_head + dev->tx_num) % NG_SLIP_TX_QUEUE_SIZE] = pkt;
+
+    if (dev->tx_num++ == 0) {
+        /* ignore ng_netif_hdr_t, we don't need it */
+        dev->tx_snip = pkt->next;
+        dev->tx_offset = 0;
+    }
 
-    ng_pktbuf_release(pkt);
+    _slip_send_resume(dev);
 }
 
 static void *_slip(void *args)
@@ -216,7 +351,7 @@ static void *_slip(void *args)
     dev->slip_pid = thread_getpid();
     ng_netif_add(dev->slip_pid);
 
-    DEBUG("slip: SLIP runs on UART_%d\n", uart);
+    DEBUG("slip: SLIP runs on UART_%d\n", dev->uart);
 
     while (1) {
         DEBUG("slip: waiting for incoming messages\n");
@@ -225,7 +360,17 @@ static void *_slip(void *args)
         switch (msg.type) {
             case _SLIP_MSG_TYPE:
                 DEBUG("slip: incoming message from UART in buffer\n");
-                _slip_receive(dev, (size_t)msg.content.value);
+                _slip_receive_all(dev);
+
+                if (dev->tx_wait) {
+                    _slip_send_resume(dev);
+                }
+
+                break;
+
+            case _SLIP_MSG_TX:
+                DEBUG("slip: space in TX buffer\n");
+                _slip_send_all(dev);
                 break;
 
             case NG_NETAPI_MSG_TYPE_SND:
@@ -255,13 +400,21 @@ kernel_pid_t ng_slip_init(ng_slip_dev_t *dev, uart_t uart, uint32_t baudrate,
     kernel_pid_t pid;
 
     /* reset device descriptor fields */
+    dev->uart = uart;
     dev->in_bytes = 0;
-    dev->in_esc = 0;
+    dev->in_drop = 0;
+    dev->rx_head = 0;
+    dev->rx_num = 0;
+    dev->tx_head = 0;
+    dev->tx_num = 0;
+    dev->tx_wait = 0;
+    dev->tx_snip = NULL;
+    dev->tx_offset = 0;
     dev->slip_pid = KERNEL_PID_UNDEF;
 
     /* initialize buffers */
-    ringbuffer_init(dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
-    ringbuffer_init(dev->out_buf, dev->tx_mem, sizeof(dev->tx_mem));
+    ringbuffer_init(&dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
+    ringbuffer_init(&dev->out_buf, dev->tx_mem, sizeof(dev->tx_mem));
 
     /* initialize UART */
     DEBUG("slip: initialize UART_%d\n", uart);
@@ -280,5 +433,5 @@ kernel_pid_t ng_slip_init(ng_slip_dev_t *dev, uart_t uart, uint32_t baudrate,
         DEBUG("slip: unable to create SLIP thread\n");
         return -EFAULT;
     }
-    return res;
+    return pid;
 }
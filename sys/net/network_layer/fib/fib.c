@@ -23,6 +23,8 @@
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
+#include "bitarithm.h"
+#include "hashes.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -59,13 +61,74 @@ static universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
 /**
  * @brief maximum number of FIB tables entries handled
  */
+#ifndef FIB_MAX_FIB_TABLE_ENTRIES
 #define FIB_MAX_FIB_TABLE_ENTRIES (20)
+#endif
+
+/**
+ * @brief number of slots of the destination index (keeps the load factor <= 0.5)
+ */
+#define FIB_INDEX_SIZE (FIB_MAX_FIB_TABLE_ENTRIES << 1)
+
+/**
+ * @brief maximum prefix length in bits of a destination
+ */
+#define FIB_MAX_PREFIX_LEN (UNIVERSAL_ADDRESS_SIZE << 3)
 
 /**
  * @brief array of the FIB tables
  */
 static fib_entry_t fib_table[FIB_MAX_FIB_TABLE_ENTRIES];
 
+/**
+ * @brief open addressing hash index over the destinations of fib_table.
+ *        A slot holds the position of the entry in fib_table + 1, 0 marks an empty slot.
+ */
+static uint16_t fib_index[FIB_INDEX_SIZE];
+
+/**
+ * @brief number of entries in fib_table per destination prefix length.
+ *        Lookups only probe fib_index for prefix lengths actually in use.
+ */
+static uint16_t fib_prefix_len_count[FIB_MAX_PREFIX_LEN + 1];
+
+/**
+ * @brief marks a fib_table entry as not being contained in fib_expiry_heap
+ */
+#define FIB_EXPIRY_NONE (0xFFFF)
+
+/**
+ * @brief binary min-heap of the positions in fib_table of all entries
+ *        with a finite lifetime, ordered by their lifetime
+ */
+static uint16_t fib_expiry_heap[FIB_MAX_FIB_TABLE_ENTRIES];
+
+/**
+ * @brief number of entries in fib_expiry_heap
+ */
+static size_t fib_expiry_heap_size = 0;
+
+/**
+ * @brief position of each fib_table entry in fib_expiry_heap (or FIB_EXPIRY_NONE)
+ */
+static uint16_t fib_expiry_heap_pos[FIB_MAX_FIB_TABLE_ENTRIES];
+
+/**
+ * @brief timer firing on the lifetime of the entry at the top of fib_expiry_heap
+ */
+static vtimer_t fib_expiry_timer;
+
+/**
+ * @brief the point in time fib_expiry_timer is set to, {0, 0} if it is not set
+ */
+static timex_t fib_expiry_timer_target;
+
+/**
+ * @brief set by fib_expiry_timer to signal that entries have expired.
+ *        The entries are removed on the next access to the FIB.
+ */
+static volatile bool fib_expiry_pending = false;
+
 /**
  * @brief convert given ms to a point in time from now on in the future
  * @param[in]  ms     the milliseconds to be converted
@@ -73,14 +136,358 @@ static fib_entry_t fib_table[FIB_MAX_FIB_TABLE_ENTRIES];
  */
 static void fib_ms_to_timex(uint32_t ms, timex_t *timex)
 {
-    vtimer_now(timex);
-    timex->seconds += ms / 1000;
-    timex->microseconds += (ms - timex->seconds * 1000) * 1000;
+    timex_t now;
+    vtimer_now(&now);
+    *timex = timex_add(now, timex_set(ms / 1000, (ms % 1000) * 1000));
+}
+
+/**
+ * @brief returns the prefix length in bits of the given address,
+ *        i.e. the number of bits up to and including the last bit set
+ *
+ * @param[in] addr       the address
+ * @param[in] addr_size  the address size in bytes
+ *
+ * @return the prefix length in bits, 0 for an all zeros address
+ */
+static size_t fib_prefix_len(uint8_t *addr, size_t addr_size)
+{
+    for (size_t i = addr_size; i > 0; --i) {
+        if (addr[i - 1] != 0) {
+            return (i << 3) - bitarithm_lsb(addr[i - 1]);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief sets all bits behind the first prefix_len bits of the given address to 0
+ *
+ * @param[in, out] addr    the address to be masked
+ * @param[in] addr_size    the address size in bytes
+ * @param[in] prefix_len   the number of leading bits to keep
+ */
+static void fib_mask_prefix(uint8_t *addr, size_t addr_size, size_t prefix_len)
+{
+    size_t i = prefix_len >> 3;
+
+    if ((prefix_len & 0x07) != 0) {
+        addr[i] &= 0xff << (8 - (prefix_len & 0x07));
+        i++;
+    }
+
+    if (i < addr_size) {
+        memset(&addr[i], 0, addr_size - i);
+    }
+}
+
+/**
+ * @brief returns the home slot in fib_index for the given address
+ */
+static inline size_t fib_index_hash(uint8_t *addr, size_t addr_size)
+{
+    return fnv_hash(addr, addr_size) % FIB_INDEX_SIZE;
+}
+
+/**
+ * @brief searches fib_index for the entry with exactly the given destination
+ *
+ * @param[in] addr       the destination address (trailing bits must be 0)
+ * @param[in] addr_size  the destination address size
+ *
+ * @return the position of the entry in fib_table
+ *         -ENOENT if no entry is indexed for the destination
+ */
+static int fib_index_find(uint8_t *addr, size_t addr_size)
+{
+    size_t slot = fib_index_hash(addr, addr_size);
+
+    while (fib_index[slot] != 0) {
+        universal_address_container_t *global = fib_table[fib_index[slot] - 1].global;
+
+        if ((global->address_size == addr_size)
+            && (memcmp(global->address, addr, addr_size) == 0)) {
+            return fib_index[slot] - 1;
+        }
+
+        slot = (slot + 1) % FIB_INDEX_SIZE;
+    }
+
+    return -ENOENT;
+}
+
+/**
+ * @brief adds the entry at the given position of fib_table to fib_index
+ *
+ * @param[in] pos  the position of the entry in fib_table
+ */
+static void fib_index_add(size_t pos)
+{
+    universal_address_container_t *global = fib_table[pos].global;
+    size_t slot = fib_index_hash(global->address, global->address_size);
+
+    /* the index is twice the size of fib_table so we always find a free slot */
+    while (fib_index[slot] != 0) {
+        slot = (slot + 1) % FIB_INDEX_SIZE;
+    }
+
+    fib_index[slot] = pos + 1;
+    fib_prefix_len_count[fib_prefix_len(global->address, global->address_size)]++;
+}
+
+/**
+ * @brief removes the entry at the given position of fib_table from fib_index.
+ *        Subsequent entries of the probe sequence are shifted back,
+ *        so no tombstones are required.
+ *
+ * @param[in] pos  the position of the entry in fib_table
+ */
+static void fib_index_remove(size_t pos)
+{
+    universal_address_container_t *global = fib_table[pos].global;
+    size_t hole = fib_index_hash(global->address, global->address_size);
+
+    while (fib_index[hole] != (pos + 1)) {
+        if (fib_index[hole] == 0) {
+            /* the entry is not indexed */
+            return;
+        }
+
+        hole = (hole + 1) % FIB_INDEX_SIZE;
+    }
+
+    fib_index[hole] = 0;
+    fib_prefix_len_count[fib_prefix_len(global->address, global->address_size)]--;
+
+    for (size_t next = (hole + 1) % FIB_INDEX_SIZE; fib_index[next] != 0;
+         next = (next + 1) % FIB_INDEX_SIZE) {
+        global = fib_table[fib_index[next] - 1].global;
+        size_t home = fib_index_hash(global->address, global->address_size);
+
+        /* move the entry to the hole unless its home slot lies cyclically in (hole, next] */
+        if ((hole < next) ? ((home <= hole) || (home > next))
+                          : ((home <= hole) && (home > next))) {
+            fib_index[hole] = fib_index[next];
+            fib_index[next] = 0;
+            hole = next;
+        }
+    }
+}
+
+/**
+ * @brief moves the entry at the given index of fib_expiry_heap to the given index
+ */
+static inline void fib_expiry_heap_set(size_t index, uint16_t pos)
+{
+    fib_expiry_heap[index] = pos;
+    fib_expiry_heap_pos[pos] = index;
+}
+
+/**
+ * @brief restores the heap property of fib_expiry_heap for the entry at the given index
+ *
+ * @param[in] index  the index in fib_expiry_heap of the entry that changed
+ */
+static void fib_expiry_heap_fix(size_t index)
+{
+    uint16_t pos = fib_expiry_heap[index];
+
+    /* sift up */
+    while (index > 0) {
+        size_t parent = (index - 1) >> 1;
+
+        if (timex_cmp(fib_table[fib_expiry_heap[parent]].lifetime,
+                      fib_table[pos].lifetime) <= 0) {
+            break;
+        }
+
+        fib_expiry_heap_set(index, fib_expiry_heap[parent]);
+        index = parent;
+    }
+
+    /* sift down */
+    for (size_t child = (index << 1) + 1; child < fib_expiry_heap_size;
+         child = (index << 1) + 1) {
+        if (((child + 1) < fib_expiry_heap_size)
+            && (timex_cmp(fib_table[fib_expiry_heap[child + 1]].lifetime,
+                          fib_table[fib_expiry_heap[child]].lifetime) < 0)) {
+            child++;
+        }
+
+        if (timex_cmp(fib_table[pos].lifetime, fib_table[fib_expiry_heap[child]].lifetime) <= 0) {
+            break;
+        }
+
+        fib_expiry_heap_set(index, fib_expiry_heap[child]);
+        index = child;
+    }
+
+    fib_expiry_heap_set(index, pos);
+}
+
+/**
+ * @brief removes the entry at the given position of fib_table from fib_expiry_heap
+ *
+ * @param[in] pos  the position of the entry in fib_table
+ */
+static void fib_expiry_heap_remove(size_t pos)
+{
+    size_t index = fib_expiry_heap_pos[pos];
+
+    if (index == FIB_EXPIRY_NONE) {
+        return;
+    }
+
+    fib_expiry_heap_pos[pos] = FIB_EXPIRY_NONE;
+    fib_expiry_heap_size--;
+
+    if (index < fib_expiry_heap_size) {
+        /* fill the gap with the last entry of the heap */
+        fib_expiry_heap[index] = fib_expiry_heap[fib_expiry_heap_size];
+        fib_expiry_heap_fix(index);
+    }
+}
+
+/**
+ * @brief sets the lifetime of the entry at the given position of fib_table
+ *        and adds or removes the entry to or from fib_expiry_heap accordingly
+ *
+ * @param[in] pos       the position of the entry in fib_table
+ * @param[in] lifetime  the lifetime in ms
+ */
+static void fib_set_lifetime(size_t pos, uint32_t lifetime)
+{
+    if (lifetime < FIB_LIFETIME_NO_EXPIRE) {
+        fib_ms_to_timex(lifetime, &fib_table[pos].lifetime);
+
+        if (fib_expiry_heap_pos[pos] == FIB_EXPIRY_NONE) {
+            fib_expiry_heap_size++;
+            fib_expiry_heap[fib_expiry_heap_size - 1] = pos;
+            fib_expiry_heap_fix(fib_expiry_heap_size - 1);
+        }
+        else {
+            fib_expiry_heap_fix(fib_expiry_heap_pos[pos]);
+        }
+    }
+    else {
+        fib_table[pos].lifetime.seconds = FIB_LIFETIME_NO_EXPIRE;
+        fib_table[pos].lifetime.microseconds = FIB_LIFETIME_NO_EXPIRE;
+        fib_expiry_heap_remove(pos);
+    }
+}
+
+/**
+ * @brief callback of fib_expiry_timer, runs in interrupt context
+ */
+static void fib_expiry_timer_cb(vtimer_t *timer)
+{
+    (void)timer;
+    fib_expiry_pending = true;
+}
+
+/**
+ * @brief (re)sets fib_expiry_timer to the lifetime of the entry at the top of fib_expiry_heap
+ */
+static void fib_expiry_timer_update(void)
+{
+    timex_t now;
+
+    if (fib_expiry_heap_size == 0) {
+        if ((fib_expiry_timer_target.seconds != 0)
+            || (fib_expiry_timer_target.microseconds != 0)) {
+            vtimer_remove(&fib_expiry_timer);
+            fib_expiry_timer_target = timex_set(0, 0);
+        }
+
+        return;
+    }
+
+    timex_t target = fib_table[fib_expiry_heap[0]].lifetime;
+
+    if (timex_cmp(target, fib_expiry_timer_target) == 0) {
+        /* the timer is already set for the next expiring entry */
+        return;
+    }
+
+    vtimer_remove(&fib_expiry_timer);
+    fib_expiry_timer_target = target;
+    vtimer_now(&now);
+
+    if (timex_cmp(now, target) > -1) {
+        fib_expiry_pending = true;
+    }
+    else {
+        vtimer_set_cb(&fib_expiry_timer, timex_sub(target, now), fib_expiry_timer_cb, NULL);
+    }
+}
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_entry_t *entry)
+{
+    if (entry->global != NULL) {
+        fib_index_remove(entry - fib_table);
+        universal_address_rem(entry->global);
+    }
+
+    fib_expiry_heap_remove(entry - fib_table);
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime.seconds = 0;
+    entry->lifetime.microseconds = 0;
+
+    return 0;
+}
+
+/**
+ * @brief removes all entries with an expired lifetime if fib_expiry_timer fired
+ *        and sets fib_expiry_timer to the next expiring entry
+ */
+static void fib_expire(void)
+{
+    timex_t now;
+
+    if (!fib_expiry_pending) {
+        return;
+    }
+
+    fib_expiry_pending = false;
+    /* the timer fired, so it has to be set again in any case */
+    fib_expiry_timer_target = timex_set(0, 0);
+    vtimer_now(&now);
+
+    while ((fib_expiry_heap_size > 0)
+           && (timex_cmp(now, fib_table[fib_expiry_heap[0]].lifetime) > -1)) {
+        DEBUG("[fib_expire] entry %d expired\n", (int)fib_expiry_heap[0]);
+        fib_remove(&fib_table[fib_expiry_heap[0]]);
+    }
+
+    fib_expiry_timer_update();
 }
 
 /**
  * @brief returns pointer to the entry for the given destination address
  *
+ *        Instead of comparing the destination to every entry of fib_table,
+ *        the destination is masked to every prefix length in use (longest first)
+ *        and the result is looked up in fib_index.
+ *        Expired entries are removed beforehand by fib_expire().
+ *
  * @param[in] dst                  the destination address
  * @param[in] dst_size             the destination address size
  * @param[out] entry_arr           the array to scribe the found match
@@ -94,76 +501,39 @@ static void fib_ms_to_timex(uint32_t ms, timex_t *timex)
 static int fib_find_entry(uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size)
 {
-    timex_t now;
-    vtimer_now(&now);
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE];
 
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size<<3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    fib_expire();
+    *entry_arr_size = 0;
 
-    for(size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
+    if (dst_size > UNIVERSAL_ADDRESS_SIZE) {
+        return -EHOSTUNREACH;
     }
 
-    for (size_t i = 0; i < FIB_MAX_FIB_TABLE_ENTRIES; ++i) {
+    memcpy(key, dst, dst_size);
+    size_t dst_prefix_len = fib_prefix_len(dst, dst_size);
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if ((fib_table[i].lifetime.seconds != FIB_LIFETIME_NO_EXPIRE)
-            || (fib_table[i].lifetime.microseconds != FIB_LIFETIME_NO_EXPIRE)) {
-
-            /* check if the lifetime expired */
-            if (timex_cmp(now, fib_table[i].lifetime) > -1) {
-                /* remove this entry if its lifetime expired */
-                fib_table[i].lifetime.seconds = 0;
-                fib_table[i].lifetime.microseconds = 0;
-                fib_table[i].global_flags = 0;
-                fib_table[i].next_hop_flags = 0;
-                fib_table[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (fib_table[i].global != NULL) {
-                    universal_address_rem(fib_table[i].global);
-                    fib_table[i].global = NULL;
-                }
-
-                if (fib_table[i].next_hop != NULL) {
-                    universal_address_rem(fib_table[i].next_hop);
-                    fib_table[i].next_hop = NULL;
-                }
-            }
+    /* entries with a longer prefix than the destination cannot match,
+     * since their last set bit is 0 in the destination */
+    for (size_t len = dst_prefix_len + 1; len-- > 0;) {
+        if (fib_prefix_len_count[len] == 0) {
+            continue;
         }
 
-        if ((prefix_size < (dst_size<<3)) && (fib_table[i].global != NULL)) {
+        fib_mask_prefix(key, dst_size, len);
+        int pos = fib_index_find(key, dst_size);
 
-            int ret_comp = universal_address_compare(fib_table[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if (ret_comp == 0 || (is_all_zeros_addr && match_size == 0)) {
-                entry_arr[0] = &(fib_table[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
-            }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == 1) {
-                    entry_arr[0] = &(fib_table[i]);
-                    /* we could find a better one so we move on */
-                    ret = 0;
-
-                    prefix_size = match_size;
-                    match_size = dst_size<<3;
-                    count = 1;
-                }
-            }
+        if (pos < 0) {
+            continue;
         }
+
+        entry_arr[0] = &(fib_table[pos]);
+        *entry_arr_size = 1;
+        /* the longest prefix is the most fitting one, so we return */
+        return (len == dst_prefix_len) ? 1 : 0;
     }
 
-    *entry_arr_size = count;
-    return ret;
+    return -EHOSTUNREACH;
 }
 
 /**
@@ -191,14 +561,7 @@ static int fib_upd_entry(fib_entry_t *entry,
     universal_address_rem(entry->next_hop);
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
-
-    if (lifetime < FIB_LIFETIME_NO_EXPIRE) {
-        fib_ms_to_timex(lifetime, &entry->lifetime);
-    }
-    else {
-        entry->lifetime.seconds = FIB_LIFETIME_NO_EXPIRE;
-        entry->lifetime.microseconds = FIB_LIFETIME_NO_EXPIRE;
-    }
+    fib_set_lifetime(entry - fib_table, lifetime);
 
     return 0;
 }
@@ -223,66 +586,40 @@ static int fib_create_entry(kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t next_hop_flags,
                             uint32_t lifetime)
 {
+    if (dst_size > UNIVERSAL_ADDRESS_SIZE) {
+        return -ENOMEM;
+    }
+
     for (size_t i = 0; i < FIB_MAX_FIB_TABLE_ENTRIES; ++i) {
         if (fib_table[i].lifetime.seconds == 0 && fib_table[i].lifetime.microseconds == 0) {
 
             fib_table[i].global = universal_address_add(dst, dst_size);
 
-            if (fib_table[i].global != NULL) {
-                fib_table[i].global_flags = dst_flags;
-                fib_table[i].next_hop = universal_address_add(next_hop, next_hop_size);
-                fib_table[i].next_hop_flags = next_hop_flags;
+            if (fib_table[i].global == NULL) {
+                return -ENOMEM;
             }
 
-            if (fib_table[i].next_hop != NULL) {
-                /* everything worked fine */
-                fib_table[i].iface_id = iface_id;
-
-                if (lifetime < FIB_LIFETIME_NO_EXPIRE) {
-                    fib_ms_to_timex(lifetime, &fib_table[i].lifetime);
-                }
-                else {
-                    fib_table[i].lifetime.seconds = FIB_LIFETIME_NO_EXPIRE;
-                    fib_table[i].lifetime.microseconds = FIB_LIFETIME_NO_EXPIRE;
-                }
+            fib_table[i].next_hop = universal_address_add(next_hop, next_hop_size);
 
-                return 0;
+            if (fib_table[i].next_hop == NULL) {
+                universal_address_rem(fib_table[i].global);
+                fib_table[i].global = NULL;
+                return -ENOMEM;
             }
+
+            /* everything worked fine */
+            fib_table[i].global_flags = dst_flags;
+            fib_table[i].next_hop_flags = next_hop_flags;
+            fib_table[i].iface_id = iface_id;
+            fib_set_lifetime(i, lifetime);
+            fib_index_add(i);
+            return 0;
         }
     }
 
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime.seconds = 0;
-    entry->lifetime.microseconds = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -355,6 +692,7 @@ int fib_add_entry(kernel_pid_t iface_id, uint8_t *dst, size_t dst_size, uint32_t
                                next_hop, next_hop_size, next_hop_flags, lifetime);
     }
 
+    fib_expiry_timer_update();
     mutex_unlock(&mtx_access);
     return ret;
 }
@@ -379,6 +717,7 @@ int fib_update_entry(uint8_t *dst, size_t dst_size,
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        fib_expiry_timer_update();
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -403,6 +742,7 @@ void fib_remove_entry(uint8_t *dst, size_t dst_size)
     if (ret == 1) {
         /* we must take the according entry and update the values */
         fib_remove(entry[0]);
+        fib_expiry_timer_update();
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -473,6 +813,8 @@ int fib_get_destination_set(uint8_t *prefix, size_t prefix_size,
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
+    fib_expire();
+
     for (size_t i = 0; i < FIB_MAX_FIB_TABLE_ENTRIES; ++i) {
         if ((fib_table[i].global != NULL) &&
             (universal_address_compare_prefix(fib_table[i].global, prefix, prefix_size<<3) >= 0)) {
@@ -520,6 +862,13 @@ void fib_init(void)
         fib_table[i].next_hop = NULL;
     }
 
+    memset(fib_index, 0, sizeof(fib_index));
+    memset(fib_prefix_len_count, 0, sizeof(fib_prefix_len_count));
+    memset(fib_expiry_heap_pos, 0xFF, sizeof(fib_expiry_heap_pos));
+    fib_expiry_heap_size = 0;
+    fib_expiry_pending = false;
+    fib_expiry_timer_update();
+
     universal_address_init();
     mutex_unlock(&mtx_access);
 }
@@ -546,6 +895,13 @@ void fib_deinit(void)
         fib_table[i].next_hop = NULL;
     }
 
+    memset(fib_index, 0, sizeof(fib_index));
+    memset(fib_prefix_len_count, 0, sizeof(fib_prefix_len_count));
+    memset(fib_expiry_heap_pos, 0xFF, sizeof(fib_expiry_heap_pos));
+    fib_expiry_heap_size = 0;
+    fib_expiry_pending = false;
+    fib_expiry_timer_update();
+
     universal_address_reset();
     mutex_unlock(&mtx_access);
 }
@@ -580,6 +936,8 @@ int fib_get_num_used_entries(void)
     mutex_lock(&mtx_access);
     size_t used_entries = 0;
 
+    fib_expire();
+
     for (size_t i = 0; i < FIB_MAX_FIB_TABLE_ENTRIES; ++i) {
         used_entries += (size_t)(fib_table[i].global != NULL);
     }
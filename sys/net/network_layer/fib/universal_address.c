@@ -28,7 +28,9 @@
 /**
  * @brief Maximum number of entries handled
  */
+#ifndef UNIVERSAL_ADDRESS_MAX_ENTRIES
 #define UNIVERSAL_ADDRESS_MAX_ENTRIES (40)
+#endif
 
 /**
  * @brief counter indicating the number of entries allocated
@@ -35,28 +35,193 @@
 static char addr_str[NG_IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+/* twice the cache size, so probe sequences stay short and always end */
+#define _HASH_SIZE      (2 * NG_IPV6_NC_SIZE)
+
 static ng_ipv6_nc_t ncache[NG_IPV6_NC_SIZE];
 
+/* Index into ncache by IPv6 address as open addressing hash table (linear
+ * probing, backward-shift deletion). A slot holds the position of the entry
+ * in ncache + 1, 0 if the slot is empty. The interface is not hashed, so
+ * lookups for all interfaces (KERNEL_PID_UNDEF) follow the same sequence. */
+static uint16_t nc_hash[_HASH_SIZE];
+
+/* time of last use of the entries for LRU replacement */
+static uint32_t nc_last_used[NG_IPV6_NC_SIZE];
+static uint32_t nc_clock;
+
+static inline unsigned _hash(const ng_ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    /* Knuth's multiplicative hash, take the well mixed upper bits */
+    return ((h * 2654435761U) >> 16) % _HASH_SIZE;
+}
+
+static inline unsigned _next(unsigned idx)
+{
+    return (idx + 1) % _HASH_SIZE;
+}
+
+static inline ng_ipv6_nc_t *_slot_entry(unsigned idx)
+{
+    return &ncache[nc_hash[idx] - 1];
+}
+
+/* returns slot of entry for ipv6_addr on iface, -1 if there is none */
+static int _find(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr)
+{
+    unsigned idx = _hash(ipv6_addr);
+
+    for (unsigned i = 0; (i < _HASH_SIZE) && (nc_hash[idx] != 0); i++) {
+        ng_ipv6_nc_t *entry = _slot_entry(idx);
+
+        if (((iface == KERNEL_PID_UNDEF) || (iface == entry->iface)) &&
+            ng_ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
+            return idx;
+        }
+
+        idx = _next(idx);
+    }
+
+    return -1;
+}
+
+static void _hash_insert(ng_ipv6_nc_t *entry)
+{
+    unsigned idx = _hash(&entry->ipv6_addr);
+
+    while (nc_hash[idx] != 0) {
+        idx = _next(idx);
+    }
+
+    nc_hash[idx] = (entry - ncache) + 1;
+}
+
+/* empties slot of entry and moves subsequent slots of the probe sequence back */
+static void _hash_remove(ng_ipv6_nc_t *entry)
+{
+    unsigned hole = _hash(&entry->ipv6_addr);
+
+    while (nc_hash[hole] != (uint16_t)((entry - ncache) + 1)) {
+        hole = _next(hole);
+    }
+
+    nc_hash[hole] = 0;
+
+    for (unsigned idx = _next(hole); nc_hash[idx] != 0; idx = _next(idx)) {
+        unsigned home = _hash(&_slot_entry(idx)->ipv6_addr);
+
+        /* move slot unless its home lies cyclically in (hole, idx] */
+        if ((hole < idx) ? ((home <= hole) || (home > idx))
+                         : ((home <= hole) && (home > idx))) {
+            nc_hash[hole] = nc_hash[idx];
+            nc_hash[idx] = 0;
+            hole = idx;
+        }
+    }
+}
+
+static inline void _touch(ng_ipv6_nc_t *entry)
+{
+    nc_last_used[entry - ncache] = ++nc_clock;
+}
+
+static void _clear_entry(ng_ipv6_nc_t *entry)
+{
+    _hash_remove(entry);
+
+    while (entry->pkts != NULL) {
+#ifdef MODULE_NG_PKTBUF
+        ng_pktbuf_release(entry->pkts->pkt);
+#endif
+        entry->pkts->pkt = NULL;
+        ng_pktqueue_remove_head(&entry->pkts);
+    }
+
+#ifdef MODULE_VTIMER
+    /* timers would fire for a recycled entry otherwise */
+    vtimer_remove(&entry->rtr_timeout);
+    vtimer_remove(&entry->nbr_sol_timer);
+    vtimer_remove(&entry->nbr_adv_timer);
+#endif
+
+    ng_ipv6_addr_set_unspecified(&(entry->ipv6_addr));
+    entry->iface = KERNEL_PID_UNDEF;
+    entry->flags = 0;
+}
+
 void ng_ipv6_nc_init(void)
 {
     memset(ncache, 0, sizeof(ncache));
+    memset(nc_hash, 0, sizeof(nc_hash));
+    memset(nc_last_used, 0, sizeof(nc_last_used));
+    nc_clock = 0;
 }
 
-ng_ipv6_nc_t *_find_free_entry(void)
+/* ranks an entry for replacement, lower ranks are replaced first:
+ * stale and unreachable neighbors can be resolved again cheaply, while an
+ * incomplete entry would drop the packets waiting for the resolution */
+static inline unsigned _replace_rank(ng_ipv6_nc_t *entry)
 {
+    switch (ng_ipv6_nc_get_state(entry)) {
+        case NG_IPV6_NC_STATE_STALE:
+        case NG_IPV6_NC_STATE_UNREACHABLE:
+            return 0;
+        case NG_IPV6_NC_STATE_INCOMPLETE:
+            return (entry->pkts != NULL) ? 2 : 1;
+        default:
+            return 1;
+    }
+}
+
+/* returns a free entry or, if the cache is full, recycles the least recently
+ * used one of the lowest replacement rank. Registered entries (RFC 6775) and
+ * routers are never recycled. */
+static ng_ipv6_nc_t *_alloc_entry(void)
+{
+    ng_ipv6_nc_t *lru = NULL;
+    uint32_t lru_age = 0;
+    unsigned lru_rank = 0;
+
     for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        uint32_t age = nc_clock - nc_last_used[i];
+        unsigned rank;
+
         if (ng_ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
             return ncache + i;
         }
+
+        if ((ng_ipv6_nc_get_type(&ncache[i]) == NG_IPV6_NC_TYPE_REGISTERED) ||
+            (ncache[i].flags & NG_IPV6_NC_IS_ROUTER)) {
+            continue;
+        }
+
+        rank = _replace_rank(&ncache[i]);
+
+        if ((lru == NULL) || (rank < lru_rank) ||
+            ((rank == lru_rank) && (age > lru_age))) {
+            lru = ncache + i;
+            lru_age = age;
+            lru_rank = rank;
+        }
     }
 
-    return NULL;
+    if (lru != NULL) {
+        DEBUG("ipv6_nc: neighbor cache full, replace %s\n",
+              ng_ipv6_addr_to_str(addr_str, &lru->ipv6_addr, sizeof(addr_str)));
+        _clear_entry(lru);
+    }
+
+    return lru;
 }
 
 ng_ipv6_nc_t *ng_ipv6_nc_add(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr,
                              const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
-    ng_ipv6_nc_t *free_entry = NULL;
+    ng_ipv6_nc_t *free_entry;
+    int idx;
 
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
@@ -68,33 +233,33 @@ ng_ipv6_nc_t *ng_ipv6_nc_add(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr
         return NULL;
     }
 
-    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
-        if (ng_ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ng_ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
-
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      ng_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                           l2_addr, l2_addr_len));
-
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
-
-            }
-            return &ncache[i];
-        }
+    if ((idx = _find(KERNEL_PID_UNDEF, ipv6_addr)) >= 0) {
+        ng_ipv6_nc_t *entry = _slot_entry(idx);
+
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ng_ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  ng_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                       l2_addr, l2_addr_len));
+
+            memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+            entry->l2_addr_len = l2_addr_len;
+            entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
 
-        if (ng_ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
-            /* found the first free entry */
-            free_entry = &ncache[i];
         }
+
+        _touch(entry);
+
+        return entry;
     }
 
+    free_entry = _alloc_entry();
+
     if (!free_entry) {
-        /* reached end of NC without finding updateable or free entry */
+        /* all entries are registered and may not be replaced */
         DEBUG("ipv6_nc: neighbor cache full.\n");
         return NULL;
     }
@@ -125,49 +290,44 @@ ng_ipv6_nc_t *ng_ipv6_nc_add(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr
         free_entry->probes_remaining = NG_NDP_MAX_MC_NBR_SOL_NUMOF;
     }
 
+    _hash_insert(free_entry);
+    _touch(free_entry);
+
     return free_entry;
 }
 
 void ng_ipv6_nc_remove(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr)
 {
-    ng_ipv6_nc_t *entry = ng_ipv6_nc_get(iface, ipv6_addr);
+    int idx;
 
-    if (entry != NULL) {
+    if ((ipv6_addr != NULL) && ((idx = _find(iface, ipv6_addr)) >= 0)) {
         DEBUG("ipv6_nc: Remove %s for interface %" PRIkernel_pid "\n",
               ng_ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
               iface);
 
-        while (entry->pkts != NULL) {
-#ifdef MODULE_NG_PKTBUF
-            ng_pktbuf_release(entry->pkts->pkt);
-#endif
-            entry->pkts->pkt = NULL;
-            ng_pktqueue_remove_head(&entry->pkts);
-        }
-
-        ng_ipv6_addr_set_unspecified(&(entry->ipv6_addr));
-        entry->iface = KERNEL_PID_UNDEF;
-        entry->flags = 0;
+        _clear_entry(_slot_entry(idx));
     }
 }
 
 ng_ipv6_nc_t *ng_ipv6_nc_get(kernel_pid_t iface, const ng_ipv6_addr_t *ipv6_addr)
 {
+    int idx;
+
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
         return NULL;
     }
 
-    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
-        if (((iface == KERNEL_PID_UNDEF) || (iface == ncache[i].iface)) &&
-            ng_ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
-                  " (0 = all interfaces) [%p]\n",
-                  ng_ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
+    if ((idx = _find(iface, ipv6_addr)) >= 0) {
+        ng_ipv6_nc_t *entry = _slot_entry(idx);
 
-            return ncache + i;
-        }
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ng_ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
+        _touch(entry);
+
+        return entry;
     }
 
     return NULL;
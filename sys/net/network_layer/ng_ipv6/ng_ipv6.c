@@ -125,7 +125,7 @@ void ng_ipv6_demux(kernel_pid_t iface, ng_pktsnip_t *pkt, uint8_t nh)
 /* internal functions */
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[NG_IPV6_MSG_QUEUE_SIZE];
+    msg_t msgs[NG_IPV6_MSG_QUEUE_SIZE], reply, msg_q[NG_IPV6_MSG_QUEUE_SIZE];
     ng_netreg_entry_t me_reg;
 
     (void)args;
@@ -135,57 +135,67 @@ static void *_event_loop(void *args)
     me_reg.pid = thread_getpid();
 
     /* register interest in all IPv6 packets */
-    ng_netreg_register(NG_NETTYPE_IPV6, &me_reg);
+    if (ng_netreg_register(NG_NETTYPE_IPV6, &me_reg) < 0) {
+        DEBUG("ipv6: unable to register at netreg\n");
+        return NULL;
+    }
 
     /* preinitialize ACK */
     reply.type = NG_NETAPI_MSG_TYPE_ACK;
 
     /* start event loop */
     while (1) {
-        DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
-
-        switch (msg.type) {
-            case NG_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: NG_NETAPI_MSG_TYPE_RCV received\n");
-                _receive((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: NG_NETAPI_MSG_TYPE_SND received\n");
-                _send((ng_pktsnip_t *)msg.content.ptr, true);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_GET:
-            case NG_NETAPI_MSG_TYPE_SET:
-                DEBUG("ipv6: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            case NG_NDP_MSG_RTR_TIMEOUT:
-                DEBUG("ipv6: Router timeout received\n");
-                ((ng_ipv6_nc_t *)msg.content.ptr)->flags &= ~NG_IPV6_NC_IS_ROUTER;
-                break;
-
-            case NG_NDP_MSG_ADDR_TIMEOUT:
-                DEBUG("ipv6: Router advertisement timer event received\n");
-                ng_ipv6_netif_remove_addr(KERNEL_PID_UNDEF,
-                                          (ng_ipv6_addr_t *)msg.content.ptr);
-                break;
-
-            case NG_NDP_MSG_NBR_SOL_RETRANS:
-                DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
-                ng_ndp_retrans_nbr_sol((ng_ipv6_nc_t *)msg.content.ptr);
-                break;
-
-            case NG_NDP_MSG_NC_STATE_TIMEOUT:
-                DEBUG("ipv6: Neigbor cace state timeout received\n");
-                ng_ndp_state_timeout((ng_ipv6_nc_t *)msg.content.ptr);
-                break;
-
-            default:
-                break;
+        int num;
+
+        DEBUG("ipv6: waiting for incoming messages.\n");
+        /* drain bursts of packets with a single critical section */
+        num = msg_receive_bulk(msgs, NG_IPV6_MSG_QUEUE_SIZE);
+
+        for (int i = 0; i < num; i++) {
+            msg_t *msg = &msgs[i];
+
+            switch (msg->type) {
+                case NG_NETAPI_MSG_TYPE_RCV:
+                    DEBUG("ipv6: NG_NETAPI_MSG_TYPE_RCV received\n");
+                    _receive((ng_pktsnip_t *)msg->content.ptr);
+                    break;
+
+                case NG_NETAPI_MSG_TYPE_SND:
+                    DEBUG("ipv6: NG_NETAPI_MSG_TYPE_SND received\n");
+                    _send((ng_pktsnip_t *)msg->content.ptr, true);
+                    break;
+
+                case NG_NETAPI_MSG_TYPE_GET:
+                case NG_NETAPI_MSG_TYPE_SET:
+                    DEBUG("ipv6: reply to unsupported get/set\n");
+                    reply.content.value = -ENOTSUP;
+                    msg_reply(msg, &reply);
+                    break;
+
+                case NG_NDP_MSG_RTR_TIMEOUT:
+                    DEBUG("ipv6: Router timeout received\n");
+                    ((ng_ipv6_nc_t *)msg->content.ptr)->flags &= ~NG_IPV6_NC_IS_ROUTER;
+                    break;
+
+                case NG_NDP_MSG_ADDR_TIMEOUT:
+                    DEBUG("ipv6: Router advertisement timer event received\n");
+                    ng_ipv6_netif_remove_addr(KERNEL_PID_UNDEF,
+                                              (ng_ipv6_addr_t *)msg->content.ptr);
+                    break;
+
+                case NG_NDP_MSG_NBR_SOL_RETRANS:
+                    DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
+                    ng_ndp_retrans_nbr_sol((ng_ipv6_nc_t *)msg->content.ptr);
+                    break;
+
+                case NG_NDP_MSG_NC_STATE_TIMEOUT:
+                    DEBUG("ipv6: Neigbor cace state timeout received\n");
+                    ng_ndp_state_timeout((ng_ipv6_nc_t *)msg->content.ptr);
+                    break;
+
+                default:
+                    break;
+            }
         }
     }
 
@@ -618,7 +628,7 @@ static void _receive(ng_pktsnip_t *pkt)
         }
 
         /* seize ipv6 as a temporary variable */
-        ipv6 = ng_pktbuf_start_write(pkt);
+        ipv6 = ng_pktbuf_start_mark(pkt);
 
         if (ipv6 == NULL) {
             DEBUG("ipv6: unable to get write access to packet, drop it\n");
@@ -655,7 +665,7 @@ static void _receive(ng_pktsnip_t *pkt)
         DEBUG("ipv6: decrement hop limit to %" PRIu8 "\n", hdr->hl - 1);
 
         /* TODO: check if receiving interface is router */
-        if (--(hdr->hl) > 0) {  /* drop packets that *reach* Hop Limit 0 */
+        if (hdr->hl > 1) {  /* drop packets that *reach* Hop Limit 0 */
             ng_pktsnip_t *tmp = pkt;
 
             DEBUG("ipv6: forward packet to next hop\n");
@@ -670,6 +680,9 @@ static void _receive(ng_pktsnip_t *pkt)
                 return;
             }
 
+            hdr = ipv6->data;
+            hdr->hl--;
+
             ng_pktbuf_release(ipv6->next);  /* remove headers around IPV6 */
             ipv6->next = pkt;           /* reorder for sending */
             pkt->next = NULL;
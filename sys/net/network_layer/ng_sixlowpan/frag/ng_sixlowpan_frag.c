@@ -268,4 +268,14 @@ void ng_sixlowpan_frag_handle_pkt(ng_pktsnip_t *pkt)
     ng_pktbuf_release(pkt);
 }
 
+void ng_sixlowpan_frag_gc_rbuf(void)
+{
+    rbuf_gc();
+}
+
+void ng_sixlowpan_frag_get_stats(ng_sixlowpan_frag_stats_t *stats)
+{
+    *stats = rbuf_stats;
+}
+
 /** @} */
@@ -31,14 +31,20 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-#ifndef RBUF_INT_SIZE
-#define RBUF_INT_SIZE   (NG_IPV6_NETIF_DEFAULT_MTU * RBUF_SIZE / 127)
-#endif
-
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* slack of the garbage collection timer in microseconds */
+#define RBUF_GC_SLACK   (500000U)
 
 static rbuf_t rbuf[RBUF_SIZE];
 
+/* entries by hash of (src, dst, tag) */
+static rbuf_t *rbuf_hash[RBUF_HASH_SIZE];
+
+static vtimer_t rbuf_gc_timer;
+/* time in seconds the garbage collection is due, 0 if not scheduled */
+static uint32_t rbuf_gc_due;
+
+ng_sixlowpan_frag_stats_t rbuf_stats;
+
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 #endif
@@ -46,16 +52,19 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end are in given interval i */
-static inline bool _rbuf_int_in(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* gets the hash bucket for the given tupel */
+static rbuf_t **_rbuf_bucket(const uint8_t *src, size_t src_len,
+                             const uint8_t *dst, size_t dst_len, uint16_t tag);
+/* marks units of a fragment as received, returns false if any was before */
+static bool _rbuf_update_units(rbuf_t *entry, uint16_t offset, size_t frag_size);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
-static void _rbuf_gc(void);
+/* release the entry's packet and remove it from reassembly buffer */
+static void _rbuf_drop(rbuf_t *entry, uint32_t *counter);
+/* schedules garbage collection for an entry that arrived at arrival */
+static void _rbuf_gc_schedule(uint32_t arrival);
+/* gets a free entry, removes a timed out or the oldest entry if there is none */
+static rbuf_t *_rbuf_alloc(uint32_t now);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
@@ -65,11 +74,18 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
               size_t frag_size, size_t offset)
 {
     rbuf_t *entry;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)frag) + sizeof(ng_sixlowpan_frag_t);
     uint16_t dg_frag_size = frag_size; /* may differ on first fragment */
+    uint16_t dg_offset = offset;
+
+    /* a fragment without any bytes of the datagram has no units to mark as
+     * received, do not even allocate an entry for it */
+    if ((frag_size == 0) || ((offset == 0) && (frag_size == 1) &&
+                             (data[0] == NG_SIXLOWPAN_UNCOMPRESSED))) {
+        DEBUG("6lo rfrag: fragment without payload, discarding\n");
+        return;
+    }
 
-    _rbuf_gc();
     entry = _rbuf_get(ng_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       ng_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & NG_SIXLOWPAN_FRAG_SIZE_MASK,
@@ -80,8 +96,6 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset != 0) {
         switch (((uint8_t *)(entry->pkt->data))[0]) {
@@ -109,48 +123,42 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
 
     }
 
-    if ((offset + frag_size) > entry->pkt->size) {
+    if (((offset + frag_size) > entry->pkt->size) ||
+        ((dg_offset + dg_frag_size) > entry->datagram_size)) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
-        ng_pktbuf_release(entry->pkt);
-        _rbuf_rem(entry);
+        _rbuf_drop(entry, &rbuf_stats.invalid);
         return;
     }
 
-    while (ptr != NULL) {
-        if (_rbuf_int_in(ptr, offset, offset + dg_frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping or same intervals, discarding datagram\n");
-            ng_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-            return;
-        }
-
-        ptr = ptr->next;
+    if (!_rbuf_update_units(entry, dg_offset, dg_frag_size)) {
+        DEBUG("6lo rfrag: overlapping or same intervals, discarding datagram\n");
+        _rbuf_drop(entry, &rbuf_stats.overlap);
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, dg_frag_size)) {
-        if (dg_frag_size < frag_size) {
-            /* some dispatches do not count to datagram size and we need
-             * more space because of that */
-            if (ng_pktbuf_realloc_data(entry->pkt, entry->pkt->size +
-                                       (frag_size - dg_frag_size)) < 0) {
-                DEBUG("6lo rbuf: could not reallocate packet data.\n");
-                return;
-            }
+    if (dg_frag_size < frag_size) {
+        /* some dispatches do not count to datagram size and we need
+         * more space because of that */
+        if (ng_pktbuf_realloc_data(entry->pkt, entry->pkt->size +
+                                   (frag_size - dg_frag_size)) < 0) {
+            DEBUG("6lo rbuf: could not reallocate packet data.\n");
+            _rbuf_drop(entry, &rbuf_stats.nomem);
+            return;
+        }
 
-            /* move already inserted fragments (frag_size - dg_frag_size) to the right */
-            if (entry->cur_size > 0) {
-                for (int i = entry->pkt->size - (frag_size - dg_frag_size); i > 0; i--) {
-                    uint8_t *d = ((uint8_t *)(entry->pkt->data)) + i;
-                    *d = *(d - 1);
-                }
+        /* move already inserted fragments (frag_size - dg_frag_size) to the right */
+        if (entry->cur_size > 0) {
+            for (int i = entry->pkt->size - (frag_size - dg_frag_size); i > 0; i--) {
+                uint8_t *d = ((uint8_t *)(entry->pkt->data)) + i;
+                *d = *(d - 1);
             }
         }
-
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->cur_size += (uint16_t)dg_frag_size;
-        memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
     }
 
+    DEBUG("6lo rbuf: add fragment data\n");
+    entry->cur_size += (uint16_t)dg_frag_size;
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
+
     if (entry->cur_size == entry->datagram_size) {
         kernel_pid_t iface = netif_hdr->if_pid;
         ng_pktsnip_t *netif = ng_netif_hdr_build(entry->src, entry->src_len,
@@ -158,7 +166,7 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
 
         if (netif == NULL) {
             DEBUG("6lo rbuf: error allocating netif header\n");
-            ng_pktbuf_release(entry->pkt);
+            _rbuf_drop(entry, &rbuf_stats.nomem);
             return;
         }
 
@@ -168,164 +176,207 @@ void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
 
         DEBUG("6lo rbuf: datagram complete, send to self\n");
         ng_netapi_receive(thread_getpid(), entry->pkt);
+        rbuf_stats.complete++;
         _rbuf_rem(entry);
     }
 }
 
-static inline bool _rbuf_int_in(rbuf_int_t *i, uint16_t start, uint16_t end)
+void rbuf_gc(void)
 {
-    return (((i->start < start) && (start <= i->end)) ||
-            ((start < i->start) && (i->start <= end)) ||
-            ((i->start == start) && (i->end == end)));
-}
+    timex_t now;
+    uint32_t oldest = 0;
+    bool pending = false;
 
-static rbuf_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    vtimer_now(&now);
+    rbuf_gc_due = 0;
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if (rbuf[i].pkt == NULL) {
+            continue;
+        }
+
+        if ((now.seconds - rbuf[i].arrival) > RBUF_TIMEOUT) {
+            DEBUG("6lo rfrag: entry (%s, ", ng_netif_addr_to_str(l2addr_str,
+                  sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
+            DEBUG("%s, %u, %" PRIu16 ") timed out\n",
+                  ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
+                                       rbuf[i].dst_len),
+                  rbuf[i].datagram_size, rbuf[i].tag);
+
+            _rbuf_drop(&(rbuf[i]), &rbuf_stats.timeout);
+        }
+        else if (!pending || (rbuf[i].arrival < oldest)) {
+            oldest = rbuf[i].arrival;
+            pending = true;
         }
     }
 
-    return NULL;
+    if (pending) {
+        _rbuf_gc_schedule(oldest);
+    }
 }
 
-static void _rbuf_rem(rbuf_t *entry)
+static rbuf_t **_rbuf_bucket(const uint8_t *src, size_t src_len,
+                             const uint8_t *dst, size_t dst_len, uint16_t tag)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    uint32_t hash = tag;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    for (size_t i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
     }
 
-    entry->pkt = NULL;
+    for (size_t i = 0; i < dst_len; i++) {
+        hash = (hash * 31) + dst[i];
+    }
+
+    return &rbuf_hash[hash % RBUF_HASH_SIZE];
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static bool _rbuf_update_units(rbuf_t *entry, uint16_t offset, size_t frag_size)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    unsigned int first = offset / RBUF_UNIT;
+    unsigned int last = (offset + frag_size - 1) / RBUF_UNIT;
 
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    for (unsigned int i = first; i <= last; i++) {
+        if (entry->received[i / 8] & (1 << (i % 8))) {
+            return false;
+        }
     }
 
-    new->start = offset;
-    new->end = end;
+    for (unsigned int i = first; i <= last; i++) {
+        entry->received[i / 8] |= (1 << (i % 8));
+    }
 
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, ng_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), entry->src, entry->src_len));
+    DEBUG("6lo rfrag: add units (%u, %u) to entry (%s, ", first, last,
+          ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->src,
+                               entry->src_len));
     DEBUG("%s, %u, %" PRIu16 ")\n", ng_netif_addr_to_str(l2addr_str,
           sizeof(l2addr_str), entry->dst, entry->dst_len), entry->datagram_size,
           entry->tag);
 
-    LL_PREPEND(entry->ints, new);
-
     return true;
 }
 
-static void _rbuf_gc(void)
+static void _rbuf_rem(rbuf_t *entry)
+{
+    rbuf_t **bucket = _rbuf_bucket(entry->src, entry->src_len, entry->dst,
+                                   entry->dst_len, entry->tag);
+
+    LL_DELETE(*bucket, entry);
+    entry->pkt = NULL;
+}
+
+static void _rbuf_drop(rbuf_t *entry, uint32_t *counter)
+{
+    ng_pktbuf_release(entry->pkt);
+    _rbuf_rem(entry);
+    (*counter)++;
+}
+
+static void _rbuf_gc_schedule(uint32_t arrival)
 {
-    rbuf_t *oldest = NULL;
     timex_t now;
-    unsigned int i;
+    uint32_t due = arrival + RBUF_TIMEOUT + 1;
 
     vtimer_now(&now);
 
-    for (i = 0; i < RBUF_SIZE; i++) {
-        if (rbuf[i].pkt == NULL) { /* leave GC early if there is still room */
-            return;
+    if (due <= now.seconds) {
+        due = now.seconds + 1;
+    }
+
+    /* reschedule if the timer is not set yet or its message was lost */
+    if ((rbuf_gc_due == 0) || ((int32_t)(now.seconds - rbuf_gc_due) > (int32_t)RBUF_TIMEOUT)) {
+        rbuf_gc_due = due;
+        vtimer_set_msg_with_slack(&rbuf_gc_timer, timex_set(due - now.seconds, 0),
+                                  timex_set(0, RBUF_GC_SLACK), thread_getpid(),
+                                  NG_SIXLOWPAN_MSG_FRAG_GC_RBUF, NULL);
+    }
+}
+
+static rbuf_t *_rbuf_alloc(uint32_t now)
+{
+    rbuf_t *oldest = NULL;
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if (rbuf[i].pkt == NULL) {
+            return &(rbuf[i]);
         }
-        else if ((rbuf[i].pkt != NULL) &&
-                 ((now.seconds - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", ng_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %" PRIu16 ") timed out\n",
-                  ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                       rbuf[i].dst_len),
-                  rbuf[i].datagram_size, rbuf[i].tag);
 
-            ng_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
+        /* the garbage collection may be late */
+        if ((now - rbuf[i].arrival) > RBUF_TIMEOUT) {
+            _rbuf_drop(&(rbuf[i]), &rbuf_stats.timeout);
+            return &(rbuf[i]);
         }
-        else if ((oldest == NULL) || (rbuf[i].arrival < oldest->arrival)) {
+
+        if ((oldest == NULL) || (rbuf[i].arrival < oldest->arrival)) {
             oldest = &(rbuf[i]);
         }
     }
 
-    if ((i >= RBUF_SIZE) && (oldest != NULL) && (oldest->pkt != NULL)) {
-        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        ng_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-    }
+    DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+    _rbuf_drop(oldest, &rbuf_stats.full);
+
+    return oldest;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL;
+    rbuf_t **bucket = _rbuf_bucket(src, src_len, dst, dst_len, tag);
+    rbuf_t *res;
     timex_t now;
 
     vtimer_now(&now);
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].datagram_size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
+    LL_FOREACH(*bucket, res) {
+        if ((res->datagram_size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
                   ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                       rbuf[i].src, rbuf[i].src_len));
+                                       res->src, res->src_len));
             DEBUG("%s, %u, %" PRIu16 ") found\n",
                   ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                       rbuf[i].dst, rbuf[i].dst_len),
-                  rbuf[i].datagram_size, rbuf[i].tag);
-            rbuf[i].arrival = now.seconds;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
+                                       res->dst, res->dst_len),
+                  res->datagram_size, res->tag);
+            res->arrival = now.seconds;
+            return res;
         }
     }
 
-    if (res != NULL) { /* entry not in buffer but found empty spot */
-        res->pkt = ng_pktbuf_add(NULL, NULL, size, NG_NETTYPE_SIXLOWPAN);
-        if (res->pkt == NULL) {
-            DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
-            return NULL;
-        }
-
-        *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
-                                             * look-ups */
-        res->arrival = now.seconds;
-        memcpy(res->src, src, src_len);
-        memcpy(res->dst, dst, dst_len);
-        res->src_len = src_len;
-        res->dst_len = dst_len;
-        res->tag = tag;
-        res->datagram_size = size;
-        res->cur_size = 0;
-
-        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
-              ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
-                                   res->src_len));
-        DEBUG("%s, %u, %" PRIu16 ") created\n",
-              ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->dst,
-                                   res->dst_len), res->datagram_size, res->tag);
+    /* entry not in buffer */
+    res = _rbuf_alloc(now.seconds);
+    res->pkt = ng_pktbuf_add(NULL, NULL, size, NG_NETTYPE_SIXLOWPAN);
+    if (res->pkt == NULL) {
+        DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        rbuf_stats.nomem++;
+        return NULL;
     }
 
+    *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
+                                         * look-ups */
+    res->arrival = now.seconds;
+    memcpy(res->src, src, src_len);
+    memcpy(res->dst, dst, dst_len);
+    res->src_len = src_len;
+    res->dst_len = dst_len;
+    res->tag = tag;
+    res->datagram_size = size;
+    res->cur_size = 0;
+    memset(res->received, 0, sizeof(res->received));
+    LL_PREPEND(*bucket, res);
+
+    DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+          ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
+                               res->src_len));
+    DEBUG("%s, %u, %" PRIu16 ") created\n",
+          ng_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->dst,
+                               res->dst_len), res->datagram_size, res->tag);
+
+    _rbuf_gc_schedule(now.seconds);
+
     return res;
 }
 
@@ -32,24 +32,37 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)    /**< maximum length for link-layer addresses */
-#define RBUF_SIZE           (4U)    /**< size of the reassembly buffer */
+
+/**
+ * @brief   Number of datagrams that can be reassembled concurrently
+ */
+#ifndef RBUF_SIZE
+#define RBUF_SIZE           (8U)
+#endif
+
+/**
+ * @brief   Number of hash buckets to look up reassembly buffer entries
+ */
+#ifndef RBUF_HASH_SIZE
+#define RBUF_HASH_SIZE      (RBUF_SIZE)
+#endif
+
 #define RBUF_TIMEOUT        (3U)    /**< timeout for reassembly in seconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
- *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * @brief   Granularity of fragment offsets in bytes
  *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNIT           (8U)
+
+/**
+ * @brief   Size of the bitmap of received units for the largest datagram
+ */
+#define RBUF_BITMAP_SIZE    ((NG_SIXLOWPAN_FRAG_SIZE_MASK + (8U * RBUF_UNIT) - 1) / \
+                             (8U * RBUF_UNIT))
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -63,12 +76,18 @@ typedef struct rbuf_int {
  *
  * to identify all fragments that belong to the given datagram.
  *
+ * Since fragments start at multiples of @ref RBUF_UNIT, the received parts of
+ * the datagram are kept as a bitmap of these units.
+ *
+ * @note    Fragments MUST NOT overlap and overlapping fragments are to be
+ *          discarded
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  */
-typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+typedef struct rbuf {
+    struct rbuf *next;                  /**< next entry in hash bucket */
     ng_pktsnip_t *pkt;                  /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in seconds of arrival of last
                                          *   received fragment */
@@ -79,8 +98,14 @@ typedef struct {
     uint16_t tag;                       /**< the datagram's tag */
     uint16_t datagram_size;             /**< the datagram's size (without 6lo dispatches) */
     uint16_t cur_size;                  /**< the datagram's current size */
+    uint8_t received[RBUF_BITMAP_SIZE]; /**< received units of the datagram */
 } rbuf_t;
 
+/**
+ * @brief   Statistics of the reassembly buffer
+ */
+extern ng_sixlowpan_frag_stats_t rbuf_stats;
+
 /**
  * @brief   Adds a new fragment to the reassembly buffer.
  *
@@ -94,6 +119,14 @@ typedef struct {
 void rbuf_add(ng_netif_hdr_t *netif_hdr, ng_sixlowpan_frag_t *frag,
               size_t frag_size, size_t offset);
 
+/**
+ * @brief   Removes timed out datagrams from the reassembly buffer.
+ *
+ * @details Called on @ref NG_SIXLOWPAN_MSG_FRAG_GC_RBUF, which the reassembly
+ *          buffer sends to the 6LoWPAN thread while datagrams are pending.
+ */
+void rbuf_gc(void);
+
 #ifdef __cplusplus
 }
 #endif
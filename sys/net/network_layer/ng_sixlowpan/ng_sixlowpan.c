@@ -281,7 +281,7 @@ static void _send(ng_pktsnip_t *pkt)
 
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[NG_SIXLOWPAN_MSG_QUEUE_SIZE];
+    msg_t msgs[NG_SIXLOWPAN_MSG_QUEUE_SIZE], reply, msg_q[NG_SIXLOWPAN_MSG_QUEUE_SIZE];
     ng_netreg_entry_t me_reg;
 
     (void)args;
@@ -291,37 +291,54 @@ static void *_event_loop(void *args)
     me_reg.pid = thread_getpid();
 
     /* register interest in all 6LoWPAN packets */
-    ng_netreg_register(NG_NETTYPE_SIXLOWPAN, &me_reg);
+    if (ng_netreg_register(NG_NETTYPE_SIXLOWPAN, &me_reg) < 0) {
+        DEBUG("6lo: unable to register at netreg\n");
+        return NULL;
+    }
 
     /* preinitialize ACK */
     reply.type = NG_NETAPI_MSG_TYPE_ACK;
 
     /* start event loop */
     while (1) {
-        DEBUG("6lo: waiting for incoming message.\n");
-        msg_receive(&msg);
-
-        switch (msg.type) {
-            case NG_NETAPI_MSG_TYPE_RCV:
-                DEBUG("6lo: NG_NETDEV_MSG_TYPE_RCV received\n");
-                _receive((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_SND:
-                DEBUG("6lo: NG_NETDEV_MSG_TYPE_SND received\n");
-                _send((ng_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case NG_NETAPI_MSG_TYPE_GET:
-            case NG_NETAPI_MSG_TYPE_SET:
-                DEBUG("6lo: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            default:
-                DEBUG("6lo: operation not supported\n");
-                break;
+        int num;
+
+        DEBUG("6lo: waiting for incoming messages.\n");
+        /* drain bursts of packets with a single critical section */
+        num = msg_receive_bulk(msgs, NG_SIXLOWPAN_MSG_QUEUE_SIZE);
+
+        for (int i = 0; i < num; i++) {
+            msg_t *msg = &msgs[i];
+
+            switch (msg->type) {
+                case NG_NETAPI_MSG_TYPE_RCV:
+                    DEBUG("6lo: NG_NETDEV_MSG_TYPE_RCV received\n");
+                    _receive((ng_pktsnip_t *)msg->content.ptr);
+                    break;
+
+                case NG_NETAPI_MSG_TYPE_SND:
+                    DEBUG("6lo: NG_NETDEV_MSG_TYPE_SND received\n");
+                    _send((ng_pktsnip_t *)msg->content.ptr);
+                    break;
+
+#ifdef MODULE_NG_SIXLOWPAN_FRAG
+                case NG_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                    DEBUG("6lo: garbage collect reassembly buffer\n");
+                    ng_sixlowpan_frag_gc_rbuf();
+                    break;
+#endif
+
+                case NG_NETAPI_MSG_TYPE_GET:
+                case NG_NETAPI_MSG_TYPE_SET:
+                    DEBUG("6lo: reply to unsupported get/set\n");
+                    reply.content.value = -ENOTSUP;
+                    msg_reply(msg, &reply);
+                    break;
+
+                default:
+                    DEBUG("6lo: operation not supported\n");
+                    break;
+            }
         }
     }
 
@@ -65,7 +65,36 @@ static msg_t srh_m_send, srh_m_recv;
 #endif
 
 #if RPL_MAX_ROUTING_ENTRIES != 0
+#if RPL_MAX_ROUTING_ENTRIES > 255
+#error "RPL_MAX_ROUTING_ENTRIES must not exceed 255"
+#endif
 static rpl_routing_entry_t rpl_routing_table[RPL_MAX_ROUTING_ENTRIES];
+/* index + 1 of the first entry of each hash bucket, 0 if empty */
+static uint8_t rpl_routing_hash[RPL_ROUTING_HASH_SIZE];
+/* index + 1 of the next entry in the same hash bucket, 0 if last */
+static uint8_t rpl_routing_hnext[RPL_MAX_ROUTING_ENTRIES];
+/* stack of unused entries */
+static uint8_t rpl_routing_free[RPL_MAX_ROUTING_ENTRIES];
+static uint8_t rpl_routing_free_num;
+/* min-heap of used entries by expiry time, and position of each entry in it */
+static uint8_t rpl_routing_heap[RPL_MAX_ROUTING_ENTRIES];
+static uint8_t rpl_routing_heap_pos[RPL_MAX_ROUTING_ENTRIES];
+static uint8_t rpl_routing_heap_num;
+#endif
+
+#if (RPL_DEFAULT_MOP == RPL_MOP_NON_STORING_MODE) && (RPL_MAX_ROUTING_ENTRIES != 0)
+/* source route to a destination as routing table indices, the destination's
+ * entry first */
+typedef struct {
+    ipv6_addr_t dest;
+    uint8_t hops[RPL_MAX_SRH_PATH_LENGTH];
+    uint8_t len;
+    uint8_t used;
+} srh_cache_entry_t;
+
+/* flushed on every change of the child/parent relations */
+static srh_cache_entry_t srh_cache[RPL_SRH_CACHE_SIZE];
+static uint8_t srh_cache_next;
 #endif
 uint8_t rpl_max_routing_entries;
 ipv6_addr_t my_address;
@@ -73,6 +102,126 @@ ipv6_addr_t my_address;
 /* IPv6 message buffer */
 static ipv6_hdr_t *ipv6_buf;
 
+#if RPL_MAX_ROUTING_ENTRIES != 0
+/* rpl_equal_id() compares the last two bytes, so they make the key */
+static inline uint8_t _routing_hash(const ipv6_addr_t *addr)
+{
+    return ((addr->uint8[14] << 8) | addr->uint8[15]) % RPL_ROUTING_HASH_SIZE;
+}
+
+static inline uint32_t _routing_now(void)
+{
+    timex_t now;
+
+    vtimer_now(&now);
+
+    return now.seconds;
+}
+
+static inline int _heap_less(uint8_t a, uint8_t b)
+{
+    return rpl_routing_table[rpl_routing_heap[a]].expires <
+           rpl_routing_table[rpl_routing_heap[b]].expires;
+}
+
+static void _heap_swap(uint8_t a, uint8_t b)
+{
+    uint8_t tmp = rpl_routing_heap[a];
+
+    rpl_routing_heap[a] = rpl_routing_heap[b];
+    rpl_routing_heap[b] = tmp;
+    rpl_routing_heap_pos[rpl_routing_heap[a]] = a;
+    rpl_routing_heap_pos[rpl_routing_heap[b]] = b;
+}
+
+/* restores the heap property for the entry at heap position pos */
+static void _heap_fix(uint8_t pos)
+{
+    while ((pos > 0) && _heap_less(pos, (pos - 1) / 2)) {
+        _heap_swap(pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+
+    while (1) {
+        unsigned min = pos, child = 2 * pos + 1;
+
+        if ((child < rpl_routing_heap_num) && _heap_less(child, min)) {
+            min = child;
+        }
+
+        if ((child + 1 < rpl_routing_heap_num) && _heap_less(child + 1, min)) {
+            min = child + 1;
+        }
+
+        if (min == pos) {
+            break;
+        }
+
+        _heap_swap(pos, min);
+        pos = min;
+    }
+}
+
+static void _routing_entry_set_lifetime(rpl_routing_entry_t *entry, uint16_t lifetime)
+{
+    entry->expires = _routing_now() + lifetime;
+    _heap_fix(rpl_routing_heap_pos[entry - rpl_routing_table]);
+}
+
+static rpl_routing_entry_t *_routing_entry_add(ipv6_addr_t *addr, ipv6_addr_t *next_hop,
+                                               uint16_t lifetime)
+{
+    uint8_t i, h = _routing_hash(addr);
+
+    if (rpl_routing_free_num == 0) {
+        DEBUGF("Routing table is full\n");
+        return NULL;
+    }
+
+    i = rpl_routing_free[--rpl_routing_free_num];
+    memcpy(&rpl_routing_table[i].address, addr, sizeof(ipv6_addr_t));
+    memcpy(&rpl_routing_table[i].next_hop, next_hop, sizeof(ipv6_addr_t));
+    rpl_routing_table[i].used = 1;
+    rpl_routing_hnext[i] = rpl_routing_hash[h];
+    rpl_routing_hash[h] = i + 1;
+    rpl_routing_heap[rpl_routing_heap_num] = i;
+    rpl_routing_heap_pos[i] = rpl_routing_heap_num++;
+    _routing_entry_set_lifetime(&rpl_routing_table[i], lifetime);
+
+#if RPL_DEFAULT_MOP == RPL_MOP_NON_STORING_MODE
+    memset(srh_cache, 0, sizeof(srh_cache));
+#endif
+
+    return &rpl_routing_table[i];
+}
+
+static void _routing_entry_remove(uint8_t i)
+{
+    uint8_t *next = &rpl_routing_hash[_routing_hash(&rpl_routing_table[i].address)];
+
+    while (*next != i + 1) {
+        next = &rpl_routing_hnext[*next - 1];
+    }
+
+    *next = rpl_routing_hnext[i];
+
+    /* move the last heap entry into the gap */
+    if (rpl_routing_heap_pos[i] != --rpl_routing_heap_num) {
+        uint8_t pos = rpl_routing_heap_pos[i];
+
+        _heap_swap(pos, rpl_routing_heap_num);
+        _heap_fix(pos);
+    }
+
+    memset(&rpl_routing_table[i], 0, sizeof(rpl_routing_table[i]));
+    rpl_routing_free[rpl_routing_free_num++] = i;
+
+#if RPL_DEFAULT_MOP == RPL_MOP_NON_STORING_MODE
+    memset(srh_cache, 0, sizeof(srh_cache));
+#endif
+}
+#endif
+
 uint8_t rpl_init(int if_id, ipv6_addr_t *address)
 {
     rpl_if_id = if_id;
@@ -80,6 +229,15 @@ uint8_t rpl_init(int if_id, ipv6_addr_t *address)
     /* initialize routing table */
 #if RPL_MAX_ROUTING_ENTRIES != 0
     rpl_max_routing_entries = RPL_MAX_ROUTING_ENTRIES;
+    memset(rpl_routing_table, 0, sizeof(rpl_routing_table));
+    memset(rpl_routing_hash, 0, sizeof(rpl_routing_hash));
+    rpl_routing_heap_num = 0;
+
+    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
+        rpl_routing_free[i] = rpl_max_routing_entries - i - 1;
+    }
+
+    rpl_routing_free_num = rpl_max_routing_entries;
 #endif
 
     rpl_process_pid = thread_create(rpl_process_buf, sizeof(rpl_process_buf),
@@ -109,7 +267,8 @@ uint8_t rpl_init(int if_id, ipv6_addr_t *address)
     rpl_of_manager_init(&my_address);
 
     rt_time = timex_set(RPL_LIFETIME_STEP, 0);
-    vtimer_set_msg(&rt_timer, rt_time, rpl_process_pid, RPL_MSG_TYPE_ROUTING_ENTRY_UPDATE, NULL);
+    vtimer_set_msg_with_slack(&rt_timer, rt_time, timex_set(0, RPL_LIFETIME_SLACK),
+                              rpl_process_pid, RPL_MSG_TYPE_ROUTING_ENTRY_UPDATE, NULL);
 
     return SIXLOWERROR_SUCCESS;
 }
@@ -277,18 +436,16 @@ void *rpl_process(void *arg)
 void _rpl_update_routing_table(void)
 {
     rpl_dodag_t *my_dodag, *end;
-    rpl_routing_entry_t *rt = rpl_get_routing_table();
 
-    for (unsigned int i = 0; i < rpl_max_routing_entries; i++) {
-        if (rt[i].used) {
-            if (rt[i].lifetime <= 1) {
-                memset(&rt[i], 0, sizeof(rt[i]));
-            }
-            else {
-                rt[i].lifetime = rt[i].lifetime - RPL_LIFETIME_STEP;
-            }
-        }
+#if RPL_MAX_ROUTING_ENTRIES != 0
+    uint32_t now = _routing_now();
+
+    /* only the expired entries are at the top of the heap */
+    while ((rpl_routing_heap_num > 0) &&
+           (rpl_routing_table[rpl_routing_heap[0]].expires <= now)) {
+        _routing_entry_remove(rpl_routing_heap[0]);
     }
+#endif
 
     for (my_dodag = rpl_dodags, end = my_dodag + RPL_MAX_DODAGS; my_dodag < end; my_dodag++) {
         if ((my_dodag->used) && (my_dodag->my_preferred_parent != NULL)) {
@@ -304,7 +461,8 @@ void _rpl_update_routing_table(void)
     }
 
     vtimer_remove(&rt_timer);
-    vtimer_set_msg(&rt_timer, rt_time, rpl_process_pid, RPL_MSG_TYPE_ROUTING_ENTRY_UPDATE, NULL);
+    vtimer_set_msg_with_slack(&rt_timer, rt_time, timex_set(0, RPL_LIFETIME_SLACK),
+                              rpl_process_pid, RPL_MSG_TYPE_ROUTING_ENTRY_UPDATE, NULL);
 }
 
 void rpl_delay_dao(rpl_dodag_t *dodag)
@@ -358,29 +516,18 @@ ipv6_addr_t *rpl_get_next_hop(ipv6_addr_t *addr)
            ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, addr));
 
 #if RPL_MAX_ROUTING_ENTRIES != 0
+    rpl_routing_entry_t *entry = rpl_find_routing_entry(addr);
 
-    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-        if (rpl_routing_table[i].used) {
-            DEBUGF("checking %d: %s\n", i,
-                   ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, &rpl_routing_table[i].address));
-        }
-
+    if (entry != NULL) {
         if ((RPL_DEFAULT_MOP == RPL_MOP_NON_STORING_MODE) && rpl_is_root()) {
-            if (rpl_routing_table[i].used && rpl_equal_id(&rpl_routing_table[i].address, addr)) {
-                DEBUGF("found %d: %s\n", i,
-                       ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN,
-                                        &rpl_routing_table[i].address));
-                return &rpl_routing_table[i].address;
-            }
-        }
-        else {
-            if (rpl_routing_table[i].used && rpl_equal_id(&rpl_routing_table[i].address, addr)) {
-                DEBUGF("found %d: %s\n", i,
-                       ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN,
-                                        &rpl_routing_table[i].next_hop));
-                return &rpl_routing_table[i].next_hop;
-            }
+            DEBUGF("found %s\n",
+                   ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, &entry->address));
+            return &entry->address;
         }
+
+        DEBUGF("found %s\n",
+               ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, &entry->next_hop));
+        return &entry->next_hop;
     }
 
 #else
@@ -396,21 +543,13 @@ void rpl_add_routing_entry(ipv6_addr_t *addr, ipv6_addr_t *next_hop, uint16_t li
     rpl_routing_entry_t *entry = rpl_find_routing_entry(addr);
 
     if (entry != NULL) {
-        entry->lifetime = lifetime;
+        _routing_entry_set_lifetime(entry, lifetime);
         return;
     }
 
     DEBUGF("Adding routing entry %s\n", ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, addr));
 
-    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-        if (!rpl_routing_table[i].used) {
-            memcpy(&rpl_routing_table[i].address, addr, sizeof(ipv6_addr_t));
-            memcpy(&rpl_routing_table[i].next_hop, next_hop, sizeof(ipv6_addr_t));
-            rpl_routing_table[i].lifetime = lifetime;
-            rpl_routing_table[i].used = 1;
-            break;
-        }
-    }
+    _routing_entry_add(addr, next_hop, lifetime);
 }
 #endif
 
@@ -420,11 +559,10 @@ void rpl_del_routing_entry(ipv6_addr_t *addr)
 
     DEBUGF("Deleting routing entry %s\n", ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, addr));
 
-    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-        if (rpl_routing_table[i].used && rpl_equal_id(&rpl_routing_table[i].address, addr)) {
-            memset(&rpl_routing_table[i], 0, sizeof(rpl_routing_table[i]));
-            return;
-        }
+    rpl_routing_entry_t *entry = rpl_find_routing_entry(addr);
+
+    if (entry != NULL) {
+        _routing_entry_remove(entry - rpl_routing_table);
     }
 }
 #endif
@@ -435,9 +573,9 @@ rpl_routing_entry_t *rpl_find_routing_entry(ipv6_addr_t *addr)
 
     DEBUGF("Finding routing entry %s\n", ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, addr));
 
-    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-        if (rpl_routing_table[i].used && rpl_equal_id(&rpl_routing_table[i].address, addr)) {
-            return &rpl_routing_table[i];
+    for (uint8_t i = rpl_routing_hash[_routing_hash(addr)]; i; i = rpl_routing_hnext[i - 1]) {
+        if (rpl_equal_id(&rpl_routing_table[i - 1].address, addr)) {
+            return &rpl_routing_table[i - 1];
         }
     }
 
@@ -469,7 +607,7 @@ void rpl_add_srh_entry(ipv6_addr_t *child, ipv6_addr_t *parent, uint16_t lifetim
      */
     if (entry != NULL) {
         if (ipv6_addr_is_equal(parent, &entry->next_hop)) {
-            entry->lifetime = lifetime;
+            _routing_entry_set_lifetime(entry, lifetime);
             return;
         }
         else {
@@ -488,15 +626,7 @@ void rpl_add_srh_entry(ipv6_addr_t *child, ipv6_addr_t *parent, uint16_t lifetim
     DEBUGF("Adding source-routing entry parent: %s\n",
            ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, parent));
 
-    for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-        if (!rpl_routing_table[i].used) {
-            memcpy(&rpl_routing_table[i].address, child, sizeof(ipv6_addr_t));
-            memcpy(&rpl_routing_table[i].next_hop, parent, sizeof(ipv6_addr_t));
-            rpl_routing_table[i].lifetime = lifetime;
-            rpl_routing_table[i].used = 1;
-            break;
-        }
-    }
+    _routing_entry_add(child, parent, lifetime);
 }
 #endif
 
@@ -515,64 +645,90 @@ int ipv6_suffix_is_equal(const ipv6_addr_t *a, const ipv6_addr_t *b)
 }
 
 #if RPL_MAX_ROUTING_ENTRIES != 0
-ipv6_srh_t *rpl_get_srh_header(ipv6_hdr_t *act_ipv6_hdr)
+/* index of the routing entry of the child with the host suffix of addr */
+static int _srh_find_parent(const ipv6_addr_t *addr)
 {
-    uint8_t route_length = RPL_MAX_SRH_PATH_LENGTH;
-    ipv6_addr_t rev_route[route_length];
-    ipv6_addr_t *actual_node;
-    uint8_t counter = 0;
-    uint8_t traceable;
-    ipv6_srh_t *srh_header = (ipv6_srh_t *)(&srh_buffer);
+    for (uint8_t i = rpl_routing_hash[_routing_hash(addr)]; i; i = rpl_routing_hnext[i - 1]) {
+        if (ipv6_suffix_is_equal(&rpl_routing_table[i - 1].address, addr)) {
+            return i - 1;
+        }
+    }
 
-    /* init source route with child */
-    actual_node = &(act_ipv6_hdr->destaddr);
-    DEBUGF("DESTINATION NODE: %s\n", ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, actual_node));
-
-    while (!(rpl_equal_id(actual_node, &my_address))) {
-        /* set check variable - this is reversed,
-         * if a child/parent-relation is found in one iteration of the routing table */
-        traceable = 0;
-
-        for (uint8_t i = 0; i < rpl_max_routing_entries; i++) {
-            if (rpl_routing_table[i].used
-                && ipv6_suffix_is_equal(&rpl_routing_table[i].address, actual_node)) {
-                DEBUGF("[INFO] Found parent-child relation with P: %s\n",
-                       ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN,
-                                        &rpl_routing_table[i].next_hop));
-                DEBUGF(" and C: %s\n",
-                       ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, actual_node));
-                memcpy(&rev_route[counter], actual_node, sizeof(ipv6_addr_t));
-
-                actual_node = &rpl_routing_table[i].next_hop;
-                counter++;
-                traceable = 1;
-
-                if (counter > route_length) {
-                    DEBUGF("[INFO] Both lengths are %d and %d\n", counter, route_length);
-                    DEBUGF("Error with computing source routing header.\n");
-                    return NULL;
-                }
+    return -1;
+}
 
-                break;
-            }
-        }
+/* follows the parents from dest up to this node */
+static srh_cache_entry_t *_srh_route(const ipv6_addr_t *dest)
+{
+    srh_cache_entry_t *route = &srh_cache[srh_cache_next];
+    const ipv6_addr_t *actual_node = dest;
+    int i;
+
+    srh_cache_next = (srh_cache_next + 1) % RPL_SRH_CACHE_SIZE;
+    memcpy(&route->dest, dest, sizeof(ipv6_addr_t));
+    route->len = 0;
+    route->used = 0;
 
-        if (traceable == 0) {
+    while (!(rpl_equal_id((ipv6_addr_t *) actual_node, &my_address))) {
+        if ((i = _srh_find_parent(actual_node)) < 0) {
             DEBUGF("No route to destination.\n");
             return NULL;
         }
+
+        if (route->len >= RPL_MAX_SRH_PATH_LENGTH) {
+            DEBUGF("Error with computing source routing header.\n");
+            return NULL;
+        }
+
+        DEBUGF("[INFO] Found parent-child relation with P: %s\n",
+               ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN,
+                                &rpl_routing_table[i].next_hop));
+        route->hops[route->len++] = i;
+        actual_node = &rpl_routing_table[i].next_hop;
     }
 
-    /* build real route based on reversed route.
-     * After building it starts with the node next to destination
+    route->used = 1;
+
+    return route;
+}
+
+ipv6_srh_t *rpl_get_srh_header(ipv6_hdr_t *act_ipv6_hdr)
+{
+    ipv6_srh_t *srh_header = (ipv6_srh_t *)(&srh_buffer);
+    srh_cache_entry_t *route = NULL;
+    uint8_t counter;
+
+    DEBUGF("DESTINATION NODE: %s\n",
+           ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN, &act_ipv6_hdr->destaddr));
+
+    for (uint8_t i = 0; i < RPL_SRH_CACHE_SIZE; i++) {
+        if (srh_cache[i].used && ipv6_addr_is_equal(&srh_cache[i].dest, &act_ipv6_hdr->destaddr)) {
+            route = &srh_cache[i];
+            break;
+        }
+    }
+
+    if ((route == NULL) && ((route = _srh_route(&act_ipv6_hdr->destaddr)) == NULL)) {
+        return NULL;
+    }
+
+    counter = route->len;
+
+    /* build real route based on the reversed route: hop i of the reversed
+     * route is the destination for i == 0 and the parent of hop i - 1
+     * otherwise. After building it starts with the node next to destination
      */
     if (counter > 1) {
         for (uint8_t i = 0; i < counter - 1; i++) {
-            memcpy(&srh_header->route[i], &rev_route[counter - i - 2], sizeof(ipv6_addr_t));
+            uint8_t hop = counter - i - 2;
+            ipv6_addr_t *addr = (hop == 0) ? &route->dest
+                                : &rpl_routing_table[route->hops[hop - 1]].next_hop;
+            memcpy(&srh_header->route[i], addr, sizeof(ipv6_addr_t));
         }
 
         srh_header->hdrextlen = sizeof(ipv6_addr_t) * (counter - 1);
-        memcpy(&(act_ipv6_hdr->destaddr), &rev_route[counter - 1], sizeof(ipv6_addr_t));
+        memcpy(&(act_ipv6_hdr->destaddr), &rpl_routing_table[route->hops[counter - 2]].next_hop,
+               sizeof(ipv6_addr_t));
         DEBUGF("Route size: %d\n", srh_header->hdrextlen);
     }
     else {
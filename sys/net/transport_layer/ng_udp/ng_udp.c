@@ -71,7 +71,8 @@ static uint16_t _calc_csum(ng_pktsnip_t *hdr, ng_pktsnip_t *pseudo_hdr,
 
     /* process the payload */
     while (payload && payload != hdr) {
-        csum = ng_inet_csum(csum, (uint8_t *)(payload->data), payload->size);
+        csum = ng_inet_csum_slice(csum, (uint8_t *)(payload->data),
+                                  payload->size, len);
         len += (uint16_t)payload->size;
         payload = payload->next;
     }
@@ -100,7 +101,7 @@ static void _receive(ng_pktsnip_t *pkt)
     uint32_t port;
 
     /* mark UDP header */
-    udp = ng_pktbuf_start_write(pkt);
+    udp = ng_pktbuf_start_mark(pkt);
     if (udp == NULL) {
         DEBUG("udp: unable to get write access to packet\n");
         ng_pktbuf_release(pkt);
@@ -176,7 +177,10 @@ static void *_event_loop(void *arg)
     /* register UPD at netreg */
     netreg.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
     netreg.pid = thread_getpid();
-    ng_netreg_register(NG_NETTYPE_UDP, &netreg);
+    if (ng_netreg_register(NG_NETTYPE_UDP, &netreg) < 0) {
+        DEBUG("udp: unable to register at netreg\n");
+        return NULL;
+    }
 
     /* dispatch NETAPI messages */
     while (1) {
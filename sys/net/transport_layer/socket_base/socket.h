@@ -39,6 +39,24 @@ typedef struct __attribute__((packed)) {
     uint8_t         hc_type;
 } tcp_hc_context_t;
 
+/* Number of unacknowledged segments a socket may have in flight */
+#ifndef TCP_RETRANS_QUEUE_SIZE
+#define TCP_RETRANS_QUEUE_SIZE  (4)
+#endif
+
+/* Number of duplicate ACKs triggering a fast retransmit */
+#ifndef TCP_DUP_ACK_THRESHOLD
+#define TCP_DUP_ACK_THRESHOLD   (3)
+#endif
+
+/* Sent, but not yet acknowledged segment */
+typedef struct __attribute__((packed)) {
+    uint32_t            seq;            // sequence number of first byte
+    uint16_t            len;            // payload length
+    uint8_t             retransmitted;  // no RTT sample from retransmissions
+    timex_t             send_time;      // time the segment was (re)sent
+} tcp_retrans_seg_t;
+
 typedef struct __attribute__((packed)) {
     uint32_t            send_una;
     uint32_t            send_nxt;
@@ -55,6 +73,11 @@ typedef struct __attribute__((packed)) {
 
     uint8_t             state;
 
+    tcp_retrans_seg_t   retrans_queue[TCP_RETRANS_QUEUE_SIZE];
+    uint8_t             retrans_head;
+    uint8_t             retrans_num;
+    uint8_t             dup_acks;
+
     double              srtt;
     double              rttvar;
     double              rto;
@@ -82,8 +105,11 @@ typedef struct {
     uint8_t             send_pid;
     socket_t            socket_values;
 #ifdef MODULE_TCP
-    uint8_t             tcp_input_buffer_end;
+    uint16_t            tcp_input_buffer_end;
     mutex_t             tcp_buffer_mutex;
+    mutex_t             tcp_send_mutex;
+    uint8_t             tcp_send_waiting;   // tcp_send() sleeps for an event
+    uint16_t            tcp_send_event;     // TCP_ACK, TCP_RETRY or TCP_TIMEOUT
     uint8_t             tcp_input_buffer[TRANSPORT_LAYER_SOCKET_MAX_TCP_BUFFER];
 #endif
 } socket_internal_t;
@@ -36,6 +36,9 @@
 
 #include "tcp.h"
 
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
 #ifdef TCP_HC
 mutex_t             global_context_counter_mutex;
 uint8_t             global_context_counter;
@@ -47,6 +50,8 @@ uint32_t            global_sequence_counter;
 char tcp_stack_buffer[TCP_STACK_SIZE];
 char tcp_timer_stack[TCP_TIMER_STACKSIZE];
 
+void calculate_rto(tcp_cb_t *tcp_control, timex_t current_time);
+
 void set_socket_address(sockaddr6_t *sockaddr, uint8_t sin6_family,
                         uint16_t sin6_port, uint32_t sin6_flowinfo, ipv6_addr_t *sin6_addr)
 {
@@ -170,19 +175,25 @@ uint16_t tcp_csum(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header)
 int check_tcp_consistency(socket_t *current_tcp_socket, tcp_hdr_t *tcp_header, uint8_t tcp_payload_len)
 {
     if (tcp_payload_len == 0) {
-        if (tcp_header->ack_nr > (current_tcp_socket->tcp_control.send_nxt)) {
+        if (TCP_SEQ_LT(current_tcp_socket->tcp_control.send_nxt, tcp_header->ack_nr)) {
             /* ACK of not yet sent byte, discard */
             return ACK_NO_TOO_BIG;
         }
-        else if (tcp_header->ack_nr <= (current_tcp_socket->tcp_control.send_una)) {
+        else if (TCP_SEQ_LEQ(tcp_header->ack_nr, current_tcp_socket->tcp_control.send_una)) {
             /* ACK of previous segments, maybe dropped? */
             return ACK_NO_TOO_SMALL;
         }
     }
-    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && (tcp_header->seq_nr < current_tcp_socket->tcp_control.rcv_nxt)) {
+    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && TCP_SEQ_LT(tcp_header->seq_nr, current_tcp_socket->tcp_control.rcv_nxt)) {
         /* segment repetition, maybe ACK got lost? */
         return SEQ_NO_TOO_SMALL;
     }
+    else if ((current_tcp_socket->tcp_control.rcv_nxt > 0) && TCP_SEQ_LT(current_tcp_socket->tcp_control.rcv_nxt, tcp_header->seq_nr)) {
+        /* segment out of order, a previous one got lost. Out of order
+         * segments are not buffered, the duplicate ACK makes the sender
+         * retransmit from the gap */
+        return SEQ_NO_TOO_BIG;
+    }
 
     return PACKET_OK;
 }
@@ -238,8 +249,10 @@ void set_tcp_packet(tcp_hdr_t *tcp_hdr, uint16_t src_port, uint16_t dst_port,
     tcp_hdr->window         = window;
 }
 
-int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
-             ipv6_hdr_t *temp_ipv6_header, uint8_t flags, uint8_t payload_length)
+static int send_tcp_seq(socket_internal_t *current_socket,
+                        tcp_hdr_t *current_tcp_packet,
+                        ipv6_hdr_t *temp_ipv6_header, uint32_t seq_nr,
+                        uint8_t flags, uint8_t payload_length)
 {
     socket_t *current_tcp_socket = &current_socket->socket_values;
     uint8_t header_length = TCP_HDR_LEN / 4;
@@ -257,7 +270,7 @@ int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
 
     set_tcp_packet(current_tcp_packet, current_tcp_socket->local_address.sin6_port,
                    current_tcp_socket->foreign_address.sin6_port,
-                   current_tcp_socket->tcp_control.send_una,
+                   seq_nr,
                    (IS_TCP_ACK(flags) ? current_tcp_socket->tcp_control.rcv_nxt : 0x00), header_length, flags,
                    current_tcp_socket->tcp_control.rcv_wnd, 0, 0);
 
@@ -294,6 +307,14 @@ int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
 #endif
 }
 
+int send_tcp(socket_internal_t *current_socket, tcp_hdr_t *current_tcp_packet,
+             ipv6_hdr_t *temp_ipv6_header, uint8_t flags, uint8_t payload_length)
+{
+    return send_tcp_seq(current_socket, current_tcp_packet, temp_ipv6_header,
+                        current_socket->socket_values.tcp_control.send_una,
+                        flags, payload_length);
+}
+
 bool is_four_touple(socket_internal_t *current_socket, ipv6_hdr_t *ipv6_header,
                     tcp_hdr_t *tcp_header)
 {
@@ -431,17 +452,18 @@ uint8_t handle_payload(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
 
     if (tcp_payload_len > tcp_socket->socket_values.tcp_control.rcv_wnd) {
         mutex_lock(&tcp_socket->tcp_buffer_mutex);
-        memcpy(tcp_socket->tcp_input_buffer, payload,
-               tcp_socket->socket_values.tcp_control.rcv_wnd);
+        memcpy(tcp_socket->tcp_input_buffer + tcp_socket->tcp_input_buffer_end,
+               payload, tcp_socket->socket_values.tcp_control.rcv_wnd);
         acknowledged_bytes = tcp_socket->socket_values.tcp_control.rcv_wnd;
         tcp_socket->socket_values.tcp_control.rcv_wnd = 0;
         tcp_socket->tcp_input_buffer_end = tcp_socket->tcp_input_buffer_end +
-                                           tcp_socket->socket_values.tcp_control.rcv_wnd;
+                                           acknowledged_bytes;
         mutex_unlock(&tcp_socket->tcp_buffer_mutex);
     }
     else {
         mutex_lock(&tcp_socket->tcp_buffer_mutex);
-        memcpy(tcp_socket->tcp_input_buffer, payload, tcp_payload_len);
+        memcpy(tcp_socket->tcp_input_buffer + tcp_socket->tcp_input_buffer_end,
+               payload, tcp_payload_len);
         tcp_socket->socket_values.tcp_control.rcv_wnd =
             tcp_socket->socket_values.tcp_control.rcv_wnd - tcp_payload_len;
         acknowledged_bytes = tcp_payload_len;
@@ -457,6 +479,41 @@ uint8_t handle_payload(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
     return acknowledged_bytes;
 }
 
+/* Removes the segments covered by the cumulative ACK @p ack_nr from the
+ * retransmission queue and samples the RTT from the newest of them */
+static void ack_segments(tcp_cb_t *tcp_control, uint32_t ack_nr)
+{
+    tcp_retrans_seg_t *sample = NULL;
+    timex_t now;
+
+    vtimer_now(&now);
+
+    while (tcp_control->retrans_num > 0) {
+        tcp_retrans_seg_t *seg = &tcp_control->retrans_queue[tcp_control->retrans_head];
+
+        if (TCP_SEQ_LT(ack_nr, seg->seq + seg->len)) {
+            break;
+        }
+
+        /* Karn's algorithm: ACKs of retransmissions are ambiguous */
+        sample = (seg->retransmitted) ? NULL : seg;
+        tcp_control->retrans_head = (tcp_control->retrans_head + 1) %
+                                    TCP_RETRANS_QUEUE_SIZE;
+        tcp_control->retrans_num--;
+    }
+
+    if (sample != NULL) {
+        tcp_control->last_packet_time = sample->send_time;
+        calculate_rto(tcp_control, now);
+    }
+
+    tcp_control->send_una = ack_nr;
+    tcp_control->dup_acks = 0;
+    tcp_control->no_of_retries = 0;
+    /* restart retransmission timer for the remaining segments */
+    tcp_control->last_packet_time = now;
+}
+
 void handle_tcp_ack_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
                            socket_internal_t *tcp_socket)
 {
@@ -480,9 +537,44 @@ void handle_tcp_ack_packet(ipv6_hdr_t *ipv6_header, tcp_hdr_t *tcp_header,
         return;
     }
     else if (tcp_socket->socket_values.tcp_control.state == TCP_ESTABLISHED) {
-        if (check_tcp_consistency(&tcp_socket->socket_values, tcp_header, 0) == PACKET_OK) {
-            m_send_tcp.content.ptr = (char *)tcp_header;
-            socket_base_net_msg_send(&m_send_tcp, tcp_socket->send_pid, 0, TCP_ACK);
+        tcp_cb_t *tcp_control = &tcp_socket->socket_values.tcp_control;
+        uint16_t notify = 0;
+        int consistency;
+
+        /* tcp_send() changes the send state concurrently */
+        mutex_lock(&tcp_socket->tcp_send_mutex);
+
+        consistency = check_tcp_consistency(&tcp_socket->socket_values,
+                                            tcp_header, 0);
+
+        if (consistency == PACKET_OK) {
+            /* ACK of new data, possibly of several segments */
+            ack_segments(tcp_control, tcp_header->ack_nr);
+            tcp_control->send_wnd = tcp_header->window;
+            notify = TCP_ACK;
+        }
+        else if ((consistency == ACK_NO_TOO_SMALL) &&
+                 (tcp_header->ack_nr == tcp_control->send_una)) {
+            tcp_control->send_wnd = tcp_header->window;
+
+            if (tcp_control->send_nxt == tcp_control->send_una) {
+                /* window update */
+                notify = TCP_ACK;
+            }
+            else if (++tcp_control->dup_acks == TCP_DUP_ACK_THRESHOLD) {
+                /* receiver is missing the segment at send_una */
+                notify = TCP_RETRY;
+            }
+        }
+
+        if (notify != 0) {
+            tcp_send_notify(tcp_socket, notify);
+        }
+
+        mutex_unlock(&tcp_socket->tcp_send_mutex);
+
+        if ((consistency == PACKET_OK) || (consistency == ACK_NO_TOO_SMALL)) {
+            /* old, reordered ACKs are ignored */
             return;
         }
     }
@@ -904,16 +996,52 @@ int handle_new_tcp_connection(socket_internal_t *current_queued_int_socket,
     return current_queued_int_socket->socket_id;
 }
 
+/* Hands an event to tcp_send() and wakes it up if it sleeps, the caller
+ * holds tcp_send_mutex. Events are kept until tcp_send() takes them, so none
+ * is lost if tcp_send() does not sleep yet. */
+void tcp_send_notify(socket_internal_t *tcp_socket, uint16_t event)
+{
+    /* a pending timeout or retransmission is not overridden by an ACK */
+    if ((tcp_socket->tcp_send_event != TCP_TIMEOUT) &&
+        ((tcp_socket->tcp_send_event != TCP_RETRY) || (event == TCP_TIMEOUT))) {
+        tcp_socket->tcp_send_event = event;
+    }
+
+    if (tcp_socket->tcp_send_waiting) {
+        tcp_socket->tcp_send_waiting = 0;
+        thread_wakeup(tcp_socket->send_pid);
+    }
+}
+
+/* Queues a segment for retransmission */
+static void queue_segment(tcp_cb_t *tcp_control, uint32_t seq, uint16_t len,
+                          uint8_t retransmitted)
+{
+    tcp_retrans_seg_t *seg = &tcp_control->retrans_queue[(tcp_control->retrans_head +
+                                                          tcp_control->retrans_num) %
+                                                         TCP_RETRANS_QUEUE_SIZE];
+
+    timex_t now;
+
+    vtimer_now(&now);
+    seg->seq = seq;
+    seg->len = len;
+    seg->retransmitted = retransmitted;
+    seg->send_time = now;
+    tcp_control->retrans_num++;
+}
+
 int32_t tcp_send(int s, const void *buf, uint32_t len, int flags)
 {
     (void) flags;
 
     /* Variables */
-    msg_t recv_msg;
-    int32_t sent_bytes = 0;
-    uint32_t total_sent_bytes = 0;
+    uint16_t event;
+    uint32_t start_seq, send_max;
+    uint16_t mss;
     socket_internal_t *current_int_tcp_socket;
     socket_t *current_tcp_socket;
+    tcp_cb_t *tcp_control;
     uint8_t send_buffer[BUFFER_SIZE];
     memset(send_buffer, 0, BUFFER_SIZE);
     ipv6_hdr_t *temp_ipv6_header = ((ipv6_hdr_t *)(&send_buffer));
@@ -926,156 +1054,166 @@ int32_t tcp_send(int s, const void *buf, uint32_t len, int flags)
 
     current_int_tcp_socket = socket_base_get_socket(s);
     current_tcp_socket = &current_int_tcp_socket->socket_values;
+    tcp_control = &current_tcp_socket->tcp_control;
 
     /* Check for TCP_ESTABLISHED STATE */
-    if (current_tcp_socket->tcp_control.state != TCP_ESTABLISHED) {
+    if (tcp_control->state != TCP_ESTABLISHED) {
         return -1;
     }
 
+    mss = (tcp_control->mss > 0) ? tcp_control->mss :
+          TRANSPORT_LAYER_SOCKET_STATIC_MSS;
+
+    if (mss > (BUFFER_SIZE - IPV6_HDR_LEN - TCP_HDR_LEN)) {
+        mss = BUFFER_SIZE - IPV6_HDR_LEN - TCP_HDR_LEN;
+    }
+
     /* Add thread PID */
     current_int_tcp_socket->send_pid = thread_getpid();
 
-    recv_msg.type = UNDEFINED;
+    /* handle_tcp_ack_packet() and the TCP timer access the send state from
+     * other threads, only release it while sending or waiting */
+    mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
 
-    while (1) {
-        current_tcp_socket->tcp_control.no_of_retries = 0;
+    tcp_control->no_of_retries = 0;
+    tcp_control->dup_acks = 0;
+    /* nothing is in flight between calls, events of the last call are
+     * obsolete */
+    tcp_control->send_nxt = tcp_control->send_una;
+    tcp_control->retrans_num = 0;
+    current_int_tcp_socket->tcp_send_event = 0;
 
 #ifdef TCP_HC
-        current_tcp_socket->tcp_control.tcp_context.hc_type = COMPRESSED_HEADER;
-        /* Remember TCP Context for possible TCP_RETRY */
-        tcp_hc_context_t saved_tcp_context;
-        memcpy(&saved_tcp_context, &current_tcp_socket->tcp_control.tcp_context,
-               sizeof(tcp_hc_context_t) - 1);
+    tcp_control->tcp_context.hc_type = COMPRESSED_HEADER;
 #endif
 
-        while (recv_msg.type != TCP_ACK) {
-            /* Add packet data */
-            if (current_tcp_socket->tcp_control.send_wnd >
-                current_tcp_socket->tcp_control.mss) {
-                /* Window size > Maximum Segment Size */
-                if ((len - total_sent_bytes) > current_tcp_socket->tcp_control.mss) {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN], buf,
-                           current_tcp_socket->tcp_control.mss);
-                    sent_bytes = current_tcp_socket->tcp_control.mss;
-                    total_sent_bytes += sent_bytes;
-                }
-                else {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN],
-                           (uint8_t *) buf + total_sent_bytes, len - total_sent_bytes);
-                    sent_bytes = len - total_sent_bytes;
-                    total_sent_bytes = len;
-                }
+    /* Everything before was acknowledged, all bytes of buf are in
+     * [start_seq, start_seq + len). Bytes below send_max were sent before,
+     * segments starting there are retransmissions. */
+    start_seq = tcp_control->send_una;
+    send_max = tcp_control->send_una;
+
+    while ((tcp_control->send_una - start_seq) < len) {
+        /* Fill the send window, handle_tcp_ack_packet() moves it on */
+        while (tcp_control->retrans_num < TCP_RETRANS_QUEUE_SIZE) {
+            uint32_t in_flight = tcp_control->send_nxt - tcp_control->send_una;
+            uint32_t offset = tcp_control->send_nxt - start_seq;
+            uint32_t window = tcp_control->send_wnd;
+            uint32_t seq = tcp_control->send_nxt;
+            uint32_t sent_bytes;
+
+            if ((window == 0) && (in_flight == 0)) {
+                /* Probe zero window, its ACK carries the new window */
+                window = 1;
             }
-            else {
-                /* Window size <= Maximum Segment Size */
-                if ((len - total_sent_bytes) > current_tcp_socket->tcp_control.send_wnd) {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN], buf,
-                           current_tcp_socket->tcp_control.send_wnd);
-                    sent_bytes = current_tcp_socket->tcp_control.send_wnd;
-                    total_sent_bytes += sent_bytes;
-                }
-                else {
-                    memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN],
-                           (uint8_t *) buf + total_sent_bytes, len - total_sent_bytes);
-                    sent_bytes = len - total_sent_bytes;
-                    total_sent_bytes = len;
-                }
+
+            if ((offset >= len) || (in_flight >= window)) {
+                break;
             }
 
-            current_tcp_socket->tcp_control.send_nxt += sent_bytes;
-            current_tcp_socket->tcp_control.send_wnd -= sent_bytes;
+            sent_bytes = len - offset;
 
-            if (send_tcp(current_int_tcp_socket, current_tcp_packet,
-                         temp_ipv6_header, TCP_ACK, sent_bytes) < 0) {
-                /* Error while sending tcp data */
-                current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                current_tcp_socket->tcp_control.send_wnd += sent_bytes;
-#ifdef TCP_HC
-                memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                       &saved_tcp_context, sizeof(tcp_hc_context_t));
-                current_tcp_socket->tcp_control.tcp_context.hc_type =
-                    COMPRESSED_HEADER;
-#endif
-                printf("Error while sending, returning to application thread!\n");
+            if (sent_bytes > (window - in_flight)) {
+                sent_bytes = window - in_flight;
+            }
+
+            if (sent_bytes > mss) {
+                sent_bytes = mss;
+            }
+
+            if (in_flight == 0) {
+                /* Start retransmission timer */
+                timex_t now;
+                vtimer_now(&now);
+                tcp_control->last_packet_time = now;
+            }
+
+            /* account for the segment before it is sent, so its ACK can
+             * not arrive before send_nxt covers it */
+            queue_segment(tcp_control, seq, sent_bytes,
+                          TCP_SEQ_LT(seq, send_max));
+            tcp_control->send_nxt += sent_bytes;
+
+            if (TCP_SEQ_LT(send_max, tcp_control->send_nxt)) {
+                send_max = tcp_control->send_nxt;
+            }
+
+            mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+
+            memcpy(&send_buffer[IPV6_HDR_LEN + TCP_HDR_LEN],
+                   (uint8_t *) buf + offset, sent_bytes);
+
+            if (send_tcp_seq(current_int_tcp_socket, current_tcp_packet,
+                             temp_ipv6_header, seq, TCP_ACK, sent_bytes) < 0) {
+                DEBUG("tcp_send: error while sending, returning to "
+                      "application thread\n");
+                mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
+
+                /* forget the segment, the next call starts at send_una */
+                if ((tcp_control->retrans_num > 0) &&
+                    (tcp_control->send_nxt == (seq + sent_bytes))) {
+                    tcp_control->retrans_num--;
+                    tcp_control->send_nxt = seq;
+                }
+
+                mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
                 return -1;
             }
 
-            /* Remember current time */
-            vtimer_now(&current_tcp_socket->tcp_control.last_packet_time);
-            socket_base_net_msg_receive(&recv_msg);
+            mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
+        }
 
-            switch (recv_msg.type) {
-                case TCP_ACK: {
-                    if (current_tcp_socket->tcp_control.no_of_retries == 0) {
-                        calculate_rto(&current_tcp_socket->tcp_control,
-                                      current_tcp_socket->tcp_control.last_packet_time);
-                    }
+        /* Sleep until handle_tcp_ack_packet() or the TCP timer hand over an
+         * event. Both set it under tcp_send_mutex, which is released
+         * atomically with going to sleep, so no wakeup is lost. */
+        while (current_int_tcp_socket->tcp_send_event == 0) {
+            current_int_tcp_socket->tcp_send_waiting = 1;
+            mutex_unlock_and_sleep(&current_int_tcp_socket->tcp_send_mutex);
+            mutex_lock(&current_int_tcp_socket->tcp_send_mutex);
+        }
 
-                    tcp_hdr_t *tcp_header = ((tcp_hdr_t *)(recv_msg.content.ptr));
+        current_int_tcp_socket->tcp_send_waiting = 0;
+        event = current_int_tcp_socket->tcp_send_event;
+        current_int_tcp_socket->tcp_send_event = 0;
 
-                    if ((current_tcp_socket->tcp_control.send_nxt ==
-                         tcp_header->ack_nr) && (total_sent_bytes == len)) {
-                        current_tcp_socket->tcp_control.send_una = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_nxt = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_wnd = tcp_header->window;
-                        /* Got ACK for every sent byte */
-#ifdef TCP_HC
-                        current_tcp_socket->tcp_control.tcp_context.hc_type =
-                            COMPRESSED_HEADER;
-#endif
-                        return sent_bytes;
-                    }
-                    else if ((current_tcp_socket->tcp_control.send_nxt ==
-                              tcp_header->ack_nr) && (total_sent_bytes != len)) {
-                        current_tcp_socket->tcp_control.send_una = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_nxt = tcp_header->ack_nr;
-                        current_tcp_socket->tcp_control.send_wnd = tcp_header->window;
-                        /* Got ACK for every sent byte */
+        switch (event) {
+            case TCP_ACK: {
+                /* send_una and send_wnd were updated by
+                 * handle_tcp_ack_packet(), keep on sending */
 #ifdef TCP_HC
-                        current_tcp_socket->tcp_control.tcp_context.hc_type =
-                            COMPRESSED_HEADER;
+                tcp_control->tcp_context.hc_type = COMPRESSED_HEADER;
 #endif
-                        break;
-                    }
-
-                    /* else {
-                     *     TODO: If window size > MSS, ACK was valid only for
-                     *     a few segments, handle retransmit of missing
-                     *     segments
-                     *  break;
-                     * } */
-                    break;
-                }
+                break;
+            }
 
-                case TCP_RETRY: {
-                    current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                    current_tcp_socket->tcp_control.send_wnd += sent_bytes;
-                    total_sent_bytes -= sent_bytes;
+            case TCP_RETRY: {
+                /* Retransmission timeout or fast retransmit: the receiver
+                 * drops out of order segments, so go back to the first
+                 * unacknowledged byte */
+                tcp_control->send_nxt = tcp_control->send_una;
+                tcp_control->retrans_num = 0;
+                tcp_control->dup_acks = 0;
 #ifdef TCP_HC
-                    memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                           $&saved_tcp_context, sizeof(tcp_hc_context_t));
-                    current_tcp_socket->tcp_control.tcp_context.hc_type =
-                        MOSTLY_COMPRESSED_HEADER;
+                tcp_control->tcp_context.hc_type = MOSTLY_COMPRESSED_HEADER;
 #endif
-                    break;
-                }
+                break;
+            }
 
-                case TCP_TIMEOUT: {
-                    current_tcp_socket->tcp_control.send_nxt -= sent_bytes;
-                    current_tcp_socket->tcp_control.send_wnd += sent_bytes;
+            case TCP_TIMEOUT: {
+                tcp_control->send_nxt = tcp_control->send_una;
+                tcp_control->retrans_num = 0;
 #ifdef TCP_HC
-                    memcpy(&current_tcp_socket->tcp_control.tcp_context,
-                           &saved_tcp_context, sizeof(tcp_hc_context_t));
-                    current_tcp_socket->tcp_control.tcp_context.hc_type =
-                        COMPRESSED_HEADER;
+                tcp_control->tcp_context.hc_type = COMPRESSED_HEADER;
 #endif
-                    return -1;
-                }
+                mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+                return -1;
             }
         }
     }
 
-    return sent_bytes;
+    mutex_unlock(&current_int_tcp_socket->tcp_send_mutex);
+
+    return len;
 }
 
 int tcp_accept(int s, sockaddr6_t *addr, uint32_t *addrlen)
@@ -1278,12 +1416,12 @@ int tcp_connect(int socket, sockaddr6_t *addr, uint32_t addrlen)
     return 0;
 }
 
-uint8_t read_from_socket(socket_internal_t *current_int_tcp_socket,
-                         void *buf, int len)
+uint16_t read_from_socket(socket_internal_t *current_int_tcp_socket,
+                          void *buf, int len)
 {
     if (len >= current_int_tcp_socket->tcp_input_buffer_end) {
         mutex_lock(&current_int_tcp_socket->tcp_buffer_mutex);
-        uint8_t read_bytes = current_int_tcp_socket->tcp_input_buffer_end;
+        uint16_t read_bytes = current_int_tcp_socket->tcp_input_buffer_end;
         memcpy(buf, current_int_tcp_socket->tcp_input_buffer,
                current_int_tcp_socket->tcp_input_buffer_end);
         current_int_tcp_socket->tcp_input_buffer_end = 0;
@@ -1331,7 +1469,7 @@ int32_t tcp_recv(int s, void *buf, uint32_t len, int flags)
     msg_receive(&m_recv);
 
     if ((socket_base_exists_socket(s)) && (current_int_tcp_socket->tcp_input_buffer_end > 0)) {
-        uint8_t read_bytes = read_from_socket(current_int_tcp_socket, buf, len);
+        uint16_t read_bytes = read_from_socket(current_int_tcp_socket, buf, len);
         socket_base_net_msg_reply(&m_recv, &m_send, UNDEFINED);
         return read_bytes;
     }
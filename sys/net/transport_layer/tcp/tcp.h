@@ -66,7 +66,8 @@ enum tcp_codes {
     CLOSE_CONN          = 2,
     SEQ_NO_TOO_SMALL    = 3,
     ACK_NO_TOO_SMALL    = 4,
-    ACK_NO_TOO_BIG      = 5
+    ACK_NO_TOO_BIG      = 5,
+    SEQ_NO_TOO_BIG      = 6
 };
 
 #define REMOVE_RESERVED         (0xFC)
@@ -87,6 +88,10 @@ enum tcp_codes {
 
 #define TCP_STACK_SIZE          (THREAD_STACKSIZE_MAIN)
 
+/* Compares sequence numbers modulo 2^32 */
+#define TCP_SEQ_LT(a, b)        ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+#define TCP_SEQ_LEQ(a, b)       ((int32_t)((uint32_t)(a) - (uint32_t)(b)) <= 0)
+
 typedef struct __attribute__((packed)) tcp_mms_o_t {
     uint8_t     kind;
     uint8_t     len;
@@ -111,6 +116,7 @@ int tcp_listen(int s, int backlog);
 int32_t tcp_recv(int s, void *buf, uint32_t len, int flags);
 bool tcp_socket_compliancy(int s);
 int tcp_teardown(socket_internal_t *current_socket);
+void tcp_send_notify(socket_internal_t *tcp_socket, uint16_t event);
 
 #ifdef __cplusplus
 }
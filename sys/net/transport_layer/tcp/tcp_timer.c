@@ -61,7 +61,6 @@ void handle_synchro_timeout(socket_internal_t *current_socket)
 
 void handle_established(socket_internal_t *current_socket)
 {
-    msg_t send;
     double current_timeout = current_socket->socket_values.tcp_control.rto;
 
     if (current_timeout < SECOND) {
@@ -69,9 +68,10 @@ void handle_established(socket_internal_t *current_socket)
     }
 
 
-    if ((current_socket->socket_values.tcp_control.send_nxt >
-         current_socket->socket_values.tcp_control.send_una) &&
-        (thread_getstatus(current_socket->send_pid) == STATUS_RECEIVE_BLOCKED)) {
+    /* tcp_send() only waits for ACKs with data in flight */
+    if (TCP_SEQ_LT(current_socket->socket_values.tcp_control.send_una,
+                   current_socket->socket_values.tcp_control.send_nxt) &&
+        current_socket->tcp_send_waiting) {
         for (uint8_t i = 0; i < current_socket->socket_values.tcp_control.no_of_retries;
              i++) {
             current_timeout *= 2;
@@ -81,12 +81,12 @@ void handle_established(socket_internal_t *current_socket)
         vtimer_now(&now);
 
         if (current_timeout > TCP_ACK_MAX_TIMEOUT) {
-            socket_base_net_msg_send(&send, current_socket->send_pid, 0, TCP_TIMEOUT);
+            tcp_send_notify(current_socket, TCP_TIMEOUT);
         }
         else if (timex_uint64(timex_sub(now, current_socket->socket_values.tcp_control.last_packet_time)) >
                  current_timeout) {
             current_socket->socket_values.tcp_control.no_of_retries++;
-            socket_base_net_msg_send(&send, current_socket->send_pid, 0, TCP_RETRY);
+            tcp_send_notify(current_socket, TCP_RETRY);
         }
     }
 }
@@ -101,7 +101,9 @@ void check_sockets(void)
         if (tcp_socket_compliancy(i)) {
             switch (current_socket->socket_values.tcp_control.state) {
                 case TCP_ESTABLISHED: {
+                    mutex_lock(&current_socket->tcp_send_mutex);
                     handle_established(current_socket);
+                    mutex_unlock(&current_socket->tcp_send_mutex);
                     break;
                 }
 
@@ -141,7 +143,7 @@ void *tcp_general_timer(void *arg)
 {
     (void) arg;
 
-    vtimer_t tcp_vtimer;
+    vtimer_t tcp_vtimer = VTIMER_INIT;
     timex_t interval = timex_set(0, TCP_TIMER_RESOLUTION);
 
     while (1) {
@@ -129,7 +129,7 @@ int pthread_cond_timedwait(struct pthread_cond_t *cond, struct mutex_t *mutex, c
     then.microseconds = abstime->tv_nsec / 1000u;
     reltime = timex_sub(then, now);
 
-    vtimer_t timer;
+    vtimer_t timer = VTIMER_INIT;
     vtimer_set_wakeup(&timer, reltime, sched_active_pid);
     int result = pthread_cond_wait(cond, mutex);
     vtimer_remove(&timer);
@@ -16,6 +16,7 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "thread.h"
 #include "hwtimer.h"
@@ -23,6 +24,10 @@
 #include "tcb.h"
 #include "kernel_types.h"
 
+#ifdef MODULE_VTIMER
+#include "vtimer.h"
+#endif
+
 /* list of states copied from tcb.h */
 const char *state_names[] = {
     [STATUS_RUNNING] = "running",
@@ -110,4 +115,17 @@ void ps(void)
     printf("\t%5s %-21s|%13s%6s %5i (%5i)\n", "|", "SUM", "|", "|",
            overall_stacksz, overall_used);
 #endif
+
+#ifdef MODULE_VTIMER
+    vtimer_stats_t stats;
+    timex_t now;
+
+    vtimer_get_stats(&stats);
+    vtimer_now(&now);
+
+    printf("\tvtimer: %" PRIu32 " wakeups (%" PRIu32 "/min), %" PRIu32 " timers fired\n",
+           stats.wakeups,
+           (now.seconds) ? (uint32_t)(((uint64_t)stats.wakeups * 60) / now.seconds) : stats.wakeups,
+           stats.fired);
+#endif
 }
@@ -34,6 +34,14 @@
 #include "net/ng_pktbuf.h"
 #include "net/ng_netif/hdr.h"
 
+#ifdef MODULE_NG_SIXLOWPAN_FRAG
+#include "net/ng_sixlowpan/frag.h"
+#endif
+
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#endif
+
 /**
  * @brief   The maximal expected link layer address length in byte
  */
@@ -160,6 +168,37 @@ static void _print_netconf_state(ng_netconf_state_t state)
     }
 }
 
+#ifdef MODULE_NG_SIXLOWPAN_FRAG
+static void _frag_stats(void)
+{
+    ng_sixlowpan_frag_stats_t stats;
+
+    ng_sixlowpan_frag_get_stats(&stats);
+
+    printf("6LoWPAN reassembly: %" PRIu32 " complete, dropped: %" PRIu32
+           " timed out, %" PRIu32 " buffer full, %" PRIu32 " overlapping, %"
+           PRIu32 " invalid, %" PRIu32 " out of memory\n", stats.complete,
+           stats.timeout, stats.full, stats.overlap, stats.invalid, stats.nomem);
+}
+#endif
+
+#ifdef MODULE_NG_CSMA
+static void _csma_stats(kernel_pid_t dev)
+{
+    ng_csma_stats_t stats;
+
+    if (ng_csma_get_stats(dev, &stats) < 0) {
+        return;
+    }
+
+    printf("CSMA TX: %" PRIu32 " RX: %" PRIu32 " retries: %" PRIu32
+           " busy: %" PRIu32 " dropped: %" PRIu32 " queue full, %" PRIu32
+           " no channel, %" PRIu32 " no ACK, %" PRIu32 " errors\n           ",
+           stats.tx, stats.rx, stats.retries, stats.busy, stats.full,
+           stats.access_fail, stats.no_ack, stats.error);
+}
+#endif
+
 static void _netif_list(kernel_pid_t dev)
 {
     uint8_t hwaddr[MAX_ADDR_LEN];
@@ -269,6 +308,10 @@ static void _netif_list(kernel_pid_t dev)
         printf("Source address length: %" PRIu16 "\n           ", u16);
     }
 
+#ifdef MODULE_NG_CSMA
+    _csma_stats(dev);
+#endif
+
 #ifdef MODULE_NG_IPV6_NETIF
     for (int i = 0; i < NG_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (!ng_ipv6_addr_is_unspecified(&entry->addrs[i].addr)) {
@@ -708,6 +751,10 @@ int _netif_config(int argc, char **argv)
             _netif_list(ifs[i]);
         }
 
+#ifdef MODULE_NG_SIXLOWPAN_FRAG
+        _frag_stats();
+#endif
+
         return 0;
     }
     else if (_is_number(argv[1])) {
@@ -20,8 +20,10 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <inttypes.h>
 
 #include "rpl.h"
+#include "vtimer.h"
 
 static char addr_str[IPV6_MAX_ADDR_STR_LEN];
 
@@ -34,6 +36,8 @@ int _rpl_route_handler(int argc, char **argv)
     rtable = rpl_get_routing_table();
     if (rtable) {
         unsigned c = 0;
+        timex_t now;
+        vtimer_now(&now);
         puts("--------------------------------------------------------------------");
         puts("Routing table");
         printf(" %-3s  %-18s  %-18s  %s\n", "#", "target", "next hop", "lifetime");
@@ -46,7 +50,8 @@ int _rpl_route_handler(int argc, char **argv)
                                                 (&rtable[i].address)));
                 printf("%-18s  ", ipv6_addr_to_str(addr_str, IPV6_MAX_ADDR_STR_LEN,
                                                 (&rtable[i].next_hop)));
-                printf("%d\n", rtable[i].lifetime);
+                printf("%" PRIu32 "\n", (rtable[i].expires > now.seconds) ?
+                       (rtable[i].expires - now.seconds) : 0);
 
             }
         }
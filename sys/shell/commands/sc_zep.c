@@ -19,7 +19,11 @@
 
 #include "net/ng_ipv6/addr.h"
 #include "net/ng_ipv6/netif.h"
+#ifdef MODULE_NG_CSMA
+#include "net/ng_csma.h"
+#else
 #include "net/ng_nomac.h"
+#endif
 #include "net/ng_zep.h"
 #include "thread.h"
 
@@ -74,8 +78,13 @@ int _zep_init(int argc, char **argv)
         return 1;
     }
 
+#ifdef MODULE_NG_CSMA
+    if ((res = ng_csma_init(zep_stack, sizeof(zep_stack), THREAD_PRIORITY_MAIN - 3,
+                            "zep_l2", (ng_netdev_t *)&zep)) < 0) {
+#else
     if ((res = ng_nomac_init(zep_stack, sizeof(zep_stack), THREAD_PRIORITY_MAIN - 3,
                              "zep_l2", (ng_netdev_t *)&zep)) < 0) {
+#endif
         switch (res) {
             case -EOVERFLOW:
                 puts("error: too many threads running");
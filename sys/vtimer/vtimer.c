@@ -64,20 +64,29 @@ static void vtimer_callback_tick(vtimer_t *timer);
 static void vtimer_callback_msg(vtimer_t *timer);
 static void vtimer_callback_wakeup(vtimer_t *timer);
 
-static int vtimer_set(vtimer_t *timer);
+static int vtimer_set(vtimer_t *timer, uint32_t slack);
 static int set_longterm(vtimer_t *timer);
 static int set_shortterm(vtimer_t *timer);
 
 static priority_queue_t longterm_priority_queue_root = PRIORITY_QUEUE_INIT;
 static priority_queue_t shortterm_priority_queue_root = PRIORITY_QUEUE_INIT;
 
+/* values of vtimer_t::priority_queue_entry.data, the queue a timer is in */
+#define QUEUE_NONE      (0)
+#define QUEUE_SHORTTERM (1)
+#define QUEUE_LONGTERM  (2)
+
 static vtimer_t longterm_tick_timer;
 static uint32_t longterm_tick_start;
+/* number of SECONDS_PER_TICK one long-term tick spans */
+static uint32_t longterm_tick_len = 1;
 static volatile int in_callback = false;
 
 static int hwtimer_id = -1;
 static uint32_t hwtimer_next_absolute;
 
+static vtimer_stats_t stats;
+
 static inline priority_queue_node_t *timer_get_node(vtimer_t *timer)
 {
     if (!timer) {
@@ -94,15 +103,33 @@ static inline vtimer_t *node_get_timer(priority_queue_node_t *node)
     return container_of(node, vtimer_t, priority_queue_entry);
 }
 
+/* removes a timer from the queue it is in, if any */
+static void queue_remove(vtimer_t *timer)
+{
+    switch (timer->priority_queue_entry.data) {
+        case QUEUE_SHORTTERM:
+            priority_queue_remove(&shortterm_priority_queue_root, timer_get_node(timer));
+            break;
+        case QUEUE_LONGTERM:
+            priority_queue_remove(&longterm_priority_queue_root, timer_get_node(timer));
+            break;
+    }
+
+    timer->priority_queue_entry.data = QUEUE_NONE;
+}
+
+/* checks if time lies within the current long-term tick */
+static inline int in_current_tick(const timex_t *time)
+{
+    return (time->seconds - longterm_tick_timer.absolute.seconds) < longterm_tick_len * SECONDS_PER_TICK;
+}
+
 static int set_longterm(vtimer_t *timer)
 {
+    /* the timer may still be set */
+    queue_remove(timer);
     timer->priority_queue_entry.priority = timer->absolute.seconds;
-    /* *** UGLY FIX BEGINS *** */
-    /* Workaround for a bug in a so far undiscovered location which causes the
-     * vtimer to add the same timer twice, locking the system in an infinite
-     * loop inside priority_queue_add. */
-    priority_queue_remove(&longterm_priority_queue_root, timer_get_node(timer));
-    /* *** UGLY FIX ENDS *** */
+    timer->priority_queue_entry.data = QUEUE_LONGTERM;
     priority_queue_add(&longterm_priority_queue_root, timer_get_node(timer));
     return 0;
 }
@@ -136,7 +163,7 @@ static int update_shortterm(void)
     uint32_t now_ticks = hwtimer_now();
     uint32_t now = HWTIMER_TICKS_TO_US(now_ticks);
 
-    if((next -  HWTIMER_TICKS_TO_US(VTIMER_THRESHOLD) - now) > MICROSECONDS_PER_TICK ) {
+    if((uint32_t)(next -  HWTIMER_TICKS_TO_US(VTIMER_THRESHOLD) - now) > longterm_tick_len * MICROSECONDS_PER_TICK ) {
         DEBUG("truncating next (next -  HWTIMER_TICKS_TO_US(VTIMER_THRESHOLD) - now): %lu\n", (next -  HWTIMER_TICKS_TO_US(VTIMER_THRESHOLD) - now));
         next = now +  HWTIMER_TICKS_TO_US(VTIMER_BACKOFF);
     }
@@ -154,16 +181,17 @@ void vtimer_callback_tick(vtimer_t *timer)
 
     DEBUG("vtimer_callback_tick().\n");
 
-    longterm_tick_start += MICROSECONDS_PER_TICK;
-    longterm_tick_timer.absolute.seconds += SECONDS_PER_TICK;
-    longterm_tick_timer.absolute.microseconds = MICROSECONDS_PER_TICK; // Should never change, just for clarity.
+    longterm_tick_start += longterm_tick_len * MICROSECONDS_PER_TICK;
+    longterm_tick_timer.absolute.seconds += longterm_tick_len * SECONDS_PER_TICK;
+    longterm_tick_timer.absolute.microseconds = longterm_tick_len * MICROSECONDS_PER_TICK; // Should never change, just for clarity.
     set_shortterm(&longterm_tick_timer);
 
     while (longterm_priority_queue_root.first) {
         vtimer_t *timer = node_get_timer(longterm_priority_queue_root.first);
 
-        if (timer->absolute.seconds == longterm_tick_timer.absolute.seconds) {
+        if (in_current_tick(&timer->absolute)) {
             priority_queue_remove_head(&longterm_priority_queue_root);
+            timer->priority_queue_entry.data = QUEUE_NONE;
             set_shortterm(timer);
         }
         else {
@@ -194,13 +222,12 @@ static void vtimer_callback_unlock(vtimer_t *timer)
 static int set_shortterm(vtimer_t *timer)
 {
     DEBUG("set_shortterm(): Absolute: %" PRIu32 " %" PRIu32 "\n", timer->absolute.seconds, timer->absolute.microseconds);
-    timer->priority_queue_entry.priority = timer->absolute.microseconds;
-    /* *** UGLY FIX BEGINS *** */
-    /* Workaround for a bug in a so far undiscovered location which causes the
-     * vtimer to add the same timer twice, locking the system in an infinite
-     * loop inside priority_queue_add. */
-    priority_queue_remove(&shortterm_priority_queue_root, timer_get_node(timer));
-    /* *** UGLY FIX ENDS *** */
+    /* the timer may still be set */
+    queue_remove(timer);
+    timer->priority_queue_entry.priority = (timer->absolute.seconds - longterm_tick_timer.absolute.seconds)
+                                           / SECONDS_PER_TICK * MICROSECONDS_PER_TICK
+                                           + timer->absolute.microseconds;
+    timer->priority_queue_entry.data = QUEUE_SHORTTERM;
     priority_queue_add(&shortterm_priority_queue_root, timer_get_node(timer));
     return 1;
 }
@@ -212,11 +239,21 @@ void vtimer_callback(void *ptr)
 
     in_callback = true;
     hwtimer_id = -1;
+    stats.wakeups++;
 
     /* get the vtimer that fired */
-    vtimer_t *timer = node_get_timer(priority_queue_remove_head(&shortterm_priority_queue_root));
+    priority_queue_node_t *node = priority_queue_remove_head(&shortterm_priority_queue_root);
+
+    if (!node) {
+        DEBUG("vtimer_callback(): spurious call.\n");
+    }
+
+    while (node) {
+        vtimer_t *timer = node_get_timer(node);
+        uint32_t deadline = node->priority;
+
+        timer->priority_queue_entry.data = QUEUE_NONE;
 
-    if (timer) {
 #if ENABLE_DEBUG
         vtimer_print(timer);
 #endif
@@ -224,9 +261,21 @@ void vtimer_callback(void *ptr)
 
         /* shoot timer */
         timer->action(timer);
-    }
-    else {
-        DEBUG("vtimer_callback(): spurious call.\n");
+        stats.fired++;
+
+        /* the tick starts a new time base for the short-term queue */
+        if (timer == &longterm_tick_timer) {
+            break;
+        }
+
+        /* shoot all other timers with the same deadline in this wakeup, too */
+        node = shortterm_priority_queue_root.first;
+        if (node && node->priority <= deadline) {
+            priority_queue_remove_head(&shortterm_priority_queue_root);
+        }
+        else {
+            node = NULL;
+        }
     }
 
     in_callback = false;
@@ -255,13 +304,32 @@ void normalize_to_tick(timex_t *time)
     DEBUG("     Result: %" PRIu32 " %" PRIu32 "\n", time->seconds, time->microseconds);
 }
 
-static int vtimer_set(vtimer_t *timer)
+/* moves time to the point in [time, time + slack] with the most trailing zero
+ * bits, so timers with overlapping slack windows end up with the same
+ * absolute time */
+static void apply_slack(timex_t *time, uint32_t slack)
+{
+    uint64_t limit = timex_uint64(*time) + slack;
+    uint64_t diff = timex_uint64(*time) ^ limit;
+    unsigned bit = 0;
+
+    while (diff >>= 1) {
+        bit++;
+    }
+
+    *time = timex_from_uint64(limit & ~((1ULL << bit) - 1));
+}
+
+static int vtimer_set(vtimer_t *timer, uint32_t slack)
 {
     DEBUG("vtimer_set(): New timer. Offset: %" PRIu32 " %" PRIu32 "\n", timer->absolute.seconds, timer->absolute.microseconds);
 
     timex_t now;
     vtimer_now(&now);
     timer->absolute = timex_add(now, timer->absolute);
+    if (slack) {
+        apply_slack(&(timer->absolute), slack);
+    }
     normalize_to_tick(&(timer->absolute));
 
     DEBUG("vtimer_set(): Absolute: %" PRIu32 " %" PRIu32 "\n", timer->absolute.seconds, timer->absolute.microseconds);
@@ -276,7 +344,7 @@ static int vtimer_set(vtimer_t *timer)
     }
 
     unsigned state = disableIRQ();
-    if (timer->absolute.seconds != longterm_tick_timer.absolute.seconds) {
+    if (!in_current_tick(&timer->absolute)) {
         /* we're long-term */
         DEBUG("vtimer_set(): setting long_term\n");
         result = set_longterm(timer);
@@ -300,9 +368,15 @@ static int vtimer_set(vtimer_t *timer)
 
 void vtimer_now(timex_t *out)
 {
-    uint32_t us = HWTIMER_TICKS_TO_US(hwtimer_now());
+    /* time since the start of the current long-term tick */
+    uint32_t us = HWTIMER_TICKS_TO_US(hwtimer_now()) - longterm_tick_start;
     static const uint32_t us_per_s = 1000ul * 1000ul;
 
+    /* the tick's hwtimer may have fired slightly early */
+    if ((int32_t)us < 0) {
+        us = 0;
+    }
+
     out->seconds = longterm_tick_timer.absolute.seconds + us / us_per_s;
     out->microseconds = us % us_per_s;
 }
@@ -333,11 +407,23 @@ void vtimer_init(void)
 
     longterm_tick_start = 0;
 
+#ifdef MODULE_VTIMER_TICKLESS
+    /* a tick must span less than half of the hwtimer's range, so times
+     * within it can be told from times that have passed already */
+    longterm_tick_len = VTIMER_TICKLESS_SECONDS / SECONDS_PER_TICK;
+    if (longterm_tick_len > HWTIMER_OVERFLOW_MICROS() / 2 / MICROSECONDS_PER_TICK - 1) {
+        longterm_tick_len = HWTIMER_OVERFLOW_MICROS() / 2 / MICROSECONDS_PER_TICK - 1;
+    }
+    if (longterm_tick_len == 0) {
+        longterm_tick_len = 1;
+    }
+#endif
+
     longterm_tick_timer.action = vtimer_callback_tick;
     longterm_tick_timer.arg = NULL;
 
     longterm_tick_timer.absolute.seconds = 0;
-    longterm_tick_timer.absolute.microseconds = MICROSECONDS_PER_TICK;
+    longterm_tick_timer.absolute.microseconds = longterm_tick_len * MICROSECONDS_PER_TICK;
 
     DEBUG("vtimer_init(): Setting longterm tick to %" PRIu32 "\n", longterm_tick_timer.absolute.microseconds);
 
@@ -353,7 +439,15 @@ int vtimer_set_wakeup(vtimer_t *t, timex_t interval, kernel_pid_t pid)
     t->arg = NULL;
     t->absolute = interval;
     t->pid = pid;
-    return vtimer_set(t);
+    return vtimer_set(t, 0);
+}
+
+int vtimer_set_cb(vtimer_t *t, timex_t interval, void (*cb)(vtimer_t *timer), void *arg)
+{
+    t->action = cb;
+    t->arg = arg;
+    t->absolute = interval;
+    return vtimer_set(t, 0);
 }
 
 int vtimer_usleep(uint32_t usecs)
@@ -377,7 +471,7 @@ int vtimer_sleep(timex_t time)
     }
 
     int ret;
-    vtimer_t t;
+    vtimer_t t = VTIMER_INIT;
     mutex_t mutex = MUTEX_INIT;
     mutex_lock(&mutex);
 
@@ -385,7 +479,7 @@ int vtimer_sleep(timex_t time)
     t.arg = &mutex;
     t.absolute = time;
 
-    ret = vtimer_set(&t);
+    ret = vtimer_set(&t, 0);
     mutex_lock(&mutex);
     return ret;
 }
@@ -394,8 +488,7 @@ void vtimer_remove(vtimer_t *t)
 {
     unsigned irq_state = disableIRQ();
 
-    priority_queue_remove(&shortterm_priority_queue_root, timer_get_node(t));
-    priority_queue_remove(&longterm_priority_queue_root, timer_get_node(t));
+    queue_remove(t);
     update_shortterm();
 
     restoreIRQ(irq_state);
@@ -409,7 +502,27 @@ void vtimer_set_msg(vtimer_t *t, timex_t interval, kernel_pid_t pid, uint16_t ty
     t->arg = ptr;
     t->absolute = interval;
     t->pid = pid;
-    vtimer_set(t);
+    vtimer_set(t, 0);
+}
+
+void vtimer_set_msg_with_slack(vtimer_t *t, timex_t interval, timex_t slack,
+                               kernel_pid_t pid, uint16_t type, void *ptr)
+{
+    uint64_t slack_us = timex_uint64(slack);
+
+    t->action = vtimer_callback_msg;
+    t->type = type;
+    t->arg = ptr;
+    t->absolute = interval;
+    t->pid = pid;
+    vtimer_set(t, (slack_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)slack_us);
+}
+
+void vtimer_get_stats(vtimer_stats_t *out)
+{
+    unsigned state = disableIRQ();
+    *out = stats;
+    restoreIRQ(state);
 }
 
 int vtimer_msg_receive_timeout(msg_t *m, timex_t timeout) {
@@ -417,7 +530,7 @@ int vtimer_msg_receive_timeout(msg_t *m, timex_t timeout) {
     timeout_message.type = MSG_TIMER;
     timeout_message.content.ptr = (char *) &timeout_message;
 
-    vtimer_t t;
+    vtimer_t t = VTIMER_INIT;
     vtimer_set_msg(&t, timeout, sched_active_pid, MSG_TIMER, &timeout_message);
     msg_receive(m);
     if (m->type == MSG_TIMER && m->content.ptr == (char *) &timeout_message) {
@@ -21,6 +21,8 @@
 #include "wtimer.h"
 #include "irq.h"
 
+#ifndef MODULE_WTIMER_WHEEL
+
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -468,3 +470,5 @@ overflow:
     /* set low level timer */
     _lltimer_set(next);
 }
+
+#endif /* MODULE_WTIMER_WHEEL */
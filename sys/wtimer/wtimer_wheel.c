@@ -0,0 +1,413 @@
+/**
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup wtimer
+ * @{
+ * @file
+ * @brief wtimer core functionality, hierarchical timing wheel backend
+ *
+ * Timers are kept in WTIMER_WHEEL_LEVELS wheels of WTIMER_WHEEL_SLOTS slots
+ * each. A timer is put on the lowest level on which its 64bit target time
+ * differs from the wheel's current time, into the slot given by its target's
+ * bits of that level. Slots of level 0 are one tick wide, so all timers of a
+ * level 0 slot expire at the same time. When the wheel's time reaches a slot
+ * of a higher level, the slot's timers are cascaded to lower levels.
+ *
+ * Timers further in the future than the wheel's span are kept in an unsorted
+ * list that is redistributed each time the wheel completes a full turn of its
+ * highest level.
+ *
+ * The low-level timer is programmed for the next non-empty slot, but at least
+ * once per low-level timer period to keep track of the time's upper bits.
+ *
+ * @author agent <agent@local>
+ * @}
+ */
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "wtimer.h"
+#include "irq.h"
+
+#ifdef MODULE_WTIMER_WHEEL
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if (WTIMER_WHEEL_BITS < 1) || (WTIMER_WHEEL_BITS > 5)
+#error "wtimer_wheel: WTIMER_WHEEL_BITS must be between 1 and 5"
+#endif
+
+#if (WTIMER_WHEEL_LEVELS * WTIMER_WHEEL_BITS) > 32
+#error "wtimer_wheel: the wheel must not span more than 32bit"
+#endif
+
+#define _SLOT_MASK      (WTIMER_WHEEL_SLOTS - 1)
+#define _SPAN           (1ULL << (WTIMER_WHEEL_LEVELS * WTIMER_WHEEL_BITS))
+
+static uint32_t _long_cnt = 0;
+#if WTIMER_MASK
+volatile uint32_t _high_cnt = 0;
+#endif
+
+/* low-level timer value of the last call to _now64() */
+static uint32_t _last_now = 0;
+
+/* time up to which all slots have been processed */
+static uint64_t _wheel_time = 0;
+
+static wtimer_t *_wheel[WTIMER_WHEEL_LEVELS][WTIMER_WHEEL_SLOTS];
+
+/* bit n is set if slot n of a level may be non-empty */
+static uint32_t _pending[WTIMER_WHEEL_LEVELS];
+
+/* timers beyond the wheel's span */
+static wtimer_t *_far_list = NULL;
+
+static void _timer_callback(void);
+static void _periph_timer_callback(int chan);
+
+static inline uint64_t _target(const wtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    DEBUG("_lltimer_set(): setting %lu\n", _mask(target));
+    timer_set_absolute(WTIMER, WTIMER_CHAN, _mask(target));
+}
+
+static void _next_period(void)
+{
+#if WTIMER_MASK
+    /* advance <32bit mask register */
+    _high_cnt += ~WTIMER_MASK + 1;
+    if (! _high_cnt) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief returns the current 64bit time, advancing to the next low-level
+ *        timer period if the low-level timer overflowed since the last call
+ *
+ * Must be called with interrupts disabled, and at least once per low-level
+ * timer period.
+ */
+static uint64_t _now64(void)
+{
+    uint32_t now = _wtimer_now();
+
+    if (now < _last_now) {
+        _next_period();
+    }
+    _last_now = now;
+
+#if WTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _high_cnt | now;
+#else
+    return ((uint64_t)_long_cnt << 32) | now;
+#endif
+}
+
+static void _add(wtimer_t *timer)
+{
+    uint64_t target = _target(timer);
+    wtimer_t **head;
+
+    /* timers that are already due go into the current slot */
+    if (target < _wheel_time) {
+        target = _wheel_time;
+    }
+
+    if ((target ^ _wheel_time) >= _SPAN) {
+        head = &_far_list;
+    }
+    else {
+        uint32_t diff = (uint32_t)(target ^ _wheel_time);
+        unsigned level = diff ? (bitarithm_msb(diff) / WTIMER_WHEEL_BITS) : 0;
+        unsigned slot = (target >> (level * WTIMER_WHEEL_BITS)) & _SLOT_MASK;
+
+        head = &_wheel[level][slot];
+        _pending[level] |= (1UL << slot);
+    }
+
+    timer->next = *head;
+    if (*head) {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+    timer->pprev = head;
+}
+
+static void _unlink(wtimer_t *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->pprev = NULL;
+}
+
+/**
+ * @brief find the next non-empty slot
+ *
+ * @param[out] time     time the slot is due
+ * @param[out] head     the slot's list
+ *
+ * @return  the slot's level, WTIMER_WHEEL_LEVELS for the far list
+ * @return  -1 if there are no timers
+ */
+static int _next_slot(uint64_t *time, wtimer_t ***head)
+{
+    for (unsigned level = 0; level < WTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = level * WTIMER_WHEEL_BITS;
+        unsigned pos = (_wheel_time >> shift) & _SLOT_MASK;
+        uint32_t passed = (1UL << pos) - 1;
+
+        /* on higher levels, the current slot has been cascaded already */
+        if (level > 0) {
+            passed |= (1UL << pos);
+        }
+
+        /* bits of passed slots are left over by removed timers */
+        _pending[level] &= ~passed;
+
+        while (_pending[level]) {
+            unsigned slot = bitarithm_lsb(_pending[level]);
+
+            if (_wheel[level][slot]) {
+                *time = ((_wheel_time >> (shift + WTIMER_WHEEL_BITS))
+                         << (shift + WTIMER_WHEEL_BITS)) |
+                        ((uint64_t)slot << shift);
+                *head = &_wheel[level][slot];
+                return level;
+            }
+
+            _pending[level] &= ~(1UL << slot);
+        }
+    }
+
+    if (_far_list) {
+        *time = (_wheel_time | (_SPAN - 1)) + 1;
+        *head = &_far_list;
+        return WTIMER_WHEEL_LEVELS;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief expire or cascade all slots due until @p limit
+ */
+static void _process(uint64_t now, uint64_t limit)
+{
+    uint64_t time;
+    wtimer_t **head;
+    int level;
+
+    while (((level = _next_slot(&time, &head)) >= 0) && (time <= limit)) {
+        /* detach the slot, so callbacks may set and remove timers */
+        wtimer_t *list = *head;
+
+        *head = NULL;
+        list->pprev = &list;
+        _wheel_time = time;
+
+        while (list) {
+            wtimer_t *timer = list;
+
+            _unlink(timer);
+
+            if (level == 0) {
+                /* make sure we don't fire too early */
+                while (_now64() < _target(timer));
+
+                timer->callback(timer->arg);
+            }
+            else {
+                _add(timer);
+            }
+        }
+    }
+
+    if (now > _wheel_time) {
+        _wheel_time = now;
+    }
+}
+
+/**
+ * @brief set the low-level timer to the next slot, or to the end of the
+ *        current low-level timer period, whichever is first
+ */
+static void _schedule(void)
+{
+    uint64_t now = _now64();
+    uint64_t end, next;
+    wtimer_t **head;
+
+    /* the end of this period is very soon, spin until the next one */
+    if (_mask(0xFFFFFFFF) - _mask(now) < WTIMER_ISR_BACKOFF) {
+        while (_wtimer_now() >= _mask(now));
+        now = _now64();
+    }
+
+    end = now | _mask(0xFFFFFFFF);
+
+    if (_next_slot(&next, &head) < 0) {
+        next = end;
+    }
+    else {
+        if (next < now + WTIMER_OVERHEAD + WTIMER_ISR_BACKOFF) {
+            next = now + WTIMER_ISR_BACKOFF;
+        }
+        else {
+            next -= WTIMER_OVERHEAD;
+        }
+
+        if (next > end) {
+            next = end;
+        }
+    }
+
+    _lltimer_set((uint32_t)next);
+}
+
+void wtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(WTIMER, 1 /* us_per_tick */, _periph_timer_callback);
+
+    unsigned state = disableIRQ();
+    _wheel_time = _now64();
+    _schedule();
+    restoreIRQ(state);
+}
+
+uint64_t wtimer_now64(void)
+{
+    unsigned state = disableIRQ();
+    uint64_t now = _now64();
+    restoreIRQ(state);
+
+    return now;
+}
+
+static void _set64(wtimer_t *timer, uint64_t target)
+{
+    unsigned state = disableIRQ();
+
+    timer->target = (uint32_t)target;
+    timer->long_target = (uint32_t)(target >> 32);
+    _add(timer);
+    _schedule();
+
+    restoreIRQ(state);
+}
+
+void _wtimer_set64(wtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _wtimer_set64() offset=%lu long_offset=%lu\n", offset, long_offset);
+    if (! (long_offset)) {
+        /* timer fits into the short timer */
+        wtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        _set64(timer, wtimer_now64() + (((uint64_t)long_offset << 32) | offset));
+    }
+}
+
+void wtimer_set(wtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%lu now=%lu (%lu)\n", offset, wtimer_now(), _wtimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    if (offset < WTIMER_BACKOFF) {
+        /* spin until timer should be run */
+        wtimer_spin_until(_mask(wtimer_now() + offset));
+
+        timer->pprev = NULL;
+        timer->callback(timer->arg);
+    }
+    else {
+        _set64(timer, wtimer_now64() + offset);
+    }
+}
+
+int _wtimer_set_absolute(wtimer_t *timer, uint32_t target)
+{
+    uint64_t now = wtimer_now64();
+
+    DEBUG("timer_set_absolute(): now=%lu target=%lu\n", (uint32_t)now, target);
+
+    if (target >= (uint32_t)now && target - WTIMER_BACKOFF < (uint32_t)now) {
+        /* backoff */
+        wtimer_spin_until(_mask(target));
+
+        timer->pprev = NULL;
+        timer->callback(timer->arg);
+        return 0;
+    }
+
+    /* targets below now lie in the next 32bit period */
+    if (target < (uint32_t)now) {
+        now += (1ULL << 32);
+    }
+
+    _set64(timer, (now & 0xFFFFFFFF00000000ULL) | target);
+
+    return 0;
+}
+
+int wtimer_remove(wtimer_t *timer)
+{
+    unsigned state = disableIRQ();
+    int res = 0;
+
+    /* the low-level timer is left alone, if it fires for a now empty slot,
+     * _timer_callback() just reschedules */
+    if (timer->pprev) {
+        _unlink(timer);
+        res = 1;
+    }
+
+    restoreIRQ(state);
+
+    return res;
+}
+
+static void _periph_timer_callback(int chan)
+{
+    (void)chan;
+    _timer_callback();
+}
+
+/**
+ * @brief main wtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t now = _now64();
+
+    _process(now, now + WTIMER_ISR_BACKOFF);
+    _schedule();
+}
+
+#endif /* MODULE_WTIMER_WHEEL */
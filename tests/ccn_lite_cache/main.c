@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Content store hit/miss throughput of the CCN-lite relay
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "vtimer.h"
+
+#include "ccnl.h"
+#include "ccnl-core.h"
+
+#define LOOKUPS     (100000U)
+
+static const int sizes[] = { 100, 1000, 10000 };
+
+/* creates the prefix /riot/appserver/test/<tag><n> */
+static struct ccnl_prefix_s *prefix_new(char tag, int n)
+{
+    static const char *comps[] = { "riot", "appserver", "test" };
+    struct ccnl_prefix_s *p = ccnl_calloc(1, sizeof(struct ccnl_prefix_s));
+    int k, len = 0;
+
+    p->comp = ccnl_malloc(4 * sizeof(unsigned char *));
+    p->complen = ccnl_malloc(4 * sizeof(int));
+    p->path = ccnl_malloc(32);
+
+    for (k = 0; k < 3; k++) {
+        p->comp[k] = p->path + len;
+        p->complen[k] = strlen(comps[k]);
+        memcpy(p->comp[k], comps[k], p->complen[k]);
+        len += p->complen[k];
+    }
+
+    p->comp[3] = p->path + len;
+    p->complen[3] = sprintf((char *) p->comp[3], "%c%d", tag, n);
+    p->compcnt = 4;
+
+    return p;
+}
+
+static uint32_t lookup(struct ccnl_relay_s *relay, char tag, int num)
+{
+    struct ccnl_prefix_s **p = ccnl_malloc(num * sizeof(struct ccnl_prefix_s *));
+    timex_t start, stop;
+    unsigned found = 0;
+
+    for (int i = 0; i < num; i++) {
+        p[i] = prefix_new(tag, i);
+    }
+
+    vtimer_now(&start);
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        if (ccnl_content_find(relay, p[i % num], NULL, 0, CCNL_MAX_NAME_COMP)) {
+            found++;
+        }
+    }
+
+    vtimer_now(&stop);
+
+    for (int i = 0; i < num; i++) {
+        free_prefix(p[i]);
+    }
+
+    ccnl_free(p);
+
+    if (found != ((tag == 'c') ? LOOKUPS : 0)) {
+        printf("error: %u lookups succeeded\n", found);
+    }
+
+    return timex_uint64(timex_sub(stop, start));
+}
+
+static void bench(int num)
+{
+    struct ccnl_relay_s *relay = ccnl_calloc(1, sizeof(struct ccnl_relay_s));
+    uint32_t hit, miss;
+
+    relay->max_cache_entries = num;
+
+    for (int i = 0; i < num; i++) {
+        struct ccnl_prefix_s *p = prefix_new('c', i);
+        struct ccnl_buf_s *pkt = ccnl_buf_new(p->comp[3], p->complen[3]);
+        struct ccnl_content_s *c = ccnl_content_new(relay, &pkt, &p, NULL,
+                                                    NULL, 0);
+
+        if (!c || !ccnl_content_add2cache(relay, c)) {
+            printf("error: unable to cache content %d\n", i);
+            break;
+        }
+    }
+
+    hit = lookup(relay, 'c', num);
+    miss = lookup(relay, 'm', num);
+
+    printf("%5d entries: %u hits in %" PRIu32 " us, %u misses in %" PRIu32
+           " us\n", num, LOOKUPS, hit, LOOKUPS, miss);
+
+    ccnl_core_cleanup(relay);
+    ccnl_free(relay);
+}
+
+int main(void)
+{
+    puts("CCN-lite content store benchmark");
+
+    for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench(sizes[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2015 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os, signal, sys
+from pexpect import spawn, TIMEOUT, EOF
+
+
+DEFAULT_TIMEOUT = 30
+ERROR = r"error: [^\r\n]*"
+
+def main():
+    p = None
+
+    try:
+        p = spawn("make term", timeout=DEFAULT_TIMEOUT)
+        p.logfile = sys.stdout
+
+        p.expect("CCN-lite content store benchmark")
+        for entries in (100, 1000, 10000):
+            if p.expect([ERROR, r"%5d entries: \d+ hits in \d+ us, "
+                                r"\d+ misses in \d+ us" % entries]) == 0:
+                return 1
+        if p.expect([ERROR, "done"]) == 0:
+            return 1
+    except TIMEOUT as exc:
+        print(exc)
+        return 1
+    finally:
+        if p and not p.terminate():
+            os.killpg(p.pid, signal.SIGKILL)
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       CRC-16-CCITT throughput compared to a bitwise calculation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "vtimer.h"
+
+#define BUF_SIZE    (127U)      /* maximum IEEE 802.15.4 frame length */
+#define ROUNDS      (2000U)
+
+static uint8_t buf[BUF_SIZE];
+
+static uint16_t bitwise(uint16_t crc, const uint8_t *data, size_t len)
+{
+    while (len--) {
+        crc ^= *(data++);
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ CRC16_CCITT_POLY) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint16_t bench(const char *name,
+                      uint16_t (*calc)(uint16_t, const uint8_t *, size_t))
+{
+    timex_t start, stop;
+    uint64_t usec;
+    uint16_t crc = 0;
+
+    vtimer_now(&start);
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        crc = calc(crc, buf, sizeof(buf));
+    }
+
+    vtimer_now(&stop);
+
+    usec = timex_uint64(timex_sub(stop, start));
+    printf("%-8s %" PRIu32 " byte in %" PRIu32 " us: %" PRIu32 " byte/s\n",
+           name, (uint32_t)(ROUNDS * BUF_SIZE), (uint32_t)usec,
+           (usec > 0) ? (uint32_t)((ROUNDS * BUF_SIZE * 1000000ULL) / usec)
+                      : 0);
+
+    return crc;
+}
+
+int main(void)
+{
+    puts("CRC-16-CCITT benchmark");
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)((i * 131) + 7);
+    }
+
+    if (bench("bitwise", bitwise) != bench("crc16", crc16_ccitt_update)) {
+        puts("error: checksums differ");
+        return 1;
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -11,7 +11,8 @@
  * @{
  *
  * @file
- * @brief       Test msg_send_receive().
+ * @brief       Test msg_send_receive() and benchmark msg_send_bulk()/
+ *              msg_receive_bulk().
  *
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      René Kijewski <rene.kijewski@fu-berlin.de>
@@ -19,22 +20,38 @@
  * @}
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "cpu_conf.h"
 #include "thread.h"
+#include "timex.h"
+#include "vtimer.h"
 
 #define THREAD1_STACKSIZE   (THREAD_EXTRA_STACKSIZE_PRINTF)
 #define THREAD2_STACKSIZE   (THREAD_EXTRA_STACKSIZE_PRINTF)
+#define CONSUMER_STACKSIZE  (THREAD_STACKSIZE_DEFAULT)
 
 #ifndef TEST_EXECUTION_NUM
 #define TEST_EXECUTION_NUM  (10)
 #endif
 
+#ifndef BENCH_MSG_NUM
+#define BENCH_MSG_NUM       (10000U)
+#endif
+
+#define BENCH_QUEUE_SIZE    (16)
+#define BENCH_BULK_SIZE     (8)
+#define BENCH_MSG_TYPE      (0x3456)
+#define BENCH_DONE_TYPE     (0x3457)
+
 static char thread1_stack[THREAD1_STACKSIZE];
 static char thread2_stack[THREAD2_STACKSIZE];
+static char consumer_stack[CONSUMER_STACKSIZE];
 
-static kernel_pid_t thread1_pid, thread2_pid;
+static kernel_pid_t thread1_pid, thread2_pid, consumer_pid, main_pid;
+static volatile bool bulk;
 
 static void *thread1(void *args)
 {
@@ -91,11 +108,93 @@ static void *thread2(void *args)
     return NULL;
 }
 
+static void *consumer(void *args)
+{
+    (void)args;
+
+    msg_t msg_q[BENCH_QUEUE_SIZE], msgs[BENCH_BULK_SIZE], done;
+    unsigned int received = 0;
+
+    msg_init_queue(msg_q, BENCH_QUEUE_SIZE);
+    done.type = BENCH_DONE_TYPE;
+
+    while (1) {
+        int num = (bulk) ? msg_receive_bulk(msgs, BENCH_BULK_SIZE)
+                         : msg_receive(msgs);
+
+        for (int i = 0; i < num; i++) {
+            if (msgs[i].type == BENCH_DONE_TYPE) {
+                done.content.value = received;
+                received = 0;
+                msg_send(&done, main_pid);
+            }
+            else {
+                received++;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void bench(const char *name)
+{
+    msg_t msgs[BENCH_BULK_SIZE], done;
+    timex_t start, diff;
+    uint64_t us;
+
+    for (int i = 0; i < BENCH_BULK_SIZE; i++) {
+        msgs[i].type = BENCH_MSG_TYPE;
+    }
+
+    vtimer_now(&start);
+
+    for (unsigned int sent = 0; sent < BENCH_MSG_NUM;) {
+        if (bulk) {
+            unsigned int num = BENCH_MSG_NUM - sent;
+
+            num = (num > BENCH_BULK_SIZE) ? BENCH_BULK_SIZE : num;
+            sent += msg_send_bulk(msgs, num, consumer_pid);
+        }
+        else {
+            sent += msg_send(msgs, consumer_pid);
+        }
+    }
+
+    done.type = BENCH_DONE_TYPE;
+    msg_send(&done, consumer_pid);
+    msg_receive(&done);
+
+    vtimer_now(&diff);
+    diff = timex_sub(diff, start);
+    us = ((uint64_t)diff.seconds * SEC_IN_USEC) + diff.microseconds;
+
+    if (done.content.value != BENCH_MSG_NUM) {
+        printf("%s: only %" PRIu32 " of %u messages received\n", name,
+               done.content.value, BENCH_MSG_NUM);
+        return;
+    }
+
+    printf("%s: %u messages in %" PRIu32 " us (%" PRIu32 " msg/s)\n", name,
+           BENCH_MSG_NUM, (uint32_t)us,
+           (uint32_t)((us > 0) ? ((BENCH_MSG_NUM * (uint64_t)SEC_IN_USEC) / us) : 0));
+}
+
 int main(void)
 {
     thread2_pid = thread_create(thread2_stack, THREAD2_STACKSIZE, THREAD_PRIORITY_MAIN - 1,
                                 0, thread2, NULL, "thread2");
     thread1_pid = thread_create(thread1_stack, THREAD1_STACKSIZE, THREAD_PRIORITY_MAIN - 2,
                                 0, thread1, NULL, "thread1");
+
+    /* consumer runs with lower priority, so the sender fills its queue */
+    main_pid = thread_getpid();
+    consumer_pid = thread_create(consumer_stack, CONSUMER_STACKSIZE,
+                                 THREAD_PRIORITY_MAIN + 1, 0, consumer, NULL,
+                                 "consumer");
+    bulk = false;
+    bench("msg_send()/msg_receive()");
+    bulk = true;
+    bench("msg_send_bulk()/msg_receive_bulk()");
     return 0;
 }
@@ -20,6 +20,8 @@ def main():
         p.logfile = sys.stdout
 
         p.expect("Test successful.")
+        p.expect(r"msg_send\(\)/msg_receive\(\): \d+ messages in \d+ us")
+        p.expect(r"msg_send_bulk\(\)/msg_receive_bulk\(\): \d+ messages in \d+ us")
     except TIMEOUT as exc:
         print(exc)
         return 1
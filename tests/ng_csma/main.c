@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the CSMA/CA MAC layer on top of ZEP
+ *
+ * Start two instances with each other's address as ZEP_DST, enable ACKs with
+ * `ifconfig <if> autoack` and send with `txtsnd`. `ifconfig <if>` shows the
+ * CSMA statistics, e.g. the retransmissions caused by the simulated
+ * collisions.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "shell.h"
+#include "shell_commands.h"
+#include "thread.h"
+#include "net/ng_csma.h"
+#include "net/ng_ipv6/netif.h"
+#include "net/ng_netbase.h"
+#include "net/ng_pktdump.h"
+#include "net/ng_zep.h"
+
+/**
+ * @brief   Buffer size used by the shell
+ */
+#define SHELL_BUFSIZE           (64U)
+
+static ng_zep_t zep;
+static char csma_stack[THREAD_STACKSIZE_DEFAULT];
+
+int main(void)
+{
+    shell_t shell;
+    ng_netreg_entry_t dump;
+    ng_ipv6_addr_t dst;
+    kernel_pid_t iface;
+
+    puts("CSMA/CA MAC layer test");
+
+    /* initialize and register pktdump */
+    dump.pid = ng_pktdump_getpid();
+
+    if (dump.pid <= KERNEL_PID_UNDEF) {
+        puts("Error starting pktdump thread");
+        return -1;
+    }
+
+    dump.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+    ng_netreg_register(NG_NETTYPE_UNDEF, &dump);
+
+    /* start ZEP with the CSMA layer on top */
+    ng_ipv6_addr_from_str(&dst, ZEP_DST);
+
+    if (ng_zep_init(&zep, ZEP_PORT, &dst, ZEP_PORT) < 0) {
+        puts("Error starting ZEP");
+        return -1;
+    }
+
+    iface = ng_csma_init(csma_stack, sizeof(csma_stack),
+                         THREAD_PRIORITY_MAIN - 3, "zep_csma",
+                         (ng_netdev_t *)&zep);
+
+    if (iface <= KERNEL_PID_UNDEF) {
+        puts("Error starting CSMA layer");
+        return -1;
+    }
+
+    ng_ipv6_netif_init_by_dev();
+
+    printf("ZEP interface: %" PRIkernel_pid "\n", iface);
+
+    /* start the shell */
+    puts("Initialization OK, starting shell now");
+    shell_init(&shell, NULL, SHELL_BUFSIZE, getchar, putchar);
+    shell_run(&shell);
+
+    return 0;
+}
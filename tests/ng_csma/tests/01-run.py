@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2015 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os, signal, sys, time
+from pexpect import spawn, TIMEOUT, EOF
+
+
+DEFAULT_TIMEOUT = 10
+FRAMES = 20
+# with NG_ZEP_COLLISION_RATE at 10 % all frames get through at the first
+# attempt with a chance of less than 0.9^200 (about 1e-9)
+UNICAST_FRAMES = 200
+# leave time for the ACK timeouts and retransmissions of each frame
+UNICAST_INTERVAL = 0.1
+
+STATS = (r"CSMA TX: (\d+) RX: \d+ retries: (\d+) busy: \d+ "
+         r"dropped: (\d+) queue full, (\d+) no channel, (\d+) no ACK, "
+         r"(\d+) errors")
+
+def get_stats(p, iface):
+    p.sendline("ifconfig %d" % iface)
+    p.expect(STATS)
+    return dict(zip(("tx", "retries", "full", "no_channel", "no_ack",
+                     "errors"), (int(g) for g in p.match.groups())))
+
+def check_accounted(before, after, frames):
+    diff = dict((k, after[k] - before[k]) for k in after)
+    accounted = (diff["tx"] + diff["full"] + diff["no_channel"] +
+                 diff["no_ack"])
+    if diff["errors"] != 0:
+        print("error: device failed to send %d frames" % diff["errors"])
+        return None
+    if accounted != frames:
+        print("error: %d frames not accounted for" % (frames - accounted))
+        return None
+    return diff
+
+def main():
+    p = None
+
+    try:
+        p = spawn("make term", timeout=DEFAULT_TIMEOUT)
+        p.logfile = sys.stdout
+
+        p.expect("CSMA/CA MAC layer test")
+        p.expect(r"ZEP interface: (\d+)")
+        iface = int(p.match.group(1))
+        p.expect("Initialization OK, starting shell now")
+
+        # frames come back to this node through the loopback address
+        before = get_stats(p, iface)
+        for i in range(FRAMES):
+            p.sendline("txtsnd %d bcast frame%d" % (iface, i))
+
+        # wait for the backoffs to pass
+        time.sleep(1)
+        diff = check_accounted(before, get_stats(p, iface), FRAMES)
+        if diff is None:
+            return 1
+        if diff["retries"] != 0 or diff["no_ack"] != 0:
+            print("error: broadcast frames were retransmitted")
+            return 1
+
+        # unicasts to our own address are acknowledged by ourselves, so the
+        # simulated collisions must lead to retransmissions
+        p.sendline("ifconfig %d" % iface)
+        p.expect(r"HWaddr: ([0-9a-fA-F:]+)")
+        addr = p.match.group(1)
+        p.sendline("ifconfig %d autoack" % iface)
+        p.expect("success: set option")
+
+        before = get_stats(p, iface)
+        for i in range(UNICAST_FRAMES):
+            p.sendline("txtsnd %d %s frame%d" % (iface, addr, i))
+            time.sleep(UNICAST_INTERVAL)
+
+        time.sleep(1)
+        diff = check_accounted(before, get_stats(p, iface), UNICAST_FRAMES)
+        if diff is None:
+            return 1
+        if diff["retries"] == 0:
+            print("error: no unicast frame was retransmitted")
+            return 1
+    except TIMEOUT as exc:
+        print(exc)
+        return 1
+    finally:
+        if p and not p.terminate():
+            os.killpg(p.pid, signal.SIGKILL)
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
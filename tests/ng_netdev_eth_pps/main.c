@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Packets-per-second benchmark for ethernet over TAP
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kernel.h"
+#include "msg.h"
+#include "shell.h"
+#include "shell_commands.h"
+#include "thread.h"
+#include "timex.h"
+#include "vtimer.h"
+#include "net/ng_netbase.h"
+
+/**
+ * @brief   Buffer size used by the shell
+ */
+#define SHELL_BUFSIZE           (64U)
+
+/**
+ * @brief   Message queue size of the receiver thread
+ */
+#define RX_MSG_QUEUE_SIZE       (32U)
+
+static char rx_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t rx_msg_queue[RX_MSG_QUEUE_SIZE];
+
+static uint32_t rx_count;
+static timex_t rx_first, rx_last;
+
+static uint32_t _rate(uint32_t count, timex_t start, timex_t stop)
+{
+    uint64_t usec = timex_uint64(timex_sub(stop, start));
+
+    return (usec > 0) ? (uint32_t)((count * 1000000ULL) / usec) : 0;
+}
+
+static void *_rx_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(rx_msg_queue, RX_MSG_QUEUE_SIZE);
+    reply.type = NG_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case NG_NETAPI_MSG_TYPE_RCV:
+                vtimer_now(&rx_last);
+
+                if (rx_count++ == 0) {
+                    rx_first = rx_last;
+                }
+
+                ng_pktbuf_release((ng_pktsnip_t *)msg.content.ptr);
+                break;
+
+            case NG_NETAPI_MSG_TYPE_GET:
+            case NG_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* should be never reached */
+    return NULL;
+}
+
+static int cmd_flood(int argc, char **argv)
+{
+    kernel_pid_t ifs[NG_NETIF_NUMOF];
+    uint32_t count, sent = 0;
+    size_t size = 64;
+    timex_t start, stop;
+
+    if ((argc < 2) || (argc > 3)) {
+        printf("usage: %s <count> [<payload size>]\n", argv[0]);
+        return 1;
+    }
+
+    if (ng_netif_get(ifs) == 0) {
+        puts("error: no interface");
+        return 1;
+    }
+
+    count = (uint32_t)atol(argv[1]);
+
+    if (argc > 2) {
+        size = (size_t)atoi(argv[2]);
+    }
+
+    vtimer_now(&start);
+
+    while (sent < count) {
+        ng_pktsnip_t *payload, *netif;
+
+        payload = ng_pktbuf_add(NULL, NULL, size, NG_NETTYPE_UNDEF);
+
+        if (payload == NULL) {
+            puts("error: packet buffer full");
+            break;
+        }
+
+        memset(payload->data, (int)sent, size);
+        netif = ng_netif_hdr_build(NULL, 0, NULL, 0);
+
+        if (netif == NULL) {
+            puts("error: packet buffer full");
+            ng_pktbuf_release(payload);
+            break;
+        }
+
+        ((ng_netif_hdr_t *)netif->data)->flags = NG_NETIF_HDR_FLAGS_BROADCAST;
+        LL_PREPEND(payload, netif);
+
+        if (ng_netapi_send(ifs[0], payload) < 1) {
+            puts("error: unable to send");
+            ng_pktbuf_release(payload);
+            break;
+        }
+
+        sent++;
+    }
+
+    vtimer_now(&stop);
+
+    printf("sent %" PRIu32 " frames in %" PRIu32 " us: %" PRIu32 " frames/s\n",
+           sent, (uint32_t)timex_uint64(timex_sub(stop, start)),
+           _rate(sent, start, stop));
+
+    return 0;
+}
+
+static int cmd_rxstats(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        rx_count = 0;
+        puts("statistics reset");
+        return 0;
+    }
+
+    printf("received %" PRIu32 " frames: %" PRIu32 " frames/s\n", rx_count,
+           (rx_count > 1) ? _rate(rx_count - 1, rx_first, rx_last) : 0);
+
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "flood", "send <count> broadcast frames", cmd_flood },
+    { "rxstats", "print or reset receive statistics", cmd_rxstats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    shell_t shell;
+    ng_netreg_entry_t rx;
+
+    puts("ethernet packets-per-second benchmark");
+
+    rx.pid = thread_create(rx_stack, sizeof(rx_stack), THREAD_PRIORITY_MAIN - 1,
+                           CREATE_STACKTEST, _rx_thread, NULL, "rx");
+
+    if (rx.pid <= KERNEL_PID_UNDEF) {
+        puts("Error starting receiver thread");
+        return -1;
+    }
+
+    rx.demux_ctx = NG_NETREG_DEMUX_CTX_ALL;
+
+    if (ng_netreg_register(NG_NETTYPE_UNDEF, &rx) < 0) {
+        puts("Error registering receiver thread");
+        return -1;
+    }
+
+    /* start the shell */
+    shell_init(&shell, shell_commands, SHELL_BUFSIZE, getchar, putchar);
+    shell_run(&shell);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the mutex with priority inheritance
+ *
+ * @details A low priority thread holds the mutex while a high priority
+ *          thread waits for it. The low priority thread must then preempt the
+ *          (medium priority) main thread and hand the mutex directly to the
+ *          high priority thread.
+ *          Afterwards main locks two mutexes and unlocks them out of order,
+ *          it must keep the priority inherited through the one still held.
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "pi_mutex.h"
+#include "sched.h"
+#include "thread.h"
+
+#define PRIO_LOW        (THREAD_PRIORITY_MAIN + 1)
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 1)
+
+static char low_stack[THREAD_STACKSIZE_MAIN];
+static char high_stack[THREAD_STACKSIZE_MAIN];
+static char waiter_stack[THREAD_STACKSIZE_MAIN];
+
+static pi_mutex_t mutex = PI_MUTEX_INIT;
+static pi_mutex_t first = PI_MUTEX_INIT;
+static pi_mutex_t second = PI_MUTEX_INIT;
+static kernel_pid_t main_pid, low_pid, high_pid;
+static volatile int low_inherited, low_restored, high_got_mutex;
+static volatile int waiter_got_mutex;
+
+static void *low(void *arg)
+{
+    (void) arg;
+    msg_t m;
+
+    pi_mutex_lock(&mutex);
+    puts("low: locked mutex");
+
+    /* let main start the high priority thread */
+    msg_send(&m, main_pid);
+
+    /* only reached before main continues, if priority was inherited */
+    printf("low: running with priority %u\n",
+           (unsigned) sched_threads[low_pid]->priority);
+    low_inherited = (sched_threads[low_pid]->priority == PRIO_HIGH);
+
+    pi_mutex_unlock(&mutex);
+
+    low_restored = (sched_threads[low_pid]->priority == PRIO_LOW);
+    printf("low: unlocked mutex, back to priority %u\n",
+           (unsigned) sched_threads[low_pid]->priority);
+    msg_send(&m, main_pid);
+
+    return NULL;
+}
+
+static void *high(void *arg)
+{
+    (void) arg;
+
+    puts("high: locking mutex");
+    pi_mutex_lock(&mutex);
+
+    high_got_mutex = (mutex.owner == (tcb_t *) sched_threads[high_pid]);
+    puts("high: got mutex");
+
+    pi_mutex_unlock(&mutex);
+
+    return NULL;
+}
+
+static void *waiter(void *arg)
+{
+    (void) arg;
+
+    puts("waiter: locking second mutex");
+    pi_mutex_lock(&second);
+    waiter_got_mutex = 1;
+    puts("waiter: got second mutex");
+    pi_mutex_unlock(&second);
+
+    return NULL;
+}
+
+int main(void)
+{
+    int kept_priority;
+
+    msg_t m;
+
+    main_pid = thread_getpid();
+
+    low_pid = thread_create(low_stack, sizeof(low_stack), PRIO_LOW, 0, low,
+                            NULL, "low");
+    msg_receive(&m);
+
+    high_pid = thread_create(high_stack, sizeof(high_stack), PRIO_HIGH, 0,
+                             high, NULL, "high");
+
+    puts("main: continues");
+
+    /* wait for low to finish */
+    msg_receive(&m);
+
+    pi_mutex_lock(&first);
+    pi_mutex_lock(&second);
+    thread_create(waiter_stack, sizeof(waiter_stack), PRIO_HIGH, 0, waiter,
+                  NULL, "waiter");
+
+    /* the waiter still waits for the second mutex */
+    pi_mutex_unlock(&first);
+    kept_priority = (sched_threads[main_pid]->priority == PRIO_HIGH);
+    printf("main: unlocked first mutex, running with priority %u\n",
+           (unsigned) sched_threads[main_pid]->priority);
+    pi_mutex_unlock(&second);
+
+    if (low_inherited && high_got_mutex && low_restored && kept_priority &&
+        waiter_got_mutex) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+
+    return 0;
+}
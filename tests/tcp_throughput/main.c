@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief TCP throughput benchmark between two native instances
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "thread.h"
+#include "vtimer.h"
+#include "net_if.h"
+#include "posix_io.h"
+#include "shell.h"
+#include "board_uart0.h"
+#include "sixlowpan/lowpan.h"
+#include "socket_base/socket.h"
+#include "net_help.h"
+
+#define SERVER_PORT     (0xFF02)
+#define CHUNK_SIZE      (256)
+
+static char server_stack[THREAD_STACKSIZE_MAIN];
+static uint8_t buffer[CHUNK_SIZE];
+
+static void *server_thread(void *arg)
+{
+    (void) arg;
+
+    sockaddr6_t sa;
+    socklen_t salen = sizeof(sa);
+    int sock = socket_base_socket(PF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sin6_family = AF_INET;
+    sa.sin6_port = HTONS(SERVER_PORT);
+
+    if ((socket_base_bind(sock, &sa, sizeof(sa)) < 0) ||
+        (socket_base_listen(sock, 1) < 0)) {
+        puts("error: unable to listen");
+        socket_base_close(sock);
+        return NULL;
+    }
+
+    while (1) {
+        int conn = socket_base_accept(sock, &sa, &salen);
+        uint32_t total = 0;
+        int32_t res;
+
+        if (conn < 0) {
+            continue;
+        }
+
+        while ((res = socket_base_recv(conn, buffer, sizeof(buffer), 0)) > 0) {
+            total += res;
+        }
+
+        printf("received %" PRIu32 " byte\n", total);
+        socket_base_close(conn);
+    }
+
+    return NULL;
+}
+
+static int cmd_init(int argc, char **argv)
+{
+    ipv6_addr_t prefix;
+
+    if (argc != 2) {
+        printf("usage: %s <id>\n", argv[0]);
+        return 1;
+    }
+
+    net_if_set_hardware_address(0, (uint16_t)atoi(argv[1]));
+    ipv6_addr_init(&prefix, 0xabcd, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0);
+
+    if (sixlowpan_lowpan_init_adhoc_interface(0, &prefix) == 0) {
+        puts("error: unable to initialize interface");
+        return 1;
+    }
+
+    return 0;
+}
+
+static int cmd_server(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+
+    thread_create(server_stack, sizeof(server_stack), THREAD_PRIORITY_MAIN,
+                  CREATE_STACKTEST, server_thread, NULL, "tcp server");
+    printf("TCP server on port %d\n", SERVER_PORT);
+
+    return 0;
+}
+
+static int cmd_send(int argc, char **argv)
+{
+    sockaddr6_t sa;
+    uint32_t total, sent = 0;
+    timex_t start, stop;
+    uint64_t usec;
+    int sock;
+
+    if (argc != 3) {
+        printf("usage: %s <id> <bytes>\n", argv[0]);
+        return 1;
+    }
+
+    total = (uint32_t)atol(argv[2]);
+
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)i;
+    }
+
+    sock = socket_base_socket(PF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sin6_family = AF_INET;
+    sa.sin6_port = HTONS(SERVER_PORT);
+    ipv6_addr_init(&sa.sin6_addr, 0xabcd, 0x0, 0x0, 0x0, 0x0, 0x00ff, 0xfe00,
+                   (uint16_t)atoi(argv[1]));
+
+    if (socket_base_connect(sock, &sa, sizeof(sa)) < 0) {
+        puts("error: unable to connect");
+        socket_base_close(sock);
+        return 1;
+    }
+
+    vtimer_now(&start);
+
+    while (sent < total) {
+        uint32_t len = ((total - sent) > sizeof(buffer)) ? sizeof(buffer)
+                                                         : (total - sent);
+
+        if (socket_base_send(sock, buffer, len, 0) < 0) {
+            puts("error: unable to send");
+            break;
+        }
+
+        sent += len;
+    }
+
+    vtimer_now(&stop);
+    socket_base_close(sock);
+
+    usec = timex_uint64(timex_sub(stop, start));
+    printf("sent %" PRIu32 " byte in %" PRIu32 " us: %" PRIu32 " byte/s\n",
+           sent, (uint32_t)usec,
+           (usec > 0) ? (uint32_t)((sent * 1000000ULL) / usec) : 0);
+
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "init", "initialize interface with <id>", cmd_init },
+    { "server", "start TCP server", cmd_server },
+    { "send", "send <bytes> to node <id>", cmd_send },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    shell_t shell;
+
+    puts("TCP throughput benchmark");
+
+    posix_open(uart0_handler_pid, 0);
+    net_if_set_src_address_mode(0, NET_IF_TRANS_ADDR_M_SHORT);
+
+    shell_init(&shell, shell_commands, UART0_BUFSIZE, uart0_readc, uart0_putc);
+    shell_run(&shell);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Test cases for the CRC-16-CCITT implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc16_ccitt.h"
+
+/* CRC-16/KERMIT check value */
+#define TEST_CHECK_STR  "123456789"
+#define TEST_CHECK_CRC  (0x2189)
+
+static uint16_t _bitwise(const uint8_t *buf, size_t len)
+{
+    uint16_t crc = 0;
+
+    while (len--) {
+        crc ^= *(buf++);
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ CRC16_CCITT_POLY) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+static void test_checksum_crc16_ccitt_empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, crc16_ccitt_calc(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0x1234, crc16_ccitt_update(0x1234, NULL, 0));
+}
+
+static void test_checksum_crc16_ccitt_check(void)
+{
+    TEST_ASSERT_EQUAL_INT(TEST_CHECK_CRC,
+                          crc16_ccitt_calc((const uint8_t *)TEST_CHECK_STR,
+                                           strlen(TEST_CHECK_STR)));
+}
+
+static void test_checksum_crc16_ccitt_update(void)
+{
+    const uint8_t *data = (const uint8_t *)TEST_CHECK_STR;
+
+    for (size_t split = 0; split <= strlen(TEST_CHECK_STR); split++) {
+        uint16_t crc = crc16_ccitt_update(0, data, split);
+
+        crc = crc16_ccitt_update(crc, data + split,
+                                 strlen(TEST_CHECK_STR) - split);
+        TEST_ASSERT_EQUAL_INT(TEST_CHECK_CRC, crc);
+    }
+}
+
+/* every length and alignment against the plain bitwise algorithm */
+static void test_checksum_crc16_ccitt_bitwise(void)
+{
+    uint8_t buf[64];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)((i * 131) + 7);
+    }
+
+    for (unsigned offset = 0; offset < 4; offset++) {
+        for (unsigned len = 0; len <= (sizeof(buf) - offset); len++) {
+            TEST_ASSERT_EQUAL_INT(_bitwise(buf + offset, len),
+                                  crc16_ccitt_calc(buf + offset, len));
+        }
+    }
+}
+
+/* a frame followed by its FCS, least significant byte first, checks to 0 */
+static void test_checksum_crc16_ccitt_residue(void)
+{
+    uint8_t frame[] = { 0x41, 0xc8, 0x00, 0xff, 0xff, 0xff, 0xff, 0x12, 0x34,
+                        0xde, 0xad, 0xbe, 0xef, 0x00, 0x00 };
+    uint16_t fcs = crc16_ccitt_calc(frame, sizeof(frame) - 2);
+
+    frame[sizeof(frame) - 2] = (uint8_t)(fcs & 0xff);
+    frame[sizeof(frame) - 1] = (uint8_t)(fcs >> 8);
+    TEST_ASSERT_EQUAL_INT(0, crc16_ccitt_calc(frame, sizeof(frame)));
+
+    frame[3] ^= 0x01;
+    TEST_ASSERT(crc16_ccitt_calc(frame, sizeof(frame)) != 0);
+}
+
+Test *tests_checksum_crc16_ccitt_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc16_ccitt_empty),
+        new_TestFixture(test_checksum_crc16_ccitt_check),
+        new_TestFixture(test_checksum_crc16_ccitt_update),
+        new_TestFixture(test_checksum_crc16_ccitt_bitwise),
+        new_TestFixture(test_checksum_crc16_ccitt_residue),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc16_ccitt_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc16_ccitt_tests;
+}
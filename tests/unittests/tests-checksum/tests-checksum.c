@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Central test setup file for the checksum module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "tests-checksum.h"
+
+void tests_checksum(void)
+{
+    TESTS_RUN(tests_checksum_crc16_ccitt_tests());
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``checksum`` module
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef TESTS_CHECKSUM_H_
+#define TESTS_CHECKSUM_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_checksum(void);
+
+/**
+ * @brief   Generates tests for checksum/crc16_ccitt.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_checksum_crc16_ccitt_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_CHECKSUM_H_ */
+/** @} */
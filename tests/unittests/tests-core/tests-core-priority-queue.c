@@ -5,18 +5,24 @@
  * General Public License v2.1. See the file LICENSE in the top level
  * directory for more details.
  */
+#include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "embUnit.h"
 
 #include "priority_queue.h"
+#include "vtimer.h"
 
 #include "tests-core.h"
 
 #define Q_LEN (4)
+#define BENCH_LEN (1000)
 
 static priority_queue_t q = PRIORITY_QUEUE_INIT;
 static priority_queue_node_t qe[Q_LEN];
+static priority_queue_node_t bench[BENCH_LEN];
+static uint32_t seed;
 
 static void set_up(void)
 {
@@ -90,11 +96,14 @@ static void test_priority_queue_add_two_equal(void)
     TEST_ASSERT_EQUAL_INT(27088, root->first->data);
     TEST_ASSERT_EQUAL_INT(14202, root->first->priority);
 
-    TEST_ASSERT(root->first->next == elem2);
-    TEST_ASSERT_EQUAL_INT(4356, root->first->next->data);
-    TEST_ASSERT_EQUAL_INT(14202, root->first->next->priority);
+    TEST_ASSERT(priority_queue_remove_head(root) == elem1);
 
-    TEST_ASSERT_NULL(root->first->next->next);
+    TEST_ASSERT(root->first == elem2);
+    TEST_ASSERT_EQUAL_INT(4356, root->first->data);
+    TEST_ASSERT_EQUAL_INT(14202, root->first->priority);
+
+    TEST_ASSERT(priority_queue_remove_head(root) == elem2);
+    TEST_ASSERT_NULL(root->first);
 }
 
 static void test_priority_queue_add_two_distinct(void)
@@ -115,11 +124,14 @@ static void test_priority_queue_add_two_distinct(void)
     TEST_ASSERT_EQUAL_INT(43088, root->first->data);
     TEST_ASSERT_EQUAL_INT(1234, root->first->priority);
 
-    TEST_ASSERT(root->first->next == elem1);
-    TEST_ASSERT_EQUAL_INT(46421, root->first->next->data);
-    TEST_ASSERT_EQUAL_INT(4567, root->first->next->priority);
+    TEST_ASSERT(priority_queue_remove_head(root) == elem2);
 
-    TEST_ASSERT_NULL(root->first->next->next);
+    TEST_ASSERT(root->first == elem1);
+    TEST_ASSERT_EQUAL_INT(46421, root->first->data);
+    TEST_ASSERT_EQUAL_INT(4567, root->first->priority);
+
+    TEST_ASSERT(priority_queue_remove_head(root) == elem1);
+    TEST_ASSERT_NULL(root->first);
 }
 
 static void test_priority_queue_remove_one(void)
@@ -132,9 +144,98 @@ static void test_priority_queue_remove_one(void)
     priority_queue_add(root, elem3);
     priority_queue_remove(root, elem2);
 
+    TEST_ASSERT(priority_queue_remove_head(root) == elem1);
+    TEST_ASSERT(priority_queue_remove_head(root) == elem3);
+    TEST_ASSERT_NULL(priority_queue_remove_head(root));
+}
+
+static void test_priority_queue_remove_not_queued(void)
+{
+    priority_queue_t *root = &q;
+    priority_queue_node_t *elem1 = &(qe[1]), *elem2 = &(qe[2]);
+
+    priority_queue_add(root, elem1);
+    priority_queue_remove(root, elem2);
+
     TEST_ASSERT(root->first == elem1);
-    TEST_ASSERT(root->first->next == elem3);
-    TEST_ASSERT_NULL(root->first->next->next);
+
+    priority_queue_remove(root, elem1);
+    priority_queue_remove(root, elem1);
+
+    TEST_ASSERT_NULL(root->first);
+}
+
+/* priorities in a small range, so there are many nodes of equal priority */
+static void _bench_fill(priority_queue_t *root, unsigned num)
+{
+    seed = 1;
+
+    for (unsigned i = 0; i < num; i++) {
+        seed = (seed * 1103515245U) + 12345U;
+        bench[i].priority = (seed >> 8) % (num / 4 + 1);
+        bench[i].data = i;
+        priority_queue_add(root, &bench[i]);
+    }
+}
+
+/* nodes must come out by priority, and in order of adding for equal ones */
+static unsigned _bench_drain(priority_queue_t *root)
+{
+    priority_queue_node_t *node, *prev = NULL;
+    unsigned num = 0;
+
+    while ((node = priority_queue_remove_head(root)) != NULL) {
+        if (prev) {
+            TEST_ASSERT((prev->priority < node->priority) ||
+                        ((prev->priority == node->priority) &&
+                         (prev->data < node->data)));
+        }
+        prev = node;
+        num++;
+    }
+
+    return num;
+}
+
+static void test_priority_queue_remove_many(void)
+{
+    priority_queue_t *root = &q;
+
+    _bench_fill(root, BENCH_LEN);
+
+    for (unsigned i = 0; i < BENCH_LEN; i += 3) {
+        priority_queue_remove(root, &bench[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(BENCH_LEN - (BENCH_LEN + 2) / 3, _bench_drain(root));
+}
+
+static void _bench(unsigned num)
+{
+    priority_queue_t *root = &q;
+    timex_t start, added, drained;
+
+    vtimer_now(&start);
+    _bench_fill(root, num);
+    vtimer_now(&added);
+    TEST_ASSERT_EQUAL_INT(num, _bench_drain(root));
+    vtimer_now(&drained);
+
+    printf("\npriority_queue: %4u nodes: added in %" PRIu32 " us, "
+           "removed head in %" PRIu32 " us", num,
+           (uint32_t)timex_uint64(timex_sub(added, start)),
+           (uint32_t)timex_uint64(timex_sub(drained, added)));
+}
+
+/*
+ * @brief measuring adding and removing the head of 10, 100 and 1000 nodes
+ */
+static void test_priority_queue_bench(void)
+{
+    _bench(10);
+    _bench(100);
+    _bench(BENCH_LEN);
+    puts("");
 }
 
 Test *tests_core_priority_queue_tests(void)
@@ -146,6 +247,9 @@ Test *tests_core_priority_queue_tests(void)
         new_TestFixture(test_priority_queue_add_two_equal),
         new_TestFixture(test_priority_queue_add_two_distinct),
         new_TestFixture(test_priority_queue_remove_one),
+        new_TestFixture(test_priority_queue_remove_not_queued),
+        new_TestFixture(test_priority_queue_remove_many),
+        new_TestFixture(test_priority_queue_bench),
     };
 
     EMB_UNIT_TESTCALLER(core_priority_queue_tests, set_up, NULL,
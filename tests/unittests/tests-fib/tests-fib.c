@@ -7,9 +7,11 @@
 */
 
 #define TEST_FIB_SHOW_OUTPUT (0) /**< set  */
+#define TEST_FIB_BENCH_LOOKUPS (1000) /**< lookups per measured FIB size */
 
 #include <stdio.h> /**< required for snprintf() */
 #include <string.h>
+#include <inttypes.h>
 #include <errno.h>
 #include "embUnit.h"
 #include "tests-fib.h"
@@ -19,6 +21,12 @@
 #include "ng_fib.h"
 #include "ng_fib/ng_universal_address.h"
 
+#ifdef FIB_MAX_FIB_TABLE_ENTRIES
+#define TEST_FIB_MAX_ENTRIES FIB_MAX_FIB_TABLE_ENTRIES
+#else
+#define TEST_FIB_MAX_ENTRIES (20) /**< default capacity of the FIB */
+#endif
+
 /*
 * @brief helper to fill FIB with unique entries
 */
@@ -61,6 +69,18 @@ static void _fill_FIB_multiple(size_t entries, size_t modulus)
     }
 }
 
+/*
+* @brief helper to construct a unique destination for the given number
+* Unlike the "Test address" strings it works for any capacity of the FIB
+*/
+static void _unique_addr(uint8_t *addr, size_t addr_size, size_t num)
+{
+    memset(addr, 0, addr_size);
+    memcpy(addr, "FIB bench", 9);
+    addr[addr_size - 2] = (uint8_t)((num + 1) >> 8);
+    addr[addr_size - 1] = (uint8_t)(num + 1);
+}
+
 /*
 * @brief filling the FIB with entries
 * It is expected to have 20 FIB entries and 40 used universal address entries
@@ -324,26 +344,34 @@ static void test_fib_09_update_entry(void)
 
 /*
 * @brief filling the FIB with entries and adding an additional one (not fitting)
-* It is expected to have 20 FIB entries and to receive FPC_ERROR on adding an additional one
+* It is expected to have TEST_FIB_MAX_ENTRIES FIB entries and to receive
+* -ENOMEM on adding an additional one
 */
 static void test_fib_10_add_exceed(void)
 {
-    size_t add_buf_size = 16; /* includes space for terminating \0 */
-    char addr_dst[] = "Test address 98";
-    char addr_nxt[] = "Test address 99";
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    size_t entries = TEST_FIB_MAX_ENTRIES;
 
-    size_t entries = 20;
-    _fill_FIB_unique(entries);
+    for (size_t i = 0; i < entries; ++i) {
+        _unique_addr(addr_dst, add_buf_size - 1, i);
+        _unique_addr(addr_nxt, add_buf_size - 1, entries + 1 + i);
+        fib_add_entry(42, addr_dst, add_buf_size - 1, 0x77777777,
+                      addr_nxt, add_buf_size - 1, 0x77777777, 10000);
+    }
 
-    TEST_ASSERT_EQUAL_INT(20, fib_get_num_used_entries());
-    TEST_ASSERT_EQUAL_INT(40, universal_address_get_num_used_entries());
+    TEST_ASSERT_EQUAL_INT(entries, fib_get_num_used_entries());
+    TEST_ASSERT_EQUAL_INT(2 * entries, universal_address_get_num_used_entries());
 
-    int ret = fib_add_entry(42, (uint8_t *)addr_dst, add_buf_size - 1, 0x98,
-                            (uint8_t *)addr_nxt, add_buf_size - 1, 0x99, 9999);
+    _unique_addr(addr_dst, add_buf_size - 1, entries);
+    _unique_addr(addr_nxt, add_buf_size - 1, 2 * entries + 1);
+    int ret = fib_add_entry(42, addr_dst, add_buf_size - 1, 0x98,
+                            addr_nxt, add_buf_size - 1, 0x99, 9999);
 
     TEST_ASSERT_EQUAL_INT(-ENOMEM, ret);
-    TEST_ASSERT_EQUAL_INT(20, fib_get_num_used_entries());
-    TEST_ASSERT_EQUAL_INT(40, universal_address_get_num_used_entries());
+    TEST_ASSERT_EQUAL_INT(entries, fib_get_num_used_entries());
+    TEST_ASSERT_EQUAL_INT(2 * entries, universal_address_get_num_used_entries());
 
 #if (TEST_FIB_SHOW_OUTPUT == 1)
     fib_print_fib_table();
@@ -884,6 +912,112 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit();
 }
 
+/*
+* @brief helper to measure the lookup throughput with the given number of entries
+* Every second entry gets a finite lifetime, so the expiry is part of the
+* measured workload.
+* Sizes exceeding the FIB capacity are skipped, Makefile.include raises
+* FIB_MAX_FIB_TABLE_ENTRIES and UNIVERSAL_ADDRESS_MAX_ENTRIES on native to
+* measure all of them
+*/
+static void _bench_lookups(size_t size)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    timex_t start, end;
+    size_t entries = 0;
+
+    memset(addr_nxt, 0x11, add_buf_size);
+
+    for (; entries < size; ++entries) {
+        uint32_t lifetime = (entries & 1) ? 100000 : FIB_LIFETIME_NO_EXPIRE;
+        _unique_addr(addr_dst, add_buf_size - 1, entries);
+
+        if (fib_add_entry(42, addr_dst, add_buf_size - 1, 0x0,
+                          addr_nxt, add_buf_size - 1, 0x0, lifetime) != 0) {
+            break;
+        }
+    }
+
+    if (entries < size) {
+        printf("\n[fib lookup] %d entries: skipped, FIB capacity is %d\n",
+               (int)size, (int)entries);
+        fib_deinit();
+        return;
+    }
+
+    vtimer_now(&start);
+
+    for (size_t i = 0; i < TEST_FIB_BENCH_LOOKUPS; ++i) {
+        size_t nxt_size = add_buf_size;
+        _unique_addr(addr_lookup, add_buf_size - 1, i % entries);
+
+        int ret = fib_get_next_hop(&iface_id, addr_dst, &nxt_size, &next_hop_flags,
+                                   addr_lookup, add_buf_size - 1, 0x0);
+        TEST_ASSERT_EQUAL_INT(0, ret);
+    }
+
+    vtimer_now(&end);
+    timex_t duration = timex_sub(end, start);
+
+    printf("\n[fib lookup] %d entries: %d lookups in %" PRIu32 ".%06" PRIu32 " s\n",
+           (int)entries, TEST_FIB_BENCH_LOOKUPS, duration.seconds, duration.microseconds);
+
+    fib_deinit();
+}
+
+/*
+* @brief measuring the lookup throughput with 16, 128 and 512 entries,
+* half of them with a finite lifetime.
+*/
+static void test_fib_21_lookup_throughput(void)
+{
+    _bench_lookups(16);
+    _bench_lookups(128);
+    _bench_lookups(512);
+}
+
+/*
+* @brief testing the removal of expired entries
+* It is expected that only the entries with an expired lifetime are removed
+*/
+static void test_fib_22_lifetime_expiry(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[add_buf_size];
+    char addr_nxt[add_buf_size];
+    char addr_lookup[] = "Test address 02";
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    for (size_t i = 0; i < 10; ++i) {
+        snprintf(addr_dst, add_buf_size, "Test address %02d", (int)i);
+        snprintf(addr_nxt, add_buf_size, "Test address %02d", (int)(i + 10));
+        /* even entries expire after 10 ms, the odd ones after 100 s */
+        fib_add_entry(42, (uint8_t *)addr_dst, add_buf_size - 1, 0x0,
+                      (uint8_t *)addr_nxt, add_buf_size - 1, 0x0, (i & 1) ? 100000 : 10);
+    }
+
+    TEST_ASSERT_EQUAL_INT(10, fib_get_num_used_entries());
+
+    vtimer_usleep(20 * 1000);
+
+    TEST_ASSERT_EQUAL_INT(5, fib_get_num_used_entries());
+    TEST_ASSERT_EQUAL_INT(10, universal_address_get_num_used_entries());
+
+    int ret = fib_get_next_hop(&iface_id,
+                               (uint8_t *)addr_nxt, &add_buf_size, &next_hop_flags,
+                               (uint8_t *)addr_lookup, add_buf_size - 1, 0x0);
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, ret);
+
+    fib_deinit();
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init();
@@ -908,6 +1042,8 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_lookup_throughput),
+                        new_TestFixture(test_fib_22_lifetime_expiry),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
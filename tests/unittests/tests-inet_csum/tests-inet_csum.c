@@ -12,15 +12,51 @@
  * @file
  */
 #include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
 #include "net/ng_inet_csum.h"
+#include "timex.h"
+#include "vtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+#define TEST_INET_CSUM_BENCH_LEN    (1280)
+#define TEST_INET_CSUM_BENCH_RUNS   (1000)
+
+static uint8_t _buf[TEST_INET_CSUM_BENCH_LEN + sizeof(uint32_t)];
+
+/* byte-pair reference implementation of RFC 1071 */
+static uint16_t _csum_ref(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (uint16_t i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (buf[i] << 8);
+    }
+
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+
+    return csum;
+}
+
+static void _fill_buf(void)
+{
+    uint32_t x = 0x12345678;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        x = (x * 1103515245) + 12345;
+        _buf[i] = (uint8_t)(x >> 16);
+    }
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -121,6 +157,73 @@ static void test_inet_csum__odd_len(void)
     TEST_ASSERT_EQUAL_INT(0xffff, ng_inet_csum(17 + 39, data, sizeof(data)));
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    _fill_buf();
+
+    for (uint16_t off = 0; off < sizeof(uint32_t); off++) {
+        for (uint16_t len = 0; len < 70; len++) {
+            TEST_ASSERT_EQUAL_INT(_csum_ref(0x1234, &_buf[off], len),
+                                  ng_inet_csum(0x1234, &_buf[off], len));
+        }
+        TEST_ASSERT_EQUAL_INT(_csum_ref(0, &_buf[off], TEST_INET_CSUM_BENCH_LEN),
+                              ng_inet_csum(0, &_buf[off], TEST_INET_CSUM_BENCH_LEN));
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    memset(_buf, 0xff, sizeof(_buf));
+
+    for (uint16_t off = 0; off < sizeof(uint32_t); off++) {
+        TEST_ASSERT_EQUAL_INT(0xffff, ng_inet_csum(0xffff, &_buf[off],
+                                                   TEST_INET_CSUM_BENCH_LEN));
+        TEST_ASSERT_EQUAL_INT(0xff00, ng_inet_csum(0, &_buf[off], 7));
+    }
+}
+
+static void test_inet_csum__slices(void)
+{
+    uint16_t len = 101;
+    uint16_t exp;
+
+    _fill_buf();
+    exp = ng_inet_csum(0, _buf, len);
+
+    for (uint16_t split1 = 0; split1 <= len; split1 += 3) {
+        for (uint16_t split2 = split1; split2 <= len; split2 += 5) {
+            uint16_t csum;
+
+            csum = ng_inet_csum_slice(0, _buf, split1, 0);
+            csum = ng_inet_csum_slice(csum, &_buf[split1], split2 - split1,
+                                      split1);
+            csum = ng_inet_csum_slice(csum, &_buf[split2], len - split2,
+                                      split2);
+            TEST_ASSERT_EQUAL_INT(exp, csum);
+        }
+    }
+}
+
+static void test_inet_csum__benchmark(void)
+{
+    timex_t start, diff;
+    uint32_t us;
+    volatile uint16_t csum = 0;
+
+    _fill_buf();
+    vtimer_now(&start);
+
+    for (int i = 0; i < TEST_INET_CSUM_BENCH_RUNS; i++) {
+        csum = ng_inet_csum(csum, _buf, TEST_INET_CSUM_BENCH_LEN);
+    }
+
+    vtimer_now(&diff);
+    diff = timex_sub(diff, start);
+    us = (diff.seconds * SEC_IN_USEC) + diff.microseconds;
+    printf("\ninet_csum: %d x %d byte in %" PRIu32 " us\n",
+           TEST_INET_CSUM_BENCH_RUNS, TEST_INET_CSUM_BENCH_LEN, us);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -130,6 +233,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__wraps_more_than_once),
         new_TestFixture(test_inet_csum__calculate_csum),
         new_TestFixture(test_inet_csum__odd_len),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__all_ones),
+        new_TestFixture(test_inet_csum__slices),
+        new_TestFixture(test_inet_csum__benchmark),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -12,12 +12,16 @@
  * @file
  */
 #include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
 
 #include "net/ng_ipv6/addr.h"
 #include "net/ng_ipv6/nc.h"
+#include "timex.h"
+#include "vtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-ipv6_nc.h"
@@ -98,6 +102,7 @@ static void test_ipv6_nc_add__l2addr_too_long(void)
 
 static void test_ipv6_nc_add__full(void)
 {
+    ng_ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
     ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
 
     for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
@@ -106,10 +111,121 @@ static void test_ipv6_nc_add__full(void)
         addr.u16[7].u16++;
     }
 
+    /* least recently used entry is replaced */
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                        sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_nc_add__full_lru(void)
+{
+    ng_ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t second = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                            sizeof(TEST_STRING4), 0));
+        addr.u16[7].u16++;
+    }
+
+    /* using the first entry makes the second the least recently used */
+    second.u16[7].u16++;
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                        sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+}
+
+static void test_ipv6_nc_add__full_registered(void)
+{
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                            sizeof(TEST_STRING4),
+                                            NG_IPV6_NC_TYPE_REGISTERED));
+        addr.u16[7].u16++;
+    }
+
     TEST_ASSERT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
                                     sizeof(TEST_STRING4), 0));
 }
 
+static void test_ipv6_nc_add__full_router(void)
+{
+    ng_ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t second = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    /* the least recently used entry is a router */
+    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                            sizeof(TEST_STRING4),
+                                            (i == 0) ? NG_IPV6_NC_IS_ROUTER : 0));
+        addr.u16[7].u16++;
+    }
+
+    second.u16[7].u16++;
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                        sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+}
+
+static void test_ipv6_nc_add__full_stale(void)
+{
+    ng_ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t stale = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    /* only the most recently used entry is stale */
+    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                            sizeof(TEST_STRING4),
+                                            (i == (NG_IPV6_NC_SIZE - 1)) ?
+                                            NG_IPV6_NC_STATE_STALE :
+                                            NG_IPV6_NC_STATE_REACHABLE));
+        addr.u16[7].u16++;
+    }
+
+    stale.u16[7].u16 += NG_IPV6_NC_SIZE - 1;
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                        sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &stale));
+}
+
+static void test_ipv6_nc_add__full_incomplete_with_pkts(void)
+{
+    static ng_pktqueue_t node;
+    ng_ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t second = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ng_ipv6_nc_t *entry;
+
+    for (int i = 0; i < NG_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL((entry = ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr,
+                                                     TEST_STRING4,
+                                                     sizeof(TEST_STRING4),
+                                                     NG_IPV6_NC_STATE_INCOMPLETE)));
+        addr.u16[7].u16++;
+
+        /* packets wait for the resolution of the least recently used entry */
+        if (i == 0) {
+            entry->pkts = &node;
+        }
+    }
+
+    second.u16[7].u16++;
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                        sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+}
+
 static void test_ipv6_nc_add__success(void)
 {
     ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -382,6 +498,47 @@ static void test_ipv6_nc_still_reachable__success(void)
     TEST_ASSERT(ng_ipv6_nc_is_reachable(entry));
 }
 
+#define TEST_IPV6_NC_BENCH_RUNS     (10000)
+
+static void test_ipv6_nc_get__benchmark(void)
+{
+    ng_ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    int num = 0;
+
+    printf("\n");
+
+    /* lookup time for a quarter, half and completely filled cache */
+    for (int fill = (NG_IPV6_NC_SIZE + 3) / 4; num < NG_IPV6_NC_SIZE; fill *= 2) {
+        timex_t start, diff;
+        uint32_t us;
+
+        /* always end with a full cache, even if its size is no power of two */
+        if (fill > NG_IPV6_NC_SIZE) {
+            fill = NG_IPV6_NC_SIZE;
+        }
+
+        for (; num < fill; num++) {
+            addr.u32[3].u32 = num;
+            TEST_ASSERT_NOT_NULL(ng_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr,
+                                                TEST_STRING4, sizeof(TEST_STRING4),
+                                                0));
+        }
+
+        vtimer_now(&start);
+
+        for (int i = 0; i < TEST_IPV6_NC_BENCH_RUNS; i++) {
+            addr.u32[3].u32 = i % num;
+            TEST_ASSERT_NOT_NULL(ng_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+        }
+
+        vtimer_now(&diff);
+        diff = timex_sub(diff, start);
+        us = (diff.seconds * SEC_IN_USEC) + diff.microseconds;
+        printf("ipv6_nc: %d lookups in %d entries: %" PRIu32 " us\n",
+               TEST_IPV6_NC_BENCH_RUNS, num, us);
+    }
+}
+
 Test *tests_ipv6_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -391,6 +548,11 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+        new_TestFixture(test_ipv6_nc_add__full_lru),
+        new_TestFixture(test_ipv6_nc_add__full_registered),
+        new_TestFixture(test_ipv6_nc_add__full_router),
+        new_TestFixture(test_ipv6_nc_add__full_stale),
+        new_TestFixture(test_ipv6_nc_add__full_incomplete_with_pkts),
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -413,6 +575,7 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_is_reachable__reachable),
         new_TestFixture(test_ipv6_nc_still_reachable__incomplete),
         new_TestFixture(test_ipv6_nc_still_reachable__success),
+        new_TestFixture(test_ipv6_nc_get__benchmark),
     };
 
     EMB_UNIT_TESTCALLER(ipv6_nc_tests, set_up, NULL, fixtures);
@@ -139,6 +139,57 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(ng_netreg_getnext(res));
 }
 
+void test_netreg_register__full(void)
+{
+    ng_netreg_entry_t full[NG_NETREG_SIZE + 1];
+
+    for (int i = 0; i < NG_NETREG_SIZE; i++) {
+        full[i].demux_ctx = TEST_UINT16 + i;
+        full[i].pid = TEST_UINT8;
+        TEST_ASSERT_EQUAL_INT(0, ng_netreg_register(NG_NETTYPE_TEST, &full[i]));
+    }
+
+    full[NG_NETREG_SIZE].demux_ctx = TEST_UINT16 + NG_NETREG_SIZE;
+    full[NG_NETREG_SIZE].pid = TEST_UINT8;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, ng_netreg_register(NG_NETTYPE_TEST,
+                                                      &full[NG_NETREG_SIZE]));
+    /* entries with an already registered demux context still fit */
+    full[NG_NETREG_SIZE].demux_ctx = TEST_UINT16;
+    TEST_ASSERT_EQUAL_INT(0, ng_netreg_register(NG_NETTYPE_TEST, &full[NG_NETREG_SIZE]));
+    TEST_ASSERT_EQUAL_INT(2, ng_netreg_num(NG_NETTYPE_TEST, TEST_UINT16));
+}
+
+void test_netreg_unregister__many_demux_ctx(void)
+{
+    ng_netreg_entry_t many[NG_NETREG_SIZE];
+
+    for (int i = 0; i < NG_NETREG_SIZE; i++) {
+        many[i].demux_ctx = TEST_UINT16 + i;
+        many[i].pid = TEST_UINT8 + i;
+        TEST_ASSERT_EQUAL_INT(0, ng_netreg_register(NG_NETTYPE_TEST, &many[i]));
+    }
+
+    /* remove every second entry, the others must still be found */
+    for (int i = 0; i < NG_NETREG_SIZE; i += 2) {
+        ng_netreg_unregister(NG_NETTYPE_TEST, &many[i]);
+    }
+
+    for (int i = 0; i < NG_NETREG_SIZE; i++) {
+        ng_netreg_entry_t *res = ng_netreg_lookup(NG_NETTYPE_TEST, TEST_UINT16 + i);
+
+        if (i & 1) {
+            TEST_ASSERT_NOT_NULL(res);
+            TEST_ASSERT_EQUAL_INT(TEST_UINT8 + i, res->pid);
+            TEST_ASSERT_EQUAL_INT(1, ng_netreg_num(NG_NETTYPE_TEST, TEST_UINT16 + i));
+            TEST_ASSERT_NULL(ng_netreg_getnext(res));
+        }
+        else {
+            TEST_ASSERT_NULL(res);
+            TEST_ASSERT_EQUAL_INT(0, ng_netreg_num(NG_NETTYPE_TEST, TEST_UINT16 + i));
+        }
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +206,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_register__full),
+        new_TestFixture(test_netreg_unregister__many_demux_ctx),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -13,6 +13,8 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -292,6 +294,61 @@ static void test_pktbuf_add__unaligned_in_aligned_hole(void)
     TEST_ASSERT(ng_pktbuf_is_empty());
 }
 
+static void test_pktbuf_add_headroom__in_place(void)
+{
+    ng_pktsnip_t *payload, *hdr1, *hdr2, *hdr3;
+
+    payload = ng_pktbuf_add_headroom(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                                     16, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(payload);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, payload->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING8), payload->size);
+
+    hdr1 = ng_pktbuf_add(payload, NULL, 8, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(hdr1);
+    TEST_ASSERT(hdr1->next == payload);
+    TEST_ASSERT(((uint8_t *)hdr1->data) + 8 == payload->data);
+    TEST_ASSERT_EQUAL_INT(8, hdr1->size);
+
+    hdr2 = ng_pktbuf_add(hdr1, TEST_STRING8, 8, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(hdr2->next == hdr1);
+    TEST_ASSERT(((uint8_t *)hdr2->data) + 8 == hdr1->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING8, hdr2->data, 8));
+
+    /* headroom is used up */
+    hdr3 = ng_pktbuf_add(hdr2, NULL, 4, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(hdr3);
+    TEST_ASSERT(hdr3->next == hdr2);
+    TEST_ASSERT(((uint8_t *)hdr3->data) + 4 != hdr2->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, payload->data);
+
+    ng_pktbuf_release(hdr3);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_headroom__too_small(void)
+{
+    ng_pktsnip_t *payload, *hdr;
+
+    payload = ng_pktbuf_add_headroom(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                                     4, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(payload);
+
+    hdr = ng_pktbuf_add(payload, NULL, 8, NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(((uint8_t *)hdr->data) + 8 != payload->data);
+
+    ng_pktbuf_release(hdr);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
 static void test_pktbuf_realloc_data__pkt_NULL(void)
 {
     TEST_ASSERT_EQUAL_INT(ENOENT, ng_pktbuf_realloc_data(NULL, 0));
@@ -615,6 +672,138 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(ng_pktbuf_is_empty());
 }
 
+static void test_pktbuf_start_write__shared(void)
+{
+    ng_pktsnip_t *pkt_copy, *pkt = ng_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   NG_NETTYPE_UNDEF);
+    void *data;
+
+    ng_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((pkt_copy = ng_pktbuf_start_mark(pkt)));
+    TEST_ASSERT(pkt->data == pkt_copy->data);
+    TEST_ASSERT(pkt == ng_pktbuf_start_write(pkt));
+    TEST_ASSERT(pkt->data != pkt_copy->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt_copy->data);
+    /* pkt_copy is the only user of the data left, so it is not copied again */
+    data = pkt_copy->data;
+    TEST_ASSERT(pkt_copy == ng_pktbuf_start_write(pkt_copy));
+    TEST_ASSERT(data == pkt_copy->data);
+
+    ng_pktbuf_release(pkt_copy);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_mark__NULL(void)
+{
+    TEST_ASSERT_NULL(ng_pktbuf_start_mark(NULL));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_mark__pkt_users_1(void)
+{
+    ng_pktsnip_t *pkt = ng_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                      NG_NETTYPE_UNDEF);
+
+    TEST_ASSERT(pkt == ng_pktbuf_start_mark(pkt));
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_mark__pkt_users_2(void)
+{
+    ng_pktsnip_t *pkt_copy, *hdr, *pkt = ng_pktbuf_add(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       NG_NETTYPE_UNDEF);
+    void *data = pkt->data;
+
+    ng_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((pkt_copy = ng_pktbuf_start_mark(pkt)));
+    TEST_ASSERT(pkt != pkt_copy);
+    TEST_ASSERT(pkt->data == pkt_copy->data);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->users);
+
+    /* marking a header in the copy does not change the original */
+    TEST_ASSERT_NOT_NULL((hdr = ng_pktbuf_add(pkt_copy, pkt_copy->data, 4,
+                                              NG_NETTYPE_UNDEF)));
+    TEST_ASSERT(data == hdr->data);
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16), pkt->size);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16) - 4, pkt_copy->size);
+
+    TEST_ASSERT(pkt_copy->next == hdr);
+
+    ng_pktbuf_release(pkt_copy);
+    TEST_ASSERT(!ng_pktbuf_is_empty());
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+#define TEST_PKTBUF_FANOUT_NUMOF    (8)
+#define TEST_PKTBUF_FANOUT_SIZE     (64)
+
+/* delivers a packet to TEST_PKTBUF_FANOUT_NUMOF receivers which all mark an
+ * 8 byte header and returns the number of bytes copied for it */
+static size_t _fan_out(ng_pktsnip_t *(*start)(ng_pktsnip_t *))
+{
+    ng_pktsnip_t *pkts[TEST_PKTBUF_FANOUT_NUMOF];
+    ng_pktsnip_t *pkt = ng_pktbuf_add(NULL, NULL, TEST_PKTBUF_FANOUT_SIZE,
+                                      NG_NETTYPE_UNDEF);
+    void *data;
+    size_t copied = 0;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    ng_pktbuf_hold(pkt, TEST_PKTBUF_FANOUT_NUMOF - 1);
+
+    for (int i = 0; i < TEST_PKTBUF_FANOUT_NUMOF; i++) {
+        pkts[i] = start(pkt);
+
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+
+        if (pkts[i]->data != data) {
+            copied += pkts[i]->size;
+        }
+
+        TEST_ASSERT_NOT_NULL(ng_pktbuf_add(pkts[i], pkts[i]->data, 8,
+                                           NG_NETTYPE_UNDEF));
+    }
+
+#ifdef DEVELHELP
+    ng_pktbuf_stats();
+#endif
+
+    for (int i = 0; i < TEST_PKTBUF_FANOUT_NUMOF; i++) {
+        ng_pktbuf_release(pkts[i]);
+    }
+
+    TEST_ASSERT(ng_pktbuf_is_empty());
+
+    return copied;
+}
+
+static void test_pktbuf__fan_out_benchmark(void)
+{
+    size_t copied;
+
+    printf("\npktbuf: fan-out 1 -> %d with ng_pktbuf_start_write():\n",
+           TEST_PKTBUF_FANOUT_NUMOF);
+    copied = _fan_out(ng_pktbuf_start_write);
+    printf("pktbuf: %u byte copied\n", (unsigned)copied);
+    TEST_ASSERT_EQUAL_INT((TEST_PKTBUF_FANOUT_NUMOF - 1) * TEST_PKTBUF_FANOUT_SIZE,
+                          copied);
+
+    ng_pktbuf_reset();
+    printf("pktbuf: fan-out 1 -> %d with ng_pktbuf_start_mark():\n",
+           TEST_PKTBUF_FANOUT_NUMOF);
+    copied = _fan_out(ng_pktbuf_start_mark);
+    printf("pktbuf: %u byte copied\n", (unsigned)copied);
+    TEST_ASSERT_EQUAL_INT(0, copied);
+}
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -635,6 +824,8 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__success),
         new_TestFixture(test_pktbuf_add__packed_struct),
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
+        new_TestFixture(test_pktbuf_add_headroom__in_place),
+        new_TestFixture(test_pktbuf_add_headroom__too_small),
         new_TestFixture(test_pktbuf_realloc_data__pkt_NULL),
         new_TestFixture(test_pktbuf_realloc_data__pkt_wrong),
         new_TestFixture(test_pktbuf_realloc_data__pkt_data_wrong),
@@ -662,6 +853,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
+        new_TestFixture(test_pktbuf_start_write__shared),
+        new_TestFixture(test_pktbuf_start_mark__NULL),
+        new_TestFixture(test_pktbuf_start_mark__pkt_users_1),
+        new_TestFixture(test_pktbuf_start_mark__pkt_users_2),
+        new_TestFixture(test_pktbuf__fan_out_benchmark),
     };
 
     EMB_UNIT_TESTCALLER(ng_pktbuf_tests, NULL, tear_down, fixtures);
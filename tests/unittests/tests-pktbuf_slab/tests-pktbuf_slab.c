@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ng_nettype.h"
+#include "net/ng_pkt.h"
+#include "net/ng_pktbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-pktbuf_slab.h"
+
+#ifdef MODULE_NG_PKTBUF_SLAB
+static void tear_down(void)
+{
+    ng_pktbuf_reset();
+}
+
+static void test_pktbuf_slab_add__success(void)
+{
+    ng_pktsnip_t *small, *large;
+
+    small = ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_SMALL_SIZE,
+                          NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(small);
+    large = ng_pktbuf_add(small, NULL, NG_PKTBUF_SLAB_LARGE_SIZE,
+                          NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(large);
+
+    TEST_ASSERT(large->next == small);
+    TEST_ASSERT_NOT_NULL(small->data);
+    TEST_ASSERT_NOT_NULL(large->data);
+    TEST_ASSERT_EQUAL_INT(NG_PKTBUF_SLAB_SMALL_SIZE, small->size);
+    TEST_ASSERT_EQUAL_INT(NG_PKTBUF_SLAB_LARGE_SIZE, large->size);
+
+    ng_pktbuf_release(large);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__too_big(void)
+{
+    TEST_ASSERT_NULL(ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                   NG_NETTYPE_UNDEF));
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__memfull(void)
+{
+    for (int i = 0; i < NG_PKTBUF_SLAB_LARGE_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_LARGE_SIZE,
+                                           NG_NETTYPE_UNDEF));
+    }
+
+    TEST_ASSERT_NULL(ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_LARGE_SIZE,
+                                   NG_NETTYPE_UNDEF));
+}
+
+static void test_pktbuf_slab_add__fallback(void)
+{
+    ng_pktsnip_t *pkt;
+    void *exp_data;
+
+    for (int i = 0; i < NG_PKTBUF_SLAB_SMALL_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_SMALL_SIZE,
+                                           NG_NETTYPE_UNDEF));
+    }
+
+    /* small chunks are exhausted => next bigger size class is used */
+    pkt = ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_SMALL_SIZE, NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    exp_data = pkt->data;
+
+    /* freed chunk is reused first */
+    ng_pktbuf_release(pkt);
+    pkt = ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_LARGE_SIZE, NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(exp_data == pkt->data);
+}
+
+static void test_pktbuf_slab_realloc_data__grow(void)
+{
+    ng_pktsnip_t *pkt;
+    void *old_data;
+
+    pkt = ng_pktbuf_add(NULL, NULL, NG_PKTBUF_SLAB_SMALL_SIZE, NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    memcpy(pkt->data, TEST_STRING16, sizeof(TEST_STRING16));
+    old_data = pkt->data;
+
+    /* does not fit into the small chunk => moved to a large one */
+    TEST_ASSERT_EQUAL_INT(0, ng_pktbuf_realloc_data(pkt, NG_PKTBUF_SLAB_LARGE_SIZE));
+    TEST_ASSERT(old_data != pkt->data);
+    TEST_ASSERT_EQUAL_INT(NG_PKTBUF_SLAB_LARGE_SIZE, pkt->size);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_start_write__users_2(void)
+{
+    ng_pktsnip_t *pkt, *copy;
+
+    pkt = ng_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                        NG_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    ng_pktbuf_hold(pkt, 1);
+
+    copy = ng_pktbuf_start_write(pkt);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT(copy != pkt);
+    TEST_ASSERT(copy->data != pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, copy->data);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+
+    ng_pktbuf_release(copy);
+    ng_pktbuf_release(pkt);
+    TEST_ASSERT(ng_pktbuf_is_empty());
+}
+
+Test *tests_pktbuf_slab_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_add__success),
+        new_TestFixture(test_pktbuf_slab_add__too_big),
+        new_TestFixture(test_pktbuf_slab_add__memfull),
+        new_TestFixture(test_pktbuf_slab_add__fallback),
+        new_TestFixture(test_pktbuf_slab_realloc_data__grow),
+        new_TestFixture(test_pktbuf_slab_start_write__users_2),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, NULL, tear_down, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+#endif
+
+void tests_pktbuf_slab(void)
+{
+#ifdef MODULE_NG_PKTBUF_SLAB
+    TESTS_RUN(tests_pktbuf_slab_tests());
+#else
+    puts("pktbuf_slab: skipped, build this suite on its own to use the slab "
+         "backend");
+#endif
+}
+/** @} */
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/ng_netapi.h"
+#include "net/ng_netif/hdr.h"
+#include "net/ng_pktbuf.h"
+#include "net/ng_sixlowpan.h"
+#include "net/ng_sixlowpan/frag.h"
+
+#include "tests-sixlowpan_frag.h"
+
+#define TEST_MSG_QUEUE_SIZE (8U)
+#define TEST_DG_SIZE        (16U)
+#define TEST_FRAG_SIZE      (8U)
+
+static const uint8_t test_src[] = { 0x01, 0x02 };
+static const uint8_t test_dst[] = { 0x03, 0x04 };
+
+static msg_t test_msg_queue[TEST_MSG_QUEUE_SIZE];
+static uint8_t test_dg[TEST_DG_SIZE];
+static ng_sixlowpan_frag_stats_t stats;
+
+static void set_up(void)
+{
+    /* completed datagrams are sent to the calling thread */
+    msg_init_queue(test_msg_queue, TEST_MSG_QUEUE_SIZE);
+
+    for (unsigned i = 0; i < TEST_DG_SIZE; i++) {
+        test_dg[i] = (uint8_t)(0x80 + i);
+    }
+
+    ng_sixlowpan_frag_get_stats(&stats);
+}
+
+/* hands a fragment with the given header and payload to the reassembly */
+static void _handle_frag(uint8_t disp, uint16_t tag, uint8_t offset,
+                         const uint8_t *data, size_t data_len)
+{
+    ng_pktsnip_t *netif, *frag;
+    size_t hdr_len = (disp == NG_SIXLOWPAN_FRAG_1_DISP) ?
+                     sizeof(ng_sixlowpan_frag_t) : sizeof(ng_sixlowpan_frag_n_t);
+    uint8_t *hdr;
+
+    netif = ng_netif_hdr_build((uint8_t *)test_src, sizeof(test_src),
+                               (uint8_t *)test_dst, sizeof(test_dst));
+    TEST_ASSERT_NOT_NULL(netif);
+    ((ng_netif_hdr_t *)netif->data)->if_pid = thread_getpid();
+
+    frag = ng_pktbuf_add(netif, NULL, hdr_len + data_len, NG_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(frag);
+
+    hdr = frag->data;
+    hdr[0] = disp | (uint8_t)(TEST_DG_SIZE >> 8);
+    hdr[1] = (uint8_t)TEST_DG_SIZE;
+    hdr[2] = (uint8_t)(tag >> 8);
+    hdr[3] = (uint8_t)tag;
+
+    if (disp == NG_SIXLOWPAN_FRAG_N_DISP) {
+        hdr[4] = offset;
+    }
+
+    if (data_len > 0) {
+        memcpy(hdr + hdr_len, data, data_len);
+    }
+
+    ng_sixlowpan_frag_handle_pkt(frag);
+}
+
+/* gets a completed datagram from the message queue */
+static ng_pktsnip_t *_receive(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == NG_NETAPI_MSG_TYPE_RCV) {
+            return (ng_pktsnip_t *)msg.content.ptr;
+        }
+    }
+
+    return NULL;
+}
+
+static void _assert_complete(void)
+{
+    ng_sixlowpan_frag_stats_t now;
+    ng_pktsnip_t *pkt = _receive();
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(TEST_DG_SIZE, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(test_dg, pkt->data, TEST_DG_SIZE));
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(NG_NETTYPE_NETIF, pkt->next->type);
+    ng_pktbuf_release(pkt);
+
+    ng_sixlowpan_frag_get_stats(&now);
+    TEST_ASSERT_EQUAL_INT(stats.complete + 1, now.complete);
+    TEST_ASSERT_EQUAL_INT(stats.overlap, now.overlap);
+    TEST_ASSERT_EQUAL_INT(stats.invalid, now.invalid);
+}
+
+/* fragments without any payload must not touch the reassembly state */
+static void _assert_ignored(uint16_t tag)
+{
+    ng_sixlowpan_frag_stats_t now;
+
+    TEST_ASSERT_NULL(_receive());
+    ng_sixlowpan_frag_get_stats(&now);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&stats, &now, sizeof(now)));
+
+    /* the datagram is still reassembled afterwards */
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, tag, 0, test_dg, TEST_FRAG_SIZE);
+    _handle_frag(NG_SIXLOWPAN_FRAG_N_DISP, tag, TEST_FRAG_SIZE / 8,
+                 test_dg + TEST_FRAG_SIZE, TEST_DG_SIZE - TEST_FRAG_SIZE);
+    _assert_complete();
+}
+
+static void test_sixlowpan_frag_complete(void)
+{
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 1, 0, test_dg, TEST_FRAG_SIZE);
+    TEST_ASSERT_NULL(_receive());
+    _handle_frag(NG_SIXLOWPAN_FRAG_N_DISP, 1, TEST_FRAG_SIZE / 8,
+                 test_dg + TEST_FRAG_SIZE, TEST_DG_SIZE - TEST_FRAG_SIZE);
+    _assert_complete();
+}
+
+static void test_sixlowpan_frag_complete__reversed(void)
+{
+    _handle_frag(NG_SIXLOWPAN_FRAG_N_DISP, 2, TEST_FRAG_SIZE / 8,
+                 test_dg + TEST_FRAG_SIZE, TEST_DG_SIZE - TEST_FRAG_SIZE);
+    TEST_ASSERT_NULL(_receive());
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 2, 0, test_dg, TEST_FRAG_SIZE);
+    _assert_complete();
+}
+
+static void test_sixlowpan_frag_empty_frag1(void)
+{
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 3, 0, NULL, 0);
+    _assert_ignored(3);
+}
+
+static void test_sixlowpan_frag_dispatch_only_frag1(void)
+{
+    const uint8_t disp = NG_SIXLOWPAN_UNCOMPRESSED;
+
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 4, 0, &disp, sizeof(disp));
+    _assert_ignored(4);
+}
+
+static void test_sixlowpan_frag_empty_fragn(void)
+{
+    _handle_frag(NG_SIXLOWPAN_FRAG_N_DISP, 5, TEST_FRAG_SIZE / 8, NULL, 0);
+    _assert_ignored(5);
+}
+
+static void test_sixlowpan_frag_overlap(void)
+{
+    ng_sixlowpan_frag_stats_t now;
+
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 6, 0, test_dg, TEST_FRAG_SIZE);
+    _handle_frag(NG_SIXLOWPAN_FRAG_1_DISP, 6, 0, test_dg, TEST_FRAG_SIZE);
+    TEST_ASSERT_NULL(_receive());
+
+    ng_sixlowpan_frag_get_stats(&now);
+    TEST_ASSERT_EQUAL_INT(stats.overlap + 1, now.overlap);
+    TEST_ASSERT_EQUAL_INT(stats.complete, now.complete);
+}
+
+static void test_sixlowpan_frag_too_big(void)
+{
+    ng_sixlowpan_frag_stats_t now;
+
+    _handle_frag(NG_SIXLOWPAN_FRAG_N_DISP, 7, TEST_DG_SIZE / 8,
+                 test_dg, TEST_FRAG_SIZE);
+    TEST_ASSERT_NULL(_receive());
+
+    ng_sixlowpan_frag_get_stats(&now);
+    TEST_ASSERT_EQUAL_INT(stats.invalid + 1, now.invalid);
+}
+
+Test *tests_sixlowpan_frag_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_frag_complete),
+        new_TestFixture(test_sixlowpan_frag_complete__reversed),
+        new_TestFixture(test_sixlowpan_frag_empty_frag1),
+        new_TestFixture(test_sixlowpan_frag_dispatch_only_frag1),
+        new_TestFixture(test_sixlowpan_frag_empty_fragn),
+        new_TestFixture(test_sixlowpan_frag_overlap),
+        new_TestFixture(test_sixlowpan_frag_too_big),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_frag_tests, set_up, NULL, fixtures);
+
+    return (Test *)&sixlowpan_frag_tests;
+}
+
+void tests_sixlowpan_frag(void)
+{
+    TESTS_RUN(tests_sixlowpan_frag_tests());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``sixlowpan_frag`` module
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef TESTS_SIXLOWPAN_FRAG_H_
+#define TESTS_SIXLOWPAN_FRAG_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_sixlowpan_frag(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SIXLOWPAN_FRAG_H_ */
+/** @} */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "net/ng_slip/codec.h"
+
+#include "tests-slip_codec.h"
+
+#define TEST_FRAMES     (16U)
+#define TEST_FRAME_LEN  (200U)
+
+static const uint8_t test_plain[] = { 0x01, NG_SLIP_END, 0x02, NG_SLIP_ESC,
+                                      0x03 };
+static const uint8_t test_encoded[] = { 0x01, NG_SLIP_ESC, NG_SLIP_END_ESC,
+                                        0x02, NG_SLIP_ESC, NG_SLIP_ESC_ESC,
+                                        0x03 };
+
+static void test_slip_codec_encode(void)
+{
+    uint8_t out[sizeof(test_encoded) + 4];
+    size_t len = sizeof(test_plain);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(test_encoded),
+                          ng_slip_encode(out, sizeof(out), test_plain, &len));
+    TEST_ASSERT_EQUAL_INT(sizeof(test_plain), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(test_encoded, out, sizeof(test_encoded)));
+}
+
+/* escape sequences are never split at the end of the output buffer */
+static void test_slip_codec_encode_short_out(void)
+{
+    uint8_t out[sizeof(test_encoded)];
+    size_t len = sizeof(test_plain);
+
+    TEST_ASSERT_EQUAL_INT(1, ng_slip_encode(out, 2, test_plain, &len));
+    TEST_ASSERT_EQUAL_INT(1, len);
+
+    len = sizeof(test_plain);
+    TEST_ASSERT_EQUAL_INT(3, ng_slip_encode(out, 3, test_plain, &len));
+    TEST_ASSERT_EQUAL_INT(2, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(test_encoded, out, 3));
+}
+
+static void test_slip_codec_decode(void)
+{
+    uint8_t in[sizeof(test_encoded) + 2];
+    uint8_t out[sizeof(test_plain)];
+    ng_slip_decoder_t dec;
+    size_t len = sizeof(in);
+
+    memcpy(in, test_encoded, sizeof(test_encoded));
+    in[sizeof(test_encoded)] = NG_SLIP_END;
+    in[sizeof(test_encoded) + 1] = 0x42;     /* first byte of next frame */
+
+    ng_slip_decoder_init(&dec, out, sizeof(out));
+    TEST_ASSERT(ng_slip_decode(&dec, in, &len));
+    TEST_ASSERT_EQUAL_INT(sizeof(test_encoded) + 1, len);
+    TEST_ASSERT_EQUAL_INT(sizeof(test_plain), dec.len);
+    TEST_ASSERT(!ng_slip_decoder_overflow(&dec));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(test_plain, out, sizeof(test_plain)));
+}
+
+/* the frame may be split anywhere, even within an escape sequence */
+static void test_slip_codec_decode_split(void)
+{
+    uint8_t out[sizeof(test_plain)];
+    ng_slip_decoder_t dec;
+
+    for (size_t split = 0; split <= sizeof(test_encoded); split++) {
+        size_t len = split;
+
+        ng_slip_decoder_init(&dec, out, sizeof(out));
+        TEST_ASSERT(!ng_slip_decode(&dec, test_encoded, &len));
+        TEST_ASSERT_EQUAL_INT(split, len);
+        len = sizeof(test_encoded) - split;
+        TEST_ASSERT(!ng_slip_decode(&dec, test_encoded + split, &len));
+        TEST_ASSERT_EQUAL_INT(sizeof(test_plain), dec.len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(test_plain, out, sizeof(test_plain)));
+    }
+}
+
+static void test_slip_codec_decode_overflow(void)
+{
+    uint8_t out[sizeof(test_plain)];
+    ng_slip_decoder_t dec;
+    size_t len = sizeof(test_encoded);
+
+    memset(out, 0, sizeof(out));
+    ng_slip_decoder_init(&dec, out, 2);
+    TEST_ASSERT(!ng_slip_decode(&dec, test_encoded, &len));
+    TEST_ASSERT_EQUAL_INT(sizeof(test_plain), dec.len);
+    TEST_ASSERT(ng_slip_decoder_overflow(&dec));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(test_plain, out, 2));
+    TEST_ASSERT_EQUAL_INT(0, out[2]);
+}
+
+static void test_slip_codec_decode_invalid_esc(void)
+{
+    const uint8_t in[] = { 0x01, NG_SLIP_ESC, 0x02, 0x03, NG_SLIP_END };
+    uint8_t out[sizeof(in)];
+    ng_slip_decoder_t dec;
+    size_t len = sizeof(in);
+
+    ng_slip_decoder_init(&dec, out, sizeof(out));
+    TEST_ASSERT(ng_slip_decode(&dec, in, &len));
+    TEST_ASSERT_EQUAL_INT(2, dec.len);
+    TEST_ASSERT_EQUAL_INT(0x01, out[0]);
+    TEST_ASSERT_EQUAL_INT(0x03, out[1]);
+}
+
+/* a stream of back-to-back frames through small blocks in both directions */
+static void test_slip_codec_stream(void)
+{
+    static uint8_t frames[TEST_FRAMES][TEST_FRAME_LEN];
+    static uint8_t stream[TEST_FRAMES * ((2 * TEST_FRAME_LEN) + 1)];
+    uint8_t out[TEST_FRAME_LEN];
+    ng_slip_decoder_t dec;
+    size_t stream_len = 0, pos = 0;
+    unsigned frame = 0;
+
+    for (unsigned i = 0; i < TEST_FRAMES; i++) {
+        for (unsigned j = 0; j < TEST_FRAME_LEN; j++) {
+            frames[i][j] = (uint8_t)((i * 37) + (j * 11));
+        }
+
+        for (size_t done = 0; done < TEST_FRAME_LEN;) {
+            size_t len = TEST_FRAME_LEN - done;
+
+            stream_len += ng_slip_encode(stream + stream_len, 7,
+                                         frames[i] + done, &len);
+            done += len;
+        }
+
+        stream[stream_len++] = NG_SLIP_END;
+    }
+
+    ng_slip_decoder_init(&dec, out, sizeof(out));
+
+    while (pos < stream_len) {
+        size_t len = ((stream_len - pos) < 13) ? (stream_len - pos) : 13;
+
+        if (ng_slip_decode(&dec, stream + pos, &len)) {
+            TEST_ASSERT_EQUAL_INT(TEST_FRAME_LEN, dec.len);
+            TEST_ASSERT_EQUAL_INT(0, memcmp(frames[frame], out,
+                                            TEST_FRAME_LEN));
+            frame++;
+            ng_slip_decoder_init(&dec, out, sizeof(out));
+        }
+
+        pos += len;
+    }
+
+    TEST_ASSERT_EQUAL_INT(TEST_FRAMES, frame);
+    TEST_ASSERT_EQUAL_INT(0, dec.len);
+}
+
+Test *tests_slip_codec_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_slip_codec_encode),
+        new_TestFixture(test_slip_codec_encode_short_out),
+        new_TestFixture(test_slip_codec_decode),
+        new_TestFixture(test_slip_codec_decode_split),
+        new_TestFixture(test_slip_codec_decode_overflow),
+        new_TestFixture(test_slip_codec_decode_invalid_esc),
+        new_TestFixture(test_slip_codec_stream),
+    };
+
+    EMB_UNIT_TESTCALLER(slip_codec_tests, NULL, NULL, fixtures);
+
+    return (Test *)&slip_codec_tests;
+}
+
+void tests_slip_codec(void)
+{
+    TESTS_RUN(tests_slip_codec_tests());
+}
+/** @} */
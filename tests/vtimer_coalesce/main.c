@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2015 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Counts vtimer wakeups of periodic timers set with slack
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "vtimer.h"
+#include "thread.h"
+#include "msg.h"
+#include "ps.h"
+
+#ifndef SLACK
+#define SLACK       (500000U)
+#endif
+
+/* scheduling latency allowed on top of the slack */
+#ifndef LATE_TOLERANCE
+#define LATE_TOLERANCE  (50000U)
+#endif
+
+#define TIMERS      (8U)
+#define ROUNDS      (10U)
+
+#define MSG_QUEUE_SIZE (8U)
+
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+
+static vtimer_t timers[TIMERS];
+static timex_t due[TIMERS];
+static unsigned rounds[TIMERS];
+
+/* timer i fires every (1 + i / 10) seconds */
+static timex_t interval(unsigned i)
+{
+    return timex_set(1, i * 100000U);
+}
+
+static void set(unsigned i)
+{
+    timex_t now;
+
+    vtimer_now(&now);
+    due[i] = timex_add(now, interval(i));
+    vtimer_set_msg_with_slack(&timers[i], interval(i), timex_set(0, SLACK),
+                              sched_active_pid, MSG_TIMER, (void *)(uintptr_t) i);
+}
+
+int main(void)
+{
+    vtimer_stats_t start, stop;
+    unsigned running = TIMERS, early = 0;
+    uint32_t max_late = 0;
+
+    puts("vtimer coalescing test application.");
+    printf("%u periodic timers, slack %u us\n", TIMERS, (unsigned) SLACK);
+
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+
+    vtimer_get_stats(&start);
+
+    for (unsigned i = 0; i < TIMERS; i++) {
+        set(i);
+    }
+
+    while (running) {
+        msg_t m;
+        timex_t now;
+        unsigned i;
+
+        msg_receive(&m);
+        vtimer_now(&now);
+        i = (unsigned) m.content.value;
+
+        if (timex_cmp(now, due[i]) < 0) {
+            early++;
+        }
+        else if (timex_uint64(timex_sub(now, due[i])) > max_late) {
+            max_late = (uint32_t) timex_uint64(timex_sub(now, due[i]));
+        }
+
+        if (++rounds[i] < ROUNDS) {
+            set(i);
+        }
+        else {
+            running--;
+        }
+    }
+
+    vtimer_get_stats(&stop);
+
+    printf("fired %" PRIu32 " timers in %" PRIu32 " wakeups, %u early, "
+           "max. %" PRIu32 " us late\n", stop.fired - start.fired,
+           stop.wakeups - start.wakeups, early, max_late);
+
+    ps();
+
+    if ((early == 0) && (max_late <= (SLACK + LATE_TOLERANCE))) {
+        puts("test successful.");
+    }
+    else {
+        puts("test failed.");
+    }
+
+    return 0;
+}
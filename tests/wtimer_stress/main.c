@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2015 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       wtimer stress test, arms and cancels many timers
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "wtimer.h"
+
+#ifndef TIMERS_NUMOF
+#define TIMERS_NUMOF    (1000U)
+#endif
+
+/* offsets of timers that are cancelled before they fire */
+#define CANCEL_MIN      (1000000U)
+#define CANCEL_RANGE    (10000000U)
+
+/* offsets of timers that fire */
+#define FIRE_MIN        (10000U)
+#define FIRE_RANGE      (100000U)
+
+static wtimer_t timers[TIMERS_NUMOF];
+
+static volatile unsigned fired = 0;
+static volatile unsigned wrong = 0;
+static volatile unsigned early = 0;
+static volatile uint32_t late_max = 0;
+
+static uint32_t seed = 1;
+
+static uint32_t _rand(uint32_t min, uint32_t range)
+{
+    seed = (seed * 1103515245U) + 12345U;
+
+    return min + ((seed >> 8) % range);
+}
+
+static void _callback(void *arg)
+{
+    unsigned i = (unsigned)((intptr_t)arg);
+    uint32_t late = wtimer_now() - timers[i].target;
+
+    if ((int32_t)late < 0) {
+        early++;
+    }
+    else if (late > late_max) {
+        late_max = late;
+    }
+
+    /* odd timers have been cancelled */
+    if (i & 1) {
+        wrong++;
+    }
+
+    fired++;
+}
+
+static void _arm(uint32_t min, uint32_t range)
+{
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        timers[i].callback = _callback;
+        timers[i].arg = (void *)((intptr_t)i);
+        wtimer_set(&timers[i], _rand(min, range));
+    }
+}
+
+static int arm_and_cancel(void)
+{
+    uint32_t start, armed, cancelled;
+    unsigned removed = 0;
+
+    start = wtimer_now();
+    _arm(CANCEL_MIN, CANCEL_RANGE);
+    armed = wtimer_now() - start;
+
+    /* cancel in a different order than armed */
+    start = wtimer_now();
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        removed += wtimer_remove(&timers[(i * 7) % TIMERS_NUMOF]);
+    }
+    cancelled = wtimer_now() - start;
+
+    printf("armed %u timers in %" PRIu32 " us\n", TIMERS_NUMOF, armed);
+    printf("cancelled %u timers in %" PRIu32 " us\n", removed, cancelled);
+
+    return (removed == TIMERS_NUMOF) && (fired == 0);
+}
+
+static int fire(void)
+{
+    _arm(FIRE_MIN, FIRE_RANGE);
+
+    for (unsigned i = 1; i < TIMERS_NUMOF; i += 2) {
+        wtimer_remove(&timers[i]);
+    }
+
+    wtimer_usleep(FIRE_MIN + FIRE_RANGE + 100000U);
+
+    printf("fired %u of %u timers, %u early, %u cancelled ones, "
+           "max. %" PRIu32 " us late\n", fired, (TIMERS_NUMOF + 1) / 2, early,
+           wrong, late_max);
+
+    return (fired == (TIMERS_NUMOF + 1) / 2) && (early == 0) && (wrong == 0);
+}
+
+int main(void)
+{
+    puts("wtimer stress test application.");
+
+    if (arm_and_cancel() && fire()) {
+        puts("test successful.");
+    }
+    else {
+        puts("test failed.");
+    }
+
+    return 0;
+}